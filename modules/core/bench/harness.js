@@ -0,0 +1,101 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// The pieces bench/index.js and the suites in bench/suites share.
+
+const Os   = require('os');
+const Path = require('path');
+
+const type = process.env.NODE_DEBUG ? 'Debug' : 'Release';
+
+// The core addon, built with its bench bindings (`yarn cpp:build:bench`), and the compiled TS
+// sources (`yarn tsc:build`)
+const core = () => {
+  const addon = require(Path.join(__dirname, '..', 'build', type, 'node_rapids_core.node'));
+  if (!addon.bench) {
+    throw new Error('node_rapids_core.node was built without NODE_RAPIDS_CORE_BENCH_BINDINGS=ON');
+  }
+  return addon;
+};
+const js   = (name) => require(Path.join(__dirname, '..', 'build', 'js', name));
+
+// A named group of benchmark cases. Cases that need a GPU only run with `--gpu`.
+class Suite {
+  constructor(name, {gpu = false} = {}) {
+    this.name  = name;
+    this.gpu   = gpu;
+    this.cases = [];
+  }
+
+  // `fn(i)` is one operation. `iterations` is the number of operations per sample, and `before`
+  // and `after` run around each case's warmup and samples.
+  add(name, fn, {gpu = this.gpu, iterations = 1e6, before, after} = {}) {
+    this.cases.push({name, fn, gpu, iterations, before, after});
+    return this;
+  }
+}
+
+// Each case gets its own copy of the loop, so the `fn(i)` call site only ever sees one function
+// and the cases can't slow each other down by making it megamorphic.
+// eslint-disable-next-line no-new-func
+const makeLoop = () => new Function('fn', 'n', 'for (let i = 0; i < n; ++i) { fn(i); }');
+
+const median = (xs) => xs.slice().sort((a, b) => a - b)[xs.length >> 1];
+
+// Time `samples` runs of `iterations` operations, after a warmup so the call sites are optimized.
+// Returns ns/op: the median sample, and the fastest and slowest.
+function measure({fn, iterations, before, after}, {samples = 5, scale = 1} = {}) {
+  const n    = Math.max(1, Math.round(iterations * scale));
+  const loop = makeLoop();
+  if (before) { before(); }
+  try {
+    loop(fn, Math.min(n, 1e5));
+    const times = [];
+    for (let s = 0; s < samples; ++s) {
+      const start = process.hrtime.bigint();
+      loop(fn, n);
+      times.push(Number(process.hrtime.bigint() - start) / n);
+    }
+    return {ns: median(times), min: Math.min(...times), max: Math.max(...times), iterations: n};
+  } finally {
+    if (after) { after(); }
+  }
+}
+
+// What produced a set of results, so baselines from different hosts aren't mistaken for each other
+function environment({gpu}) {
+  const [cpu] = Os.cpus();
+  return {
+    date: new Date().toISOString(),
+    node: process.version,
+    napi: process.versions.napi,
+    platform: `${process.platform}-${process.arch}`,
+    cpu: cpu ? cpu.model : 'unknown',
+    build: type,
+    gpu,
+  };
+}
+
+// Compare `results` to `baseline` (both `{[suite/case]: {ns}}`). A case regressed if it got more
+// than `threshold` (a fraction) slower.
+function compare(results, baseline, threshold) {
+  return Object.keys(results).map((key) => {
+    const {ns} = results[key];
+    const base = baseline && baseline[key] ? baseline[key].ns : undefined;
+    const delta = base === undefined ? undefined : (ns - base) / base;
+    return {key, ns, base, delta, regressed: delta !== undefined && delta > threshold};
+  });
+}
+
+module.exports = {Suite, core, js, measure, environment, compare};
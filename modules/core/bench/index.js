@@ -0,0 +1,133 @@
+#!/usr/bin/env node
+
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Runs the native binding layer's benchmark suites in bench/suites, prints ns/op for each case,
+// and compares them to a stored baseline. Exits with status 1 if any case regressed, so CI can run
+// it. Suites that need a GPU are skipped unless `--gpu` is passed, and every other suite runs on
+// hosts without one. A suite that fails to load also fails the run, unless `--allow-missing`
+// is passed.
+//
+// Usage: node bench/index.js [options]
+//   --gpu                 also run the suites and cases that need a GPU
+//   --filter <regex>      only run cases whose "suite/case" name matches
+//   --samples <n>         timed samples per case (default 5); the median is reported
+//   --scale <x>           multiply every case's iterations per sample (default 1)
+//   --json <file>         write the results as JSON
+//   --baseline <file>     compare against this JSON (default bench/baseline.json, if it exists)
+//   --threshold <x>       fail if a case is more than x slower than its baseline (default 0.15)
+//   --save-baseline       write the results to the baseline file instead of comparing
+//   --allow-missing       skip suites that fail to load instead of failing the run
+
+const Fs   = require('fs');
+const Path = require('path');
+
+const {measure, environment, compare} = require('./harness');
+
+const suites = [
+  {name: 'calls'},
+  {name: 'napi-to-cpp'},
+  {name: 'cpp-to-napi'},
+  {name: 'object-wrap'},
+  {name: 'commands'},
+  {name: 'cuda', gpu: true},
+  {name: 'webgl', gpu: true},
+];
+
+function parseArgs(argv) {
+  const options = {
+    gpu: false,
+    filter: undefined,
+    samples: 5,
+    scale: 1,
+    json: undefined,
+    baseline: Path.join(__dirname, 'baseline.json'),
+    threshold: 0.15,
+    saveBaseline: false,
+    allowMissing: false,
+  };
+  for (let i = 0; i < argv.length; ++i) {
+    const value = () => {
+      if (i + 1 >= argv.length) { throw new Error(`${argv[i]} requires a value`); }
+      return argv[++i];
+    };
+    switch (argv[i]) {
+      case '--gpu': options.gpu = true; break;
+      case '--filter': options.filter = new RegExp(value()); break;
+      case '--samples': options.samples = Math.max(1, Number(value()) | 0); break;
+      case '--scale': options.scale = Number(value()); break;
+      case '--json': options.json = Path.resolve(value()); break;
+      case '--baseline': options.baseline = Path.resolve(value()); break;
+      case '--threshold': options.threshold = Number(value()); break;
+      case '--save-baseline': options.saveBaseline = true; break;
+      case '--allow-missing': options.allowMissing = true; break;
+      default: throw new Error(`Unknown option ${argv[i]}`);
+    }
+  }
+  return options;
+}
+
+function run(options) {
+  const results = {};
+  for (const {name, gpu} of suites) {
+    if (gpu && !options.gpu) { continue; }
+    let suite;
+    try {
+      suite = require(Path.join(__dirname, 'suites', name));
+    } catch (e) {
+      console.log(`${name}: failed to load, skipping (${e.message.split('\n')[0]})`);
+      if (!options.allowMissing) { process.exitCode = 1; }
+      continue;
+    }
+    for (const c of suite.cases) {
+      const key = `${suite.name}/${c.name}`;
+      if ((c.gpu && !options.gpu) || (options.filter && !options.filter.test(key))) { continue; }
+      results[key] = measure(c, options);
+      console.log(`${key.padEnd(56)} ${results[key].ns.toFixed(2).padStart(10)} ns/op`);
+    }
+  }
+  return results;
+}
+
+function report(rows, threshold) {
+  const pct = (x) => `${x >= 0 ? '+' : ''}${(x * 100).toFixed(1)}%`;
+  console.log(`\n${'case'.padEnd(56)} ${'ns/op'.padStart(10)} ${'baseline'.padStart(10)} ` +
+              `${'delta'.padStart(8)}`);
+  for (const {key, ns, base, delta, regressed} of rows) {
+    console.log(`${key.padEnd(56)} ${ns.toFixed(2).padStart(10)} ` +
+                `${base === undefined ? '-'.padStart(10) : base.toFixed(2).padStart(10)} ` +
+                `${delta === undefined ? '-'.padStart(8) : pct(delta).padStart(8)}` +
+                `${regressed ? '  REGRESSED' : ''}`);
+  }
+  const regressions = rows.filter((row) => row.regressed);
+  if (regressions.length > 0) {
+    console.log(`\n${regressions.length} case(s) more than ${pct(threshold)} slower than baseline`);
+  }
+  return regressions.length;
+}
+
+const options = parseArgs(process.argv.slice(2));
+const output  = {environment: environment(options), results: run(options)};
+
+if (options.json) { Fs.writeFileSync(options.json, JSON.stringify(output, null, 2)); }
+
+if (options.saveBaseline) {
+  Fs.writeFileSync(options.baseline, JSON.stringify(output, null, 2));
+  console.log(`\nSaved baseline to ${options.baseline}`);
+} else if (Fs.existsSync(options.baseline)) {
+  const baseline = JSON.parse(Fs.readFileSync(options.baseline, 'utf8'));
+  const rows     = compare(output.results, baseline.results, options.threshold);
+  if (report(rows, options.threshold) > 0) { process.exitCode = 1; }
+}
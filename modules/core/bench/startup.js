@@ -0,0 +1,119 @@
+#!/usr/bin/env node
+
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Measures the cost of `require()`ing each module in a fresh process. Reports the median wall
+// time over several runs and the per-addon load and init() times from getNativeModuleTimings().
+// It then profiles one more run with `--cpu-prof` and lists the functions and files that took
+// the most self time. Native module loading shows up under `Module._extensions..node`.
+// Exits with status 1 if a module fails to load, unless `--allow-missing` is passed.
+//
+// Usage: node bench/startup.js [--allow-missing] [runs] [module ...]
+
+const Fs   = require('fs');
+const Os   = require('os');
+const Path = require('path');
+const {execFileSync} = require('child_process');
+
+const args         = process.argv.slice(2).filter((arg) => arg !== '--allow-missing');
+const allowMissing = args.length < process.argv.length - 2;
+const runs         = Number(args[0]) > 0 ? Number(args.shift()) : 5;
+const modules      = args.length > 0 ? args : [
+  '@nvidia/rapids-core',
+  '@nvidia/cuda',
+  '@nvidia/rmm',
+  '@nvidia/cudf',
+  '@nvidia/webgl',
+];
+
+const script = (id) => `
+const start = process.hrtime.bigint();
+require(${JSON.stringify(id)});
+const ms = Number(process.hrtime.bigint() - start) / 1e6;
+let timings = [];
+try { timings = require('@nvidia/rapids-core').getNativeModuleTimings(); } catch (e) {}
+console.log(JSON.stringify({ms, timings}));
+`;
+
+function run(id, nodeArgs = []) {
+  const out = execFileSync(process.execPath, [...nodeArgs, '-e', script(id)], {
+    cwd: Path.join(__dirname, '..'),
+    encoding: 'utf8',
+    stdio: ['ignore', 'pipe', 'inherit'],
+  });
+  return JSON.parse(out.trim().split('\n').pop());
+}
+
+const median = (xs) => xs.slice().sort((a, b) => a - b)[xs.length >> 1];
+
+// Self time per profile node, from the sample list and the time deltas between samples
+function selfTimes({nodes, samples, timeDeltas}) {
+  const self = new Map(nodes.map((node) => [node.id, 0]));
+  samples.forEach((id, i) => self.set(id, self.get(id) + (timeDeltas[i + 1] || 0) / 1e3));
+  return self;
+}
+
+function summarize(profile) {
+  const self   = selfTimes(profile);
+  const byId   = new Map(profile.nodes.map((node) => [node.id, node]));
+  const byName = new Map();
+  const byFile = new Map();
+  const add    = (map, key, ms) => map.set(key, (map.get(key) || 0) + ms);
+  for (const [id, ms] of self) {
+    const {functionName, url, lineNumber} = byId.get(id).callFrame;
+    add(byName, `${functionName || '(anonymous)'} ${url ? `${url}:${lineNumber + 1}` : ''}`, ms);
+    add(byFile, url || functionName || '(native)', ms);
+  }
+  // Inclusive time under every `.node` loader frame
+  const inclusive = (node) =>
+    self.get(node.id) + (node.children || []).reduce((t, id) => t + inclusive(byId.get(id)), 0);
+  const native =
+    profile.nodes.filter((node) => node.callFrame.functionName === 'Module._extensions..node')
+      .reduce((t, node) => t + inclusive(node), 0);
+  const top = (map) => [...map].sort((a, b) => b[1] - a[1]).slice(0, 10);
+  return {native, functions: top(byName), files: top(byFile)};
+}
+
+const profileDir = Fs.mkdtempSync(Path.join(Os.tmpdir(), 'nv-startup-'));
+
+for (const id of modules) {
+  let result;
+  try {
+    result = Array.from({length: runs}, () => run(id));
+  } catch (e) {
+    console.log(`${id}: failed to load, skipping\n`);
+    if (!allowMissing) { process.exitCode = 1; }
+    continue;
+  }
+  const ms = (xs) => `${median(xs).toFixed(1).padStart(7)} ms`;
+  console.log(`${id}: require() median ${ms(result.map((r) => r.ms))} over ${runs} runs`);
+  for (const {name} of result[0].timings) {
+    const times = result.map((r) => r.timings.find((t) => t.name === name));
+    console.log(`  ${name.padEnd(24)} load ${ms(times.map((t) => t.require))}` +
+                `  init() ${ms(times.map((t) => t.init))}`);
+  }
+
+  const dir = Fs.mkdtempSync(Path.join(profileDir, 'run-'));
+  run(id, ['--cpu-prof', `--cpu-prof-dir=${dir}`, '--cpu-prof-interval=100']);
+  const [file] = Fs.readdirSync(dir).filter((name) => name.endsWith('.cpuprofile'));
+  const {native, functions, files} = summarize(JSON.parse(Fs.readFileSync(Path.join(dir, file))));
+  console.log(`  --cpu-prof: ${native.toFixed(1)} ms loading native modules`);
+  console.log(`  profile: ${Path.join(dir, file)}`);
+  console.log('  top self time by function:');
+  functions.forEach(([name, ms]) => console.log(`    ${ms.toFixed(1).padStart(8)} ms  ${name}`));
+  console.log('  top self time by file:');
+  files.forEach(([name, ms]) => console.log(`    ${ms.toFixed(1).padStart(8)} ms  ${name}`));
+  console.log('');
+}
@@ -0,0 +1,34 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ns/call for trivial bindings dispatched through `Napi::CallbackInfo`, `CallbackArgs`, and a raw
+// `napi_callback` wrapping its arguments in a `CallbackArgs`. The Info and Args variants go
+// through EXPORT_FUNC's tracing wrapper, so they're also measured with tracing enabled. The Raw
+// variants bypass it.
+
+const {Suite, core} = require('../harness');
+
+const {bench, _trace} = core();
+
+const traced = {before: () => _trace.setEnabled(true), after: () => _trace.setEnabled(false)};
+
+module.exports = new Suite('calls')
+                   .add('noopInfo', () => bench.noopInfo())
+                   .add('noopArgs', () => bench.noopArgs())
+                   .add('noopRaw', () => bench.noopRaw())
+                   .add('addInfo', (i) => bench.addInfo(i, 1))
+                   .add('addArgs', (i) => bench.addArgs(i, 1))
+                   .add('addRaw', (i) => bench.addRaw(i, 1))
+                   .add('noopInfo+trace', () => bench.noopInfo(), traced)
+                   .add('noopArgs+trace', () => bench.noopArgs(), traced);
@@ -0,0 +1,45 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ns/op for trivial operations made as one N-API call each, and as commands batched through a
+// CommandEncoder and run in one `execute()` call per 1024 ops. Separately measures the cost of
+// encoding alone. Needs the TS sources built (`yarn tsc:build`).
+
+const {Suite, core, js} = require('../harness');
+
+const {bench}          = core();
+const {CommandEncoder} = js('commands');
+
+const batchSize           = 1024;
+const encoder             = new CommandEncoder(bench.commands, batchSize * 3, batchSize);
+const {noop, add, handle} = encoder.ops;
+const id                  = encoder.handle({});
+
+// Submit once every `batchSize` ops, and whatever's left at the end
+const batched = (encode) => (i) => {
+  encode(i);
+  if ((i + 1) % batchSize === 0) { encoder.submit(); }
+};
+const flush = {before: () => encoder.reset(), after: () => encoder.submit()};
+
+module.exports = new Suite('commands')
+                   .add('noop call', () => bench.noopArgs())
+                   .add('noop batched', batched(() => encoder.push(noop)), flush)
+                   .add('add call', (i) => bench.addArgs(i, 1))
+                   .add('add batched', batched((i) => encoder.push(add, i, 1)), flush)
+                   .add('handle batched', batched(() => encoder.push(handle, id)), flush)
+                   .add('add encode only', (i) => {
+                     encoder.push(add, i, 1);
+                     if ((i + 1) % batchSize === 0) { encoder.reset(); }
+                   }, flush);
@@ -0,0 +1,33 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ns/call for `CPPToNapi` conversions: numbers, strings, `std::vector`s copied into Arrays, and
+// `ExternalArray`s handed to JS as TypedArrays without a copy. Includes making the C++ value.
+
+const {Suite, core} = require('../harness');
+
+const {bench} = core();
+
+const suite = new Suite('cpp-to-napi').add('double', (i) => bench.addArgs(i, 1));
+
+for (const size of [8, 1024]) {
+  const iterations = size > 8 ? 2e5 : 1e6;
+  suite.add(`string[${size}]`, () => bench.stringOut(size), {iterations})
+    .add(`vector<double>[${size}] -> Array`, () => bench.vectorOut(size), {iterations})
+    .add(`ExternalArray<double>[${size}] -> Float64Array`,
+         () => bench.externalArrayOut(size),
+         {iterations});
+}
+
+module.exports = suite;
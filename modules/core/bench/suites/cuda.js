@@ -0,0 +1,28 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ns/op for the bindings with a device behind them: wrapping device and pinned allocations, and
+// passing device memory where a span is expected. Only runs with `--gpu`, and needs @nvidia/cuda.
+
+const {Suite, core} = require('../harness');
+
+const {bench}                      = core();
+const {DeviceMemory, PinnedMemory} = require('@nvidia/cuda');
+
+const device = new DeviceMemory(64);
+
+module.exports = new Suite('cuda', {gpu: true})
+                   .add('new DeviceMemory(64)', () => new DeviceMemory(64), {iterations: 1e4})
+                   .add('new PinnedMemory(64)', () => new PinnedMemory(64), {iterations: 1e4})
+                   .add('span <- DeviceMemory', () => bench.spanSize(device));
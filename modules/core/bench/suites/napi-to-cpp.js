@@ -0,0 +1,54 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ns/call for `NapiToCPP` conversions of numbers, strings, vectors, and spans. Spans are taken
+// from TypedArrays and memory-like Objects, with the cached property keys (`spanSize`) and with
+// per-call C-string keys (`spanSizeUncached`).
+
+const {Suite, core} = require('../harness');
+
+const {bench} = core();
+
+const long = 'a'.repeat(1024);
+
+const suite = new Suite('napi-to-cpp')
+                .add('double', (i) => bench.addArgs(i, 1))
+                .add('int64', (i) => bench.int64In(i))
+                .add('bigint', () => bench.int64In(42n))
+                .add('string[8]', () => bench.stringIn('abcdefgh'))
+                .add('string[1024]', () => bench.stringIn(long), {iterations: 2e5});
+
+const arrays = {
+  'Array[16]': Array.from({length: 16}, (_, i) => i),
+  'Float64Array[16]': new Float64Array(16),
+  'Array[1024]': Array.from({length: 1024}, (_, i) => i),
+  'Float64Array[1024]': new Float64Array(1024),
+};
+
+for (const [name, arg] of Object.entries(arrays)) {
+  suite.add(`vector<double> <- ${name}`, () => bench.vectorIn(arg), {iterations: 2e5});
+}
+
+const spans = {
+  'Float32Array': new Float32Array(16),
+  '{ptr, byteLength}': {ptr: 4096, byteLength: 64},
+  '{buffer, byteOffset, byteLength}': {buffer: {ptr: 4096}, byteOffset: 16, byteLength: 48},
+};
+
+for (const [name, arg] of Object.entries(spans)) {
+  suite.add(`span <- ${name}`, () => bench.spanSize(arg));
+  suite.add(`span <- ${name} uncached`, () => bench.spanSizeUncached(arg));
+}
+
+module.exports = suite;
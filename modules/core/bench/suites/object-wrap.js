@@ -0,0 +1,27 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ns/op for constructing a trivial `Napi::ObjectWrap` from JS with `new`, from C++ through its
+// `ConstructorReference`, and for calling an accessor on one. Allocates, so it also pays for GC.
+
+const {Suite, core} = require('../harness');
+
+const {bench: {Wrapped}} = core();
+
+const wrapped = new Wrapped(1);
+
+module.exports = new Suite('object-wrap')
+                   .add('new Wrapped()', (i) => new Wrapped(i), {iterations: 5e5})
+                   .add('Wrapped.create()', (i) => Wrapped.create(i), {iterations: 5e5})
+                   .add('wrapped.value', () => wrapped.value);
@@ -0,0 +1,40 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// ns/op for churning GL objects, with and without recycling their wrappers. The delete cases leave
+// a wrapper of garbage per op, so they include the time spent collecting it. Only runs with `--gpu`
+// (a headless EGL context, which Mesa's llvmpipe also provides), and needs @nvidia/webgl.
+
+const {Suite} = require('../harness');
+
+const {HeadlessContext, WebGL2RenderingContext} = require('@nvidia/webgl');
+
+// Kept current for the life of the process
+const context = new HeadlessContext({width: 1, height: 1});
+const gl      = new WebGL2RenderingContext();
+
+module.exports =
+  new Suite('webgl', {gpu: true})
+    .add('createBuffer + deleteBuffer', () => gl.deleteBuffer(gl.createBuffer()), {iterations: 1e5})
+    .add('createBuffer + recycleBuffer',
+         () => gl.recycleBuffer(gl.createBuffer()),
+         {iterations: 1e5})
+    .add('createQuery + deleteQuery', () => gl.deleteQuery(gl.createQuery()), {iterations: 1e5})
+    .add('createQuery + recycleQuery', () => gl.recycleQuery(gl.createQuery()), {iterations: 1e5})
+    .add('fenceSync + deleteSync',
+         () => gl.deleteSync(gl.fenceSync(gl.SYNC_GPU_COMMANDS_COMPLETE, 0)),
+         {iterations: 1e4})
+    .add('fenceSync + recycleSync',
+         () => gl.recycleSync(gl.fenceSync(gl.SYNC_GPU_COMMANDS_COMPLETE, 0)),
+         {iterations: 1e4});
@@ -12,15 +12,366 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <nv_node/async/scheduler.hpp>
+#include <nv_node/async/task.hpp>
+#include <nv_node/macros.hpp>
 #include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/cpp_to_napi.hpp>
+#include <nv_node/utilities/command_buffer.hpp>
 #include <nv_node/utilities/napi_to_cpp.hpp>
 
 #include <napi.h>
 
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
 std::ostream& operator<<(std::ostream& os, const nv::NapiToCPP& self) {
   return os << self.operator std::string();
 };
 
-Napi::Object initModule(Napi::Env env, Napi::Object exports) { return exports; }
+namespace nv {
+
+// The `bench` and `testing` bindings are only built with -DNODE_RAPIDS_CORE_BENCH_BINDINGS=ON
+#ifdef NODE_RAPIDS_CORE_BENCH_BINDINGS
+namespace bench {
+
+// Trivial bindings for measuring the cost of a JS -> C++ call under each dispatch style.
+// See `modules/core/bench`.
+
+Napi::Value noop_info(Napi::CallbackInfo const& info) { return info.Env().Undefined(); }
+
+Napi::Value noop_args(CallbackArgs const& args) { return args.Env().Undefined(); }
+
+napi_value noop_raw(napi_env env, napi_callback_info info) {
+  CallbackArgs args{env, info};
+  return args.Env().Undefined();
+}
+
+Napi::Value add_info(Napi::CallbackInfo const& info) {
+  double lhs = info[0].ToNumber();
+  double rhs = info[1].ToNumber();
+  return Napi::Number::New(info.Env(), lhs + rhs);
+}
+
+Napi::Value add_args(CallbackArgs const& args) {
+  double lhs = args[0];
+  double rhs = args[1];
+  return Napi::Number::New(args.Env(), lhs + rhs);
+}
+
+napi_value add_raw(napi_env env, napi_callback_info info) {
+  CallbackArgs args{env, info};
+  double lhs = args[0];
+  double rhs = args[1];
+  return Napi::Number::New(env, lhs + rhs);
+}
+
+Napi::Value span_size(CallbackArgs const& args) {
+  Span<char> span = args[0];
+  return Napi::Number::New(args.Env(), span.size());
+}
+
+// The C-string key lookups NapiToCPP::as_span used before PropertyKeys, kept for comparison.
+Napi::Value span_size_uncached(CallbackArgs const& args) {
+  if (args[0].IsTypedArray()) { return span_size(args); }
+  size_t length{0};
+  size_t offset{0};
+  uintptr_t ptr{0};
+  auto obj = args[0].As<Napi::Object>();
+  if (obj.Has("byteOffset") and obj.Get("byteOffset").IsNumber()) {
+    offset = NapiToCPP(obj.Get("byteOffset"));
+  }
+  if (obj.Has("byteLength") and obj.Get("byteLength").IsNumber()) {
+    length = NapiToCPP(obj.Get("byteLength"));
+  }
+  if (obj.Has("buffer") and obj.Get("buffer").IsObject()) {
+    obj = obj.Get("buffer").As<Napi::Object>();
+  }
+  if (obj.Has("ptr") and obj.Get("ptr").IsNumber()) { ptr = NapiToCPP(obj.Get("ptr")); }
+  Span<char> span(reinterpret_cast<char*>(ptr) + offset, length);
+  return Napi::Number::New(args.Env(), span.size());
+}
+
+// Conversions from JS values, each returning something cheap so the conversion dominates.
+
+Napi::Value int64_in(CallbackArgs const& args) {
+  int64_t value = args[0];
+  return Napi::Number::New(args.Env(), value);
+}
+
+Napi::Value string_in(CallbackArgs const& args) {
+  std::string value = args[0];
+  return Napi::Number::New(args.Env(), value.size());
+}
+
+Napi::Value vector_in(CallbackArgs const& args) {
+  std::vector<double> value = args[0];
+  return Napi::Number::New(args.Env(), value.size());
+}
+
+// Conversions to JS values, each of `args[0]` elements.
+
+Napi::Value string_out(CallbackArgs const& args) {
+  size_t size = args[0];
+  return CPPToNapi(args)(std::string(size, 'a'));
+}
+
+Napi::Value vector_out(CallbackArgs const& args) {
+  size_t size = args[0];
+  return CPPToNapi(args)(std::vector<double>(size, 1));
+}
+
+Napi::Value external_array_out(CallbackArgs const& args) {
+  size_t size = args[0];
+  return CPPToNapi(args)(ExternalArray<double>(std::vector<double>(size, 1)));
+}
+
+// The smallest useful ObjectWrap, for measuring construction from JS (`new Wrapped(x)`) and from
+// C++ through its ConstructorReference (`Wrapped.create(x)`).
+class Wrapped : public Napi::ObjectWrap<Wrapped> {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports) {
+    auto ctor = DefineClass(env,
+                            "Wrapped",
+                            {
+                              StaticMethod("create", &Wrapped::create),
+                              InstanceAccessor("value", &Wrapped::value, nullptr),
+                            });
+    Wrapped::constructor = Napi::Persistent(ctor);
+    exports.Set("Wrapped", ctor);
+    return exports;
+  }
+
+  Wrapped(Napi::CallbackInfo const& info) : Napi::ObjectWrap<Wrapped>(info) {
+    value_ = info[0].ToNumber();
+  }
+
+ private:
+  static ConstructorReference constructor;
+
+  static Napi::Value create(Napi::CallbackInfo const& info) {
+    return Wrapped::constructor.New({info[0]});
+  }
+
+  Napi::Value value(Napi::CallbackInfo const& info) {
+    return Napi::Number::New(info.Env(), value_);
+  }
+
+  double value_{0};
+};
+
+ConstructorReference Wrapped::constructor;
+
+// Trivial command handlers for measuring the cost of encoding, decoding and dispatching a batch.
+CommandTable commands{
+  {"noop", [](Command&) {}},
+  {"add", [](Command& command) { command.Return(command[0] + command[1]); }},
+  {"handle", [](Command& command) { command.Return(command.Object(0).IsObject()); }},
+};
+
+Napi::Object initModule(Napi::Env env, Napi::Object exports) {
+  auto define_raw = [&](const char* name, napi_callback cb) {
+    napi_value fn;
+    NAPI_THROW_IF_FAILED_VOID(env,
+                              napi_create_function(env, name, NAPI_AUTO_LENGTH, cb, nullptr, &fn));
+    EXPORT_PROP(exports, name, Napi::Value(env, fn));
+  };
+
+  EXPORT_FUNC(env, exports, "noopInfo", noop_info);
+  EXPORT_FUNC(env, exports, "noopArgs", noop_args);
+  define_raw("noopRaw", noop_raw);
+
+  EXPORT_FUNC(env, exports, "addInfo", add_info);
+  EXPORT_FUNC(env, exports, "addArgs", add_args);
+  define_raw("addRaw", add_raw);
+
+  EXPORT_FUNC(env, exports, "spanSize", span_size);
+  EXPORT_FUNC(env, exports, "spanSizeUncached", span_size_uncached);
+
+  EXPORT_FUNC(env, exports, "int64In", int64_in);
+  EXPORT_FUNC(env, exports, "stringIn", string_in);
+  EXPORT_FUNC(env, exports, "vectorIn", vector_in);
+  EXPORT_FUNC(env, exports, "stringOut", string_out);
+  EXPORT_FUNC(env, exports, "vectorOut", vector_out);
+  EXPORT_FUNC(env, exports, "externalArrayOut", external_array_out);
+
+  Wrapped::Init(env, exports);
+
+  commands.Export(env, exports, "commands");
+
+  return exports;
+}
+
+}  // namespace bench
+#endif
+
+namespace scheduler {
+
+struct {
+  char const* name;
+  Pool pool;
+} const pools[] = {{"io", Pool::io}, {"cpu", Pool::cpu}, {"gpu", Pool::gpu}};
+
+Pool pool_arg(Napi::Value const& value) {
+  auto name = value.IsString() ? value.ToString().Utf8Value() : std::string{"cpu"};
+  for (auto const& p : pools) {
+    if (name == p.name) { return p.pool; }
+  }
+  NAPI_THROW(Napi::Error::New(value.Env(), "Unknown scheduler pool \"" + name + "\""), Pool::cpu);
+}
+
+Priority priority_arg(Napi::Value const& value) {
+  auto name = value.IsString() ? value.ToString().Utf8Value() : std::string{"normal"};
+  if (name == "high") { return Priority::high; }
+  if (name == "low") { return Priority::low; }
+  if (name == "normal") { return Priority::normal; }
+  NAPI_THROW(Napi::Error::New(value.Env(), "Unknown scheduler priority \"" + name + "\""),
+             Priority::normal);
+}
+
+// configure({io?: number, cpu?: number, gpu?: number}): returns whether each pool was resized.
+// Pools can only be resized before they run their first job.
+Napi::Value configure(CallbackArgs const& args) {
+  auto env     = args.Env();
+  auto sizes   = args[0].IsObject() ? args[0].As<Napi::Object>() : Napi::Object::New(env);
+  auto results = Napi::Object::New(env);
+  for (auto const& p : pools) {
+    if (sizes.Get(p.name).IsNumber()) {
+      uint32_t threads = sizes.Get(p.name).ToNumber();
+      results.Set(p.name, Scheduler::get().configure(p.pool, threads));
+    }
+  }
+  return results;
+}
+
+Napi::Value get_stats(CallbackArgs const& args) {
+  auto env    = args.Env();
+  auto result = Napi::Object::New(env);
+  for (auto const& p : pools) {
+    auto stats = Scheduler::get().stats(p.pool);
+    auto pool  = Napi::Object::New(env);
+    pool.Set("threads", static_cast<double>(stats.threads));
+    pool.Set("queued", static_cast<double>(stats.queued));
+    pool.Set("running", static_cast<double>(stats.running));
+    pool.Set("submitted", static_cast<double>(stats.submitted));
+    pool.Set("completed", static_cast<double>(stats.completed));
+    pool.Set("stolen", static_cast<double>(stats.stolen));
+    pool.Set("waitNs", static_cast<double>(stats.wait_ns));
+    pool.Set("maxWaitNs", static_cast<double>(stats.max_wait_ns));
+    pool.Set("runNs", static_cast<double>(stats.run_ns));
+    result.Set(p.name, pool);
+  }
+  return result;
+}
+
+// The process's one Scheduler, handed to every other addon by loadNativeModule. Never destroyed,
+// so addons still using it can't outlive it; its threads are stopped with the last env instead,
+// and started again if another env (e.g. a new worker thread) loads the addon after that.
+Scheduler* const shared = Scheduler::Create();
+std::mutex envs_mutex;
+uint32_t envs{0};
+
+Napi::Object initModule(Napi::Env env, Napi::Object exports) {
+  Scheduler::Attach(shared);
+  {
+    std::lock_guard<std::mutex> lock(envs_mutex);
+    if (envs++ == 0) { shared->Start(); }
+  }
+  napi_add_env_cleanup_hook(
+    env,
+    [](void*) {
+      std::lock_guard<std::mutex> lock(envs_mutex);
+      if (--envs == 0) { shared->Stop(); }
+    },
+    nullptr);
+  EXPORT_PROP(exports, "instance", Napi::External<Scheduler>::New(env, shared));
+  EXPORT_FUNC(env, exports, "configure", configure);
+  EXPORT_FUNC(env, exports, "getStats", get_stats);
+  return exports;
+}
+
+}  // namespace scheduler
+
+#ifdef NODE_RAPIDS_CORE_BENCH_BINDINGS
+namespace testing {
+
+// Resolve after `ms` milliseconds, from a separate thread that checks for cancellation every
+// millisecond. Exercises Task cancellation and timeouts without a GPU.
+Napi::Value sleep(CallbackArgs const& args) {
+  int64_t ms = args[0];
+  auto task  = new Task(args.Env());
+  task->Observe(args[1]);
+  std::thread([handle = task->GetHandle(), ms]() {
+    auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < end) {
+      if (handle.Cancelled()) { return; }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    handle.Resolve();
+  }).detach();
+  return task->Promise();
+}
+
+// Spin for `ms` milliseconds on a Scheduler thread, checking for cancellation as it goes, then
+// resolve with the order the job started in. Rejects if `ms` is negative.
+Napi::Value spin(CallbackArgs const& args) {
+  static std::atomic<uint32_t> started{0};
+  auto pool     = scheduler::pool_arg(args[0]);
+  auto priority = scheduler::priority_arg(args[1]);
+  int64_t ms    = args[2];
+  return Schedule(args.Env(), pool, priority, args[3], [ms](CancellationToken& token) {
+    if (ms < 0) { throw std::invalid_argument("ms must not be negative"); }
+    auto order = started++;
+    auto end   = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+    while (std::chrono::steady_clock::now() < end && !token.cancelled()) {}
+    return [order](Napi::Env env) -> Napi::Value { return Napi::Number::New(env, order); };
+  });
+}
+
+// Throw from a Scheduler job: an exception with an empty message when `kind` is "empty", or a
+// value that isn't a std::exception otherwise. Either way the Promise should reject.
+Napi::Value fail(CallbackArgs const& args) {
+  std::string kind = args[0];
+  return Schedule(args.Env(),
+                  Pool::cpu,
+                  Priority::normal,
+                  args.Env().Undefined(),
+                  [kind](CancellationToken&) -> std::function<Napi::Value(Napi::Env)> {
+                    if (kind == "empty") { throw std::runtime_error(""); }
+                    throw 42;
+                  });
+}
+
+Napi::Object initModule(Napi::Env env, Napi::Object exports) {
+  EXPORT_FUNC(env, exports, "sleep", sleep);
+  EXPORT_FUNC(env, exports, "spin", spin);
+  EXPORT_FUNC(env, exports, "fail", fail);
+  return exports;
+}
+
+}  // namespace testing
+#endif
+}  // namespace nv
+
+Napi::Object initModule(Napi::Env env, Napi::Object exports) {
+#ifdef NODE_RAPIDS_CORE_BENCH_BINDINGS
+  auto bench = Napi::Object::New(env);
+  EXPORT_PROP(exports, "bench", bench);
+  nv::bench::initModule(env, bench);
+  auto testing = Napi::Object::New(env);
+  EXPORT_PROP(exports, "testing", testing);
+  nv::testing::initModule(env, testing);
+#endif
+  auto scheduler = Napi::Object::New(env);
+  EXPORT_PROP(exports, "scheduler", scheduler);
+  nv::scheduler::initModule(env, scheduler);
+  nv::trace::Init(env, exports);
+  return exports;
+}
 
 NODE_API_MODULE(node_rapids_core, initModule);
@@ -0,0 +1,93 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <mutex>
+
+namespace nv {
+
+enum class CancelReason : int { none = 0, aborted = 1, timed_out = 2 };
+
+// Cooperative cancellation for long-running native work. Work checks `cancelled()` between steps
+// and stops early once it's true. A token moves from `none` to `aborted` or `timed_out` exactly
+// once, either by an explicit `cancel()`, or the first time it's checked after its deadline.
+//
+// Safe to share between threads.
+class CancellationToken {
+ public:
+  using clock = std::chrono::steady_clock;
+
+  inline CancelReason reason() {
+    auto reason = static_cast<CancelReason>(reason_.load(std::memory_order_acquire));
+    if (reason == CancelReason::none) {
+      auto deadline = deadline_.load(std::memory_order_relaxed);
+      if (deadline != 0 && clock::now().time_since_epoch().count() >= deadline) {
+        cancel(CancelReason::timed_out);
+        reason = static_cast<CancelReason>(reason_.load(std::memory_order_acquire));
+      }
+    }
+    return reason;
+  }
+
+  inline bool cancelled() { return reason() != CancelReason::none; }
+
+  // Returns true if this call cancelled the token, or false if it was already cancelled.
+  inline bool cancel(CancelReason reason = CancelReason::aborted) {
+    if (reason == CancelReason::none) { return false; }
+    int expected{static_cast<int>(CancelReason::none)};
+    if (!reason_.compare_exchange_strong(
+          expected, static_cast<int>(reason), std::memory_order_acq_rel)) {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    notify(reason);
+    return true;
+  }
+
+  // Time out `timeout` from now. Only the earliest deadline set takes effect.
+  inline void set_timeout(std::chrono::milliseconds timeout) {
+    auto deadline = (clock::now() + timeout).time_since_epoch().count();
+    auto current  = deadline_.load(std::memory_order_relaxed);
+    while ((current == 0 || deadline < current) &&
+           !deadline_.compare_exchange_weak(current, deadline, std::memory_order_relaxed)) {}
+  }
+
+  // Set the function called (once, on the cancelling thread) when the token is cancelled. If the
+  // token is already cancelled, it's called immediately. Pass nullptr to remove it.
+  inline void on_cancel(std::function<void(CancelReason)> listener) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    listener_ = std::move(listener);
+    notify(static_cast<CancelReason>(reason_.load(std::memory_order_acquire)));
+  }
+
+ private:
+  inline void notify(CancelReason reason) {
+    if (reason != CancelReason::none && listener_) {
+      auto listener = std::move(listener_);
+      listener_     = nullptr;
+      listener(reason);
+    }
+  }
+
+  std::atomic<int> reason_{static_cast<int>(CancelReason::none)};
+  std::atomic<clock::rep> deadline_{0};
+  std::mutex mutex_;
+  std::function<void(CancelReason)> listener_;
+};
+
+}  // namespace nv
@@ -0,0 +1,133 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <nv_node/utilities/env_local.hpp>
+
+#include <napi.h>
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace nv {
+
+// The queue native threads use to run callbacks on an env's JS thread. Pushing from any number of
+// threads wakes the JS thread at most once per batch, and it runs every queued callback before
+// returning to the event loop.
+//
+// The queue doesn't keep the event loop alive by itself. Code that needs the process to stay up
+// until its callback runs (e.g. work on the Scheduler) calls Hold() first and Release() after.
+class CompletionQueue {
+ public:
+  using Callback = std::function<void(Napi::Env)>;
+
+  // The queue for `env`. Call on the env's JS thread.
+  static inline std::shared_ptr<CompletionQueue> For(Napi::Env env) {
+    static EnvLocal<std::shared_ptr<CompletionQueue>> queues;
+    auto& queue = queues.get(env);
+    if (!queue) {
+      queue.reset(new CompletionQueue());
+      queue->Open(env, queue);
+    }
+    return queue;
+  }
+
+  // Run `callback` on the JS thread. Safe to call from any thread. Callbacks pushed after the env
+  // has been torn down are dropped.
+  inline void Push(Callback callback) {
+    // Hold the lock while signalling, so node can't finalize the TSFN out from under us
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (closed_) { return; }
+    callbacks_.push_back(std::move(callback));
+    if (!signalled_) {
+      signalled_ = true;
+      tsfn_.NonBlockingCall(this, [](Napi::Env env, Napi::Function, CompletionQueue* queue) {
+        queue->Drain(env);
+      });
+    }
+  }
+
+  // Keep the event loop alive until the matching Release(). Call on the JS thread.
+  inline void Hold(Napi::Env env) {
+    if (holds_++ == 0) { tsfn_.Ref(env); }
+  }
+
+  inline void Release(Napi::Env env) {
+    if (holds_ > 0 && --holds_ == 0) { tsfn_.Unref(env); }
+  }
+
+ private:
+  CompletionQueue() = default;
+
+  inline void Open(Napi::Env env, std::shared_ptr<CompletionQueue> const& queue) {
+    // The TSFN's context keeps the queue alive until node finalizes it during env teardown
+    auto self = new std::shared_ptr<CompletionQueue>(queue);
+    tsfn_     = Napi::ThreadSafeFunction::New(
+      env,
+      Napi::Function::New(env, [](Napi::CallbackInfo const&) {}),
+      "nv::CompletionQueue",
+      0,
+      1,
+      self,
+      [](Napi::Env, std::shared_ptr<CompletionQueue>* self) {
+        {
+          std::lock_guard<std::mutex> lock((*self)->mutex_);
+          (*self)->closed_ = true;
+        }
+        delete self;
+      });
+    tsfn_.Unref(env);
+  }
+
+  inline void Drain(Napi::Env env) {
+    // Run callbacks in a callback scope, so Promises they settle run their reactions right after
+    Napi::AsyncContext context(env, "nv::CompletionQueue");
+    Napi::CallbackScope callback_scope(env, context);
+    std::vector<Callback> callbacks;
+    Napi::Error error;
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (callbacks_.empty()) {
+          signalled_ = false;
+          break;
+        }
+        callbacks.swap(callbacks_);
+      }
+      for (auto& callback : callbacks) {
+        Napi::HandleScope scope(env);
+        try {
+          callback(env);
+        } catch (Napi::Error const& e) {
+          if (error.IsEmpty()) { error = e; }
+        }
+      }
+      callbacks.clear();
+    }
+    // Surface the first failure as an uncaught exception only once every callback has run
+    if (!error.IsEmpty()) { error.ThrowAsJavaScriptException(); }
+  }
+
+  std::mutex mutex_;
+  std::vector<Callback> callbacks_;
+  bool closed_{false};
+  bool signalled_{false};
+  uint32_t holds_{0};
+  Napi::ThreadSafeFunction tsfn_;
+};
+
+}  // namespace nv
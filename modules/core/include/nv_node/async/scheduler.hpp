@@ -0,0 +1,430 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "completion_queue.hpp"
+#include "task.hpp"
+
+#include <napi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nv {
+
+// The Scheduler's thread pools. Keep blocking I/O, CPU-bound work, and threads that only submit
+// work to the GPU apart, so none of them can starve the others (or libuv's threadpool, which
+// node uses for fs and DNS).
+enum class Pool : int { io = 0, cpu = 1, gpu = 2 };
+
+// Jobs of a higher priority run before any queued job of a lower priority in the same pool.
+enum class Priority : int { high = 0, normal = 1, low = 2 };
+
+// A snapshot of a pool's counters. Times are in nanoseconds.
+struct PoolStats {
+  uint32_t threads;
+  uint64_t queued;     // jobs waiting to start
+  uint64_t running;    // jobs running now
+  uint64_t submitted;  // jobs submitted since startup
+  uint64_t completed;  // jobs finished since startup
+  uint64_t stolen;     // jobs run by a thread other than the one they were queued on
+  uint64_t wait_ns;    // total time jobs spent queued
+  uint64_t max_wait_ns;
+  uint64_t run_ns;  // total time jobs spent running
+};
+
+namespace detail {
+
+constexpr int num_pools      = 3;
+constexpr int num_priorities = 3;
+
+inline uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+// A fixed set of threads, each with a deque of jobs per priority. A thread takes the oldest job
+// from its own deques first, and when those are empty steals the newest job of the same priority
+// from another thread's. Threads start on the first submit, and again on the first submit after
+// stop() and restart().
+class WorkerPool {
+ public:
+  using Job = std::function<void()>;
+
+  inline WorkerPool(uint32_t threads) : size_(std::max(threads, 1u)) {}
+
+  inline ~WorkerPool() { stop(); }
+
+  // Wake and detach every thread, and drop the jobs still queued. Each thread exits after its
+  // current job, without being joined, so a job that never finishes can't hang the process on its
+  // way out. Until restart(), submit() drops jobs.
+  inline void stop() {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    stopped_ = true;
+    started_ = false;
+    {
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      ++generation_;
+    }
+    wake_.notify_all();
+    for (auto& thread : threads_) { thread.detach(); }
+    threads_.clear();
+    for (auto& worker : workers_) {
+      std::lock_guard<std::mutex> lock(worker->mutex);
+      for (auto& jobs : worker->jobs) {
+        queued_ -= jobs.size();
+        jobs.clear();
+      }
+    }
+  }
+
+  // Let submit() start threads again after stop()
+  inline void restart() {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    stopped_ = false;
+  }
+
+  inline bool stopped() {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    return stopped_;
+  }
+
+  // Set the number of threads. Returns false (and does nothing) once the pool has started.
+  inline bool resize(uint32_t threads) {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    if (!workers_.empty()) { return false; }
+    size_ = std::max(threads, 1u);
+    return true;
+  }
+
+  // Returns false, and drops `job`, if the pool has been stopped
+  inline bool submit(Priority priority, Job job) {
+    if (!start()) { return false; }
+    auto& self = current();
+    // Jobs submitted from one of this pool's threads stay on that thread, otherwise round-robin
+    auto index = self.pool == this ? self.index : next_.fetch_add(1) % workers_.size();
+    {
+      auto& worker = *workers_[index];
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.jobs[static_cast<int>(priority)].push_back({std::move(job), now_ns()});
+    }
+    ++submitted_;
+    {
+      // Increment under the lock so a thread can't miss the wakeup between its check and its wait
+      std::lock_guard<std::mutex> lock(sleep_mutex_);
+      ++queued_;
+    }
+    wake_.notify_one();
+    return true;
+  }
+
+  inline PoolStats stats() {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    return {size_,
+            queued_.load(),
+            running_.load(),
+            submitted_.load(),
+            completed_.load(),
+            stolen_.load(),
+            wait_ns_.load(),
+            max_wait_ns_.load(),
+            run_ns_.load()};
+  }
+
+ private:
+  struct Queued {
+    Job job;
+    uint64_t enqueued;
+  };
+
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Queued> jobs[num_priorities];
+  };
+
+  struct Current {
+    WorkerPool* pool{nullptr};
+    size_t index{0};
+  };
+
+  // The pool and index of the calling thread, if it's a pool thread
+  static inline Current& current() {
+    static thread_local Current current;
+    return current;
+  }
+
+  // Start the threads if they aren't running. Returns false if the pool has been stopped.
+  inline bool start() {
+    std::lock_guard<std::mutex> lock(start_mutex_);
+    if (stopped_) { return false; }
+    if (started_) { return true; }
+    started_ = true;
+    // The workers outlive stop(), since the threads it detached may still be reading them
+    if (workers_.empty()) {
+      for (uint32_t i = 0; i < size_; ++i) { workers_.emplace_back(new Worker()); }
+    }
+    auto generation = generation_.load();
+    for (uint32_t i = 0; i < size_; ++i) {
+      threads_.emplace_back([this, i, generation]() { run(i, generation); });
+    }
+    return true;
+  }
+
+  // Run jobs until stop() moves the pool past `generation`
+  inline void run(size_t index, uint64_t generation) {
+    current() = {this, index};
+    Queued queued;
+    while (generation_.load() == generation) {
+      if (take(index, queued)) {
+        auto start = now_ns();
+        auto wait  = start - queued.enqueued;
+        wait_ns_ += wait;
+        auto max = max_wait_ns_.load();
+        while (wait > max && !max_wait_ns_.compare_exchange_weak(max, wait)) {}
+        ++running_;
+        queued.job();
+        queued.job = nullptr;
+        --running_;
+        run_ns_ += now_ns() - start;
+        ++completed_;
+        continue;
+      }
+      std::unique_lock<std::mutex> lock(sleep_mutex_);
+      wake_.wait(lock, [&]() { return generation_.load() != generation || queued_.load() > 0; });
+    }
+  }
+
+  inline bool take(size_t index, Queued& queued) {
+    auto const size = workers_.size();
+    for (int priority = 0; priority < num_priorities; ++priority) {
+      for (size_t i = 0; i < size; ++i) {
+        auto& worker = *workers_[(index + i) % size];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        auto& jobs = worker.jobs[priority];
+        if (jobs.empty()) { continue; }
+        if (i == 0) {
+          queued = std::move(jobs.front());
+          jobs.pop_front();
+        } else {
+          queued = std::move(jobs.back());
+          jobs.pop_back();
+          ++stolen_;
+        }
+        --queued_;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  uint32_t size_;
+  bool started_{false};
+  bool stopped_{false};
+  std::atomic<uint64_t> generation_{0};
+  std::mutex start_mutex_;
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_;
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+
+  std::atomic<size_t> next_{0};
+  std::atomic<uint64_t> queued_{0};
+  std::atomic<uint64_t> running_{0};
+  std::atomic<uint64_t> submitted_{0};
+  std::atomic<uint64_t> completed_{0};
+  std::atomic<uint64_t> stolen_{0};
+  std::atomic<uint64_t> wait_ns_{0};
+  std::atomic<uint64_t> max_wait_ns_{0};
+  std::atomic<uint64_t> run_ns_{0};
+};
+
+inline uint32_t threads_from_env(char const* name, uint32_t fallback) {
+  auto value = std::getenv(name);
+  auto count = value != nullptr ? std::atoi(value) : 0;
+  return count > 0 ? static_cast<uint32_t>(count) : fallback;
+}
+
+}  // namespace detail
+
+// The process-wide thread pools native async work runs on, shared by every module. Pool sizes
+// default to NV_NODE_IO_THREADS (4), NV_NODE_CPU_THREADS (one per core), and NV_NODE_GPU_THREADS
+// (2), and can be changed with configure() until the pool's first job.
+//
+// The core addon owns the one instance, and exports it as `scheduler.instance`. Every other addon
+// that schedules work calls Scheduler::Init() from its module initializer, and loadNativeModule
+// hands it core's instance before the module is used. That doesn't depend on how the dynamic
+// linker resolves statics across addons (which differs with visibility and compiler).
+class Scheduler {
+ public:
+  // Whether this addon has the process's Scheduler yet
+  static inline bool attached() { return instance().load(std::memory_order_acquire) != nullptr; }
+
+  // The process's Scheduler. Check attached() first outside the core addon.
+  static inline Scheduler& get() { return *instance().load(std::memory_order_acquire); }
+
+  // Called once by the core addon. The Scheduler is never destroyed: its threads are stopped and
+  // detached by Stop() when the last env using it is torn down, and Start() lets them start again
+  // if another env loads the addon after that.
+  static inline Scheduler* Create() { return new Scheduler(); }
+
+  // Export `_attachScheduler(instance)`, which loadNativeModule calls with core's instance.
+  static inline void Init(Napi::Env env, Napi::Object exports) {
+    exports.Set("_attachScheduler", Napi::Function::New(env, [](Napi::CallbackInfo const& info) {
+                  auto env = info.Env();
+                  if (!info[0].IsExternal()) {
+                    NAPI_THROW(Napi::TypeError::New(env, "Expected a Scheduler"), env.Undefined());
+                  }
+                  Attach(info[0].As<Napi::External<Scheduler>>().Data());
+                  return env.Undefined();
+                }));
+  }
+
+  static inline void Attach(Scheduler* scheduler) {
+    instance().store(scheduler, std::memory_order_release);
+  }
+
+  // Stop every pool's threads, and drop the jobs still queued. Until Start(), submit() drops jobs
+  // and Schedule() rejects.
+  inline void Stop() {
+    for (auto& pool : pools_) { pool->stop(); }
+  }
+
+  // Let the pools start again after Stop(). Their threads start on their next job.
+  inline void Start() {
+    for (auto& pool : pools_) { pool->restart(); }
+  }
+
+  // Returns false if the pool has already started.
+  inline bool configure(Pool pool, uint32_t threads) { return pool_(pool).resize(threads); }
+
+  // Run `job` on a thread in `pool`. Safe to call from any thread, including the pool's own.
+  // Returns false, and drops `job`, if the Scheduler has been stopped.
+  inline bool submit(Pool pool, Priority priority, std::function<void()> job) {
+    return pool_(pool).submit(priority, std::move(job));
+  }
+
+  inline PoolStats stats(Pool pool) { return pool_(pool).stats(); }
+
+ private:
+  inline Scheduler() {
+    auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+    pools_[0].reset(new detail::WorkerPool(detail::threads_from_env("NV_NODE_IO_THREADS", 4)));
+    pools_[1].reset(new detail::WorkerPool(detail::threads_from_env("NV_NODE_CPU_THREADS", cores)));
+    pools_[2].reset(new detail::WorkerPool(detail::threads_from_env("NV_NODE_GPU_THREADS", 2)));
+  }
+
+  inline detail::WorkerPool& pool_(Pool pool) { return *pools_[static_cast<int>(pool)]; }
+
+  // This addon's pointer to the process's Scheduler
+  static inline std::atomic<Scheduler*>& instance() {
+    static std::atomic<Scheduler*> scheduler{nullptr};
+    return scheduler;
+  }
+
+  std::unique_ptr<detail::WorkerPool> pools_[detail::num_pools];
+};
+
+// Run `work` on `pool`, and settle the returned Promise on the JS thread with the Napi::Value its
+// result returns. `work` gets the Task's CancellationToken, and doesn't run at all if the Task is
+// cancelled while queued. Pass the JS API's options argument to support `signal` and `timeout`.
+//
+//   return Schedule(env, Pool::cpu, Priority::normal, options, [=](CancellationToken& token) {
+//     auto result = compute(token);
+//     return [=](Napi::Env env) -> Napi::Value { return CPPToNapi(env)(result); };
+//   });
+//
+// `settled(env)` runs on the JS thread once the work is over however it ended (done, threw,
+// cancelled, or never ran because the Scheduler was stopped), before the Promise settles, and
+// never before Schedule() returns. It's where to release what the work held. It doesn't run if the
+// env is torn down first.
+template <typename Work, typename Settled>
+inline Napi::Promise Schedule(Napi::Env env,
+                              Pool pool,
+                              Priority priority,
+                              Napi::Value const& options,
+                              Work work,
+                              Settled settled) {
+  if (!Scheduler::attached()) {
+    NAPI_THROW(Napi::Error::New(env, "Native module wasn't loaded with loadNativeModule()"),
+               Napi::Promise::Deferred::New(env).Promise());
+  }
+  auto task = new Task(env);
+  task->Observe(options);
+  auto handle = task->GetHandle();
+  auto queue  = CompletionQueue::For(env);
+  auto queued = Scheduler::get().submit(pool, priority, [handle, queue, work, settled]() mutable {
+    std::function<Napi::Value(Napi::Env)> complete;
+    bool failed{false};
+    std::string error;
+    if (!handle.Cancelled()) {
+      try {
+        complete = work(handle.Token());
+      } catch (std::exception const& e) {
+        failed = true;
+        error  = e.what();
+      } catch (...) {
+        failed = true;
+        error  = "Scheduled work threw an unknown exception";
+      }
+    }
+    queue->Push([handle, queue, complete, failed, error, settled](Napi::Env env) mutable {
+      queue->Release(env);
+      settled(env);
+      if (handle.Cancelled()) { return; }
+      if (failed) {
+        handle.Reject(Napi::Error::New(env, error).Value());
+      } else {
+        try {
+          handle.Resolve(complete ? complete(env) : env.Undefined());
+        } catch (Napi::Error const& e) {
+          handle.Reject(e.Value());
+        } catch (std::exception const& e) {
+          handle.Reject(Napi::Error::New(env, e.what()).Value());
+        }
+      }
+    });
+  });
+  if (!queued) {
+    // Still settle asynchronously, so `settled` runs after this returns
+    queue->Push([handle, settled](Napi::Env env) mutable {
+      settled(env);
+      handle.Reject(Napi::Error::New(env, "The Scheduler has been stopped").Value());
+    });
+    return task->Promise();
+  }
+  // Hold the loop until the work's callback runs. That's on this thread, so not before this.
+  queue->Hold(env);
+  return task->Promise();
+}
+
+template <typename Work>
+inline Napi::Promise Schedule(
+  Napi::Env env, Pool pool, Priority priority, Napi::Value const& options, Work work) {
+  return Schedule(env, pool, priority, options, std::move(work), [](Napi::Env) {});
+}
+
+}  // namespace nv
@@ -14,12 +14,57 @@
 
 #pragma once
 
+#include "cancellation.hpp"
+#include "completion_queue.hpp"
+
 #include <napi.h>
 
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+
 namespace nv {
 
 class Task : public Napi::AsyncWorker {
  public:
+  // A reference to a Task that can be copied to other threads, and outlives the Task. Once the
+  // Task has settled and been destroyed, resolving or rejecting through the handle does nothing.
+  class Handle {
+   public:
+    inline void Resolve() const {
+      with_task([](Task& task) { task.Resolve(); });
+    }
+    inline void Reject() const {
+      with_task([](Task& task) { task.Reject(); });
+    }
+    // Only call these on the Task's JS thread
+    inline void Resolve(Napi::Value const& value) const {
+      with_task([&](Task& task) { task.Resolve(value); });
+    }
+    inline void Reject(Napi::Value const& value) const {
+      with_task([&](Task& task) { task.Reject(value); });
+    }
+    inline bool Cancelled() const { return state_->token.cancelled(); }
+    inline CancellationToken& Token() const { return state_->token; }
+
+   private:
+    friend class Task;
+    struct State {
+      std::mutex mutex;
+      Task* task{nullptr};
+      CancellationToken token;
+    };
+
+    template <typename Func>
+    inline void with_task(Func func) const {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      if (state_->task != nullptr) { func(*state_->task); }
+    }
+
+    std::shared_ptr<State> state_{std::make_shared<State>()};
+  };
+
   static inline Napi::Promise Rejected(const Napi::Value& value) {
     return (new Task(value.Env()))->Reject(value).Promise();
   }
@@ -28,21 +73,52 @@ class Task : public Napi::AsyncWorker {
     return (new Task(value.Env()))->Resolve(value).Promise();
   }
 
+  // The error a cancelled Task rejects with: an "AbortError" (code "ABORT_ERR") when aborted, or a
+  // "TimeoutError" (code "ETIMEDOUT") when it timed out.
+  static inline Napi::Error CancelledError(Napi::Env env, CancelReason reason) {
+    auto timed_out = reason == CancelReason::timed_out;
+    auto error =
+      Napi::Error::New(env, timed_out ? "The operation timed out" : "The operation was aborted");
+    error.Set("name", timed_out ? "TimeoutError" : "AbortError");
+    error.Set("code", timed_out ? "ETIMEDOUT" : "ABORT_ERR");
+    return error;
+  }
+
   // Safe to call from any thread
   static inline void Notify(void* task) { Task::Notify(static_cast<Task*>(task)); }
 
   static inline void Notify(Task* task) {
-    if (!task->notified_ && (task->notified_ = true)) { task->Queue(); }
+    if (!task->notified_.exchange(true)) { task->Settle(); }
   }
 
   Task(Napi::Env env) : Task(env, env.Undefined()){};
   Task(Napi::Env env, Napi::Value value)
-    : Napi::AsyncWorker(env), deferred_(Napi::Promise::Deferred::New(env)) {
+    : Napi::AsyncWorker(env),
+      deferred_(Napi::Promise::Deferred::New(env)),
+      queue_(CompletionQueue::For(env)) {
     this->Inject(value);
+    auto state  = handle_.state_;
+    state->task = this;
+    state->token.on_cancel([state](CancelReason reason) {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->task != nullptr) { state->task->Cancelled(reason); }
+    });
+  }
+
+  ~Task() {
+    {
+      std::lock_guard<std::mutex> lock(handle_.state_->mutex);
+      handle_.state_->task = nullptr;
+    }
+    handle_.state_->token.on_cancel(nullptr);
   }
 
   Napi::Promise Promise() const { return deferred_.Promise(); }
 
+  Handle GetHandle() const { return handle_; }
+
+  CancellationToken& Token() const { return handle_.Token(); }
+
   Task& Inject(const Napi::Value& value) {
     if (!(value.IsObject() || value.IsFunction())) {
       val_ = value;
@@ -68,6 +144,50 @@ class Task : public Napi::AsyncWorker {
     return (notified_ ? *this : this->Inject(value)).Resolve();
   }
 
+  // Cancel the Task. Native work observing its token should stop, and the Promise rejects with
+  // CancelledError() unless it was already resolved or rejected.
+  Task& Cancel(CancelReason reason = CancelReason::aborted) {
+    Token().cancel(reason);
+    return *this;
+  }
+
+  // Cancel the Task when `options.signal` (an AbortSignal) aborts, or `options.timeout` ms from
+  // now. Promise-returning APIs should pass their options argument through here.
+  Task& Observe(const Napi::Value& options) {
+    if (!options.IsObject()) { return *this; }
+    auto env   = Env();
+    auto opts  = options.As<Napi::Object>();
+    auto state = handle_.state_;
+
+    auto timeout = opts.Get("timeout");
+    if (timeout.IsNumber() && timeout.As<Napi::Number>().Int64Value() >= 0) {
+      auto ms = timeout.As<Napi::Number>().Int64Value();
+      Token().set_timeout(std::chrono::milliseconds(ms));
+      // Also reject on time if the native work never checks its token
+      auto on_timeout = Napi::Function::New(
+        env, [state](Napi::CallbackInfo const&) { state->token.cancel(CancelReason::timed_out); });
+      timer_ = Napi::Persistent(env.Global().Get("setTimeout").As<Napi::Function>().Call(
+        {on_timeout, Napi::Number::New(env, ms)}));
+    }
+
+    auto signal = opts.Get("signal");
+    if (signal.IsObject()) {
+      auto sig = signal.As<Napi::Object>();
+      if (sig.Get("aborted").ToBoolean()) {
+        Cancel();
+      } else if (sig.Get("addEventListener").IsFunction()) {
+        auto on_abort = Napi::Function::New(
+          env, [state](Napi::CallbackInfo const&) { state->token.cancel(CancelReason::aborted); });
+        sig.Get("addEventListener")
+          .As<Napi::Function>()
+          .Call(sig, {Napi::String::New(env, "abort"), on_abort});
+        signal_   = Napi::Persistent(sig);
+        on_abort_ = Napi::Persistent(on_abort);
+      }
+    }
+    return *this;
+  }
+
   inline bool DelayResolve(const bool shouldDelayResolve) {
     if (!shouldDelayResolve) this->Resolve();
     return shouldDelayResolve;
@@ -78,18 +198,63 @@ class Task : public Napi::AsyncWorker {
   void OnOK() override {
     if (!settled_ && (settled_ = true)) {
       Napi::HandleScope scope(Env());
-      auto val = !ref_.IsEmpty() ? ref_.Value() : !val_.IsEmpty() ? val_ : Env().Undefined();
-      rejected_ == true ? deferred_.Reject(val) : deferred_.Resolve(val);
+      StopObserving();
+      if (cancelled_ != CancelReason::none) {
+        deferred_.Reject(CancelledError(Env(), cancelled_).Value());
+      } else {
+        auto val = !ref_.IsEmpty() ? ref_.Value() : !val_.IsEmpty() ? val_ : Env().Undefined();
+        rejected_ == true ? deferred_.Reject(val) : deferred_.Resolve(val);
+      }
+    }
+  }
+
+  // Called on the cancelling thread
+  void Cancelled(CancelReason reason) {
+    if (!notified_.exchange(true)) {
+      cancelled_ = reason;
+      Settle();
+    }
+  }
+
+  // Settle the Promise and delete the Task on the JS thread. Goes through the env's
+  // CompletionQueue rather than a thread-safe function per Task, so Tasks settling together wake
+  // the JS thread once.
+  void Settle() {
+    queue_->Push([this](Napi::Env) {
+      OnOK();
+      delete this;
+    });
+  }
+
+  void StopObserving() {
+    if (!timer_.IsEmpty()) {
+      Env().Global().Get("clearTimeout").As<Napi::Function>().Call({timer_.Value()});
+      timer_.Reset();
+    }
+    if (!signal_.IsEmpty()) {
+      auto sig = signal_.Value();
+      sig.Get("removeEventListener")
+        .As<Napi::Function>()
+        .Call(sig, {Napi::String::New(Env(), "abort"), on_abort_.Value()});
+      signal_.Reset();
+      on_abort_.Reset();
     }
   }
 
   bool settled_  = false;
   bool rejected_ = false;
-  bool notified_ = false;
+  std::atomic<bool> notified_{false};
+  CancelReason cancelled_{CancelReason::none};
 
   Napi::Value val_;
   Napi::Reference<Napi::Value> ref_;
   Napi::Promise::Deferred deferred_;
+
+  Handle handle_;
+  std::shared_ptr<CompletionQueue> queue_;
+  Napi::Reference<Napi::Value> timer_;
+  Napi::ObjectReference signal_;
+  Napi::FunctionReference on_abort_;
 };
 
 }  // namespace nv
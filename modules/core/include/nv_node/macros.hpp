@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include "utilities/trace.hpp"
+
 #ifndef EXPORT_PROP
 #define EXPORT_PROP(exports, name, val) exports.Set(name, val);
 #endif
@@ -29,7 +31,7 @@
     env,                                                                                        \
     exports,                                                                                    \
     Napi::String::New(env, name),                                                               \
-    func,                                                                                       \
+    nv::trace::Wrap(name, func),                                                                \
     static_cast<napi_property_attributes>(napi_writable | napi_enumerable | napi_configurable), \
     nullptr));
 #endif
@@ -15,10 +15,17 @@
 #pragma once
 
 #include "cpp_to_napi.hpp"
+#include "env_local.hpp"
 #include "napi_to_cpp.hpp"
 
 #include <napi.h>
 
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <vector>
+
 namespace nv {
 
 struct CPPToNapiValues {
@@ -42,19 +49,33 @@ struct CPPToNapiValues {
 };
 
 struct CallbackArgs {
-  // Constructor that accepts the same arguments as the Napi::CallbackInfo constructor
-  CallbackArgs(napi_env env, napi_callback_info info)
-    : CallbackArgs(new Napi::CallbackInfo(env, info), true) {}
+  // Constructor that accepts the same arguments as the Napi::CallbackInfo constructor. The
+  // Napi::CallbackInfo is constructed in-place, so this doesn't allocate.
+  CallbackArgs(napi_env env, napi_callback_info info) : raw_(info) {
+    info_ = new (&storage_) Napi::CallbackInfo(env, info);
+  }
 
   // Construct a CallbackArgs by proxying to an Napi::CallbackInfo instance
-  CallbackArgs(Napi::CallbackInfo const* info, bool owns_info = false)
-    : owns_info_(owns_info), info_(info){};
+  CallbackArgs(Napi::CallbackInfo const* info) : info_(info){};
 
   // Construct a CallbackArgs by proxying to an Napi::CallbackInfo instance
   CallbackArgs(Napi::CallbackInfo const& info) : info_(&info){};
 
+  // Copies of an owning CallbackArgs re-read the arguments from the same napi_callback_info
+  CallbackArgs(CallbackArgs const& other) : raw_(other.raw_) {
+    if (raw_ == nullptr) {
+      info_ = other.info_;
+    } else {
+      auto info = new (&storage_) Napi::CallbackInfo(other.Env(), raw_);
+      info->SetData(other.Data());
+      info_ = info;
+    }
+  }
+
+  CallbackArgs& operator=(CallbackArgs const&) = delete;
+
   ~CallbackArgs() {
-    if (owns_info_) { delete info_; }
+    if (raw_ != nullptr) { info_->~CallbackInfo(); }
     info_ = nullptr;
   }
 
@@ -74,36 +95,59 @@ struct CallbackArgs {
   inline operator Napi::CallbackInfo const &() const { return *info_; }
 
  private:
-  bool owns_info_{false};
+  napi_callback_info raw_{nullptr};
   Napi::CallbackInfo const* info_{nullptr};
+  std::aligned_storage<sizeof(Napi::CallbackInfo), alignof(Napi::CallbackInfo)>::type storage_;
 };
 
-struct ConstructorReference : public Napi::FunctionReference {
-  inline static ConstructorReference Persistent(Napi::Function const& value) {
-    return Napi::Reference<Napi::Function>::New(value, 1);
-  }
-
-  inline ConstructorReference() : Napi::FunctionReference() {}
-  inline ConstructorReference(napi_env env, napi_ref ref) : Napi::FunctionReference(env, ref) {}
+template <typename T>
+struct LazyClass;  // lazy_class.hpp
 
-  // A reference can be moved but cannot be copied.
-  inline ConstructorReference(Napi::Reference<Napi::Function>&& other)
-    : Napi::FunctionReference(std::move(other)){};
-  inline ConstructorReference& operator=(Napi::Reference<Napi::Function>&& other) {
-    static_cast<Napi::Reference<Napi::Function>*>(this)->operator=(std::move(other));
+// A JS class constructor, persisted separately for each env the addon is loaded into. Init()
+// assigns it for the env being initialized, and everything else uses the calling thread's env.
+struct ConstructorReference {
+  inline ConstructorReference& operator=(Napi::Reference<Napi::Function>&& ref) {
+    ref_.get(ref.Env()) = std::move(ref);
     return *this;
   }
-  inline ConstructorReference(ConstructorReference&& other)
-    : Napi::FunctionReference(std::move(other)){};
-  inline ConstructorReference& operator=(ConstructorReference&& other) {
-    static_cast<Napi::Reference<Napi::Function>*>(this)->operator=(std::move(other));
-    return *this;
+
+  // Call `init` (which must assign this reference) the first time the constructor is used in
+  // `env`, instead of defining the class up front. See DefineLazyClass().
+  inline void Defer(Napi::Env env, std::function<void()> init) {
+    init_.get(env) = std::move(init);
+  }
+
+  inline Napi::Env Env() const { return reference().Env(); }
+  inline Napi::Function Value() const { return reference().Value(); }
+
+  inline Napi::Object New(std::initializer_list<napi_value> args) const {
+    return reference().New(args);
   }
 
   template <typename... Args>
   inline Napi::Object New(Args&&... xs) const {
-    return Napi::FunctionReference::New(CPPToNapiValues{_env}(std::forward<Args>(xs)...));
+    auto& ctor = reference();
+    return ctor.New(CPPToNapiValues{ctor.Env()}(std::forward<Args>(xs)...));
   }
+
+ private:
+  inline Napi::FunctionReference const& reference() const {
+    static const Napi::FunctionReference empty{};
+    auto ctor = ref_.get();
+    if (ctor == nullptr || ctor->IsEmpty()) {
+      auto init = init_.get();
+      if (init != nullptr && *init) {
+        auto deferred = std::move(*init);
+        *init         = nullptr;
+        deferred();
+        ctor = ref_.get();
+      }
+    }
+    return ctor != nullptr ? *ctor : empty;
+  }
+
+  EnvLocal<Napi::FunctionReference> ref_;
+  EnvLocal<std::function<void()>> init_;
 };
 
 }  // namespace nv
@@ -0,0 +1,242 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "args.hpp"
+#include "env_local.hpp"
+#include "span.hpp"
+
+#include <nv_node/macros.hpp>
+
+#include <napi.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace nv {
+
+// JS objects that commands refer to by small integer ids, separately for each env. Id 0 is never
+// used, so it can stand for null.
+//
+// Objects are held weakly, like the WeakMap CommandEncoder keeps their ids in: a handle doesn't
+// keep its object alive, and using the handle of a collected object throws. Remove() frees a slot
+// right away. The slots of collected objects are swept up and reused when the table would grow.
+class HandleTable {
+ public:
+  static inline HandleTable& For(Napi::Env env) {
+    static EnvLocal<HandleTable> tables;
+    return tables.get(env);
+  }
+
+  inline uint32_t Add(Napi::Object const& object) {
+    if (free_.empty() && slots_.size() >= sweep_at_) { Sweep(object.Env()); }
+    uint32_t id;
+    if (free_.empty()) {
+      id = static_cast<uint32_t>(slots_.size());
+      slots_.emplace_back();
+    } else {
+      id = free_.back();
+      free_.pop_back();
+    }
+    slots_[id].ref    = Napi::Weak(object);
+    slots_[id].native = nullptr;
+    return id + 1;
+  }
+
+  inline void Remove(uint32_t id) {
+    if (Has(id)) {
+      slots_[id - 1].ref.Reset();
+      slots_[id - 1].native = nullptr;
+      free_.push_back(id - 1);
+    }
+  }
+
+  inline bool Has(uint32_t id) const {
+    return id > 0 && id <= slots_.size() && !slots_[id - 1].ref.IsEmpty();
+  }
+
+  inline Napi::Object Get(Napi::Env env, uint32_t id) const {
+    if (!Has(id)) {
+      NAPI_THROW(Napi::Error::New(env, "Invalid handle " + std::to_string(id)), Napi::Object());
+    }
+    auto object = slots_[id - 1].ref.Value();
+    if (object.IsEmpty()) {
+      NAPI_THROW(
+        Napi::Error::New(env, "The object of handle " + std::to_string(id) + " was collected"),
+        Napi::Object());
+    }
+    return object;
+  }
+
+  // The ObjectWrap<T> instance behind handle `id`. The caller is responsible for knowing that it
+  // wraps a `T`. The pointer is cached, so repeated lookups skip napi_unwrap.
+  template <typename T>
+  inline T* Unwrap(Napi::Env env, uint32_t id) {
+    auto object = Get(env, id);
+    auto& slot  = slots_[id - 1];
+    if (slot.native == nullptr) { slot.native = T::Unwrap(object); }
+    return static_cast<T*>(slot.native);
+  }
+
+  inline size_t Size() const { return slots_.size() - free_.size(); }
+
+ private:
+  // Free the slots of collected objects. Runs when the table has doubled since the last sweep, so
+  // it costs O(1) per Add on average.
+  inline void Sweep(Napi::Env env) {
+    Napi::HandleScope scope(env);
+    for (uint32_t i = 0; i < slots_.size(); ++i) {
+      auto& slot = slots_[i];
+      if (!slot.ref.IsEmpty() && slot.ref.Value().IsEmpty()) {
+        slot.ref.Reset();
+        slot.native = nullptr;
+        free_.push_back(i);
+      }
+    }
+    sweep_at_ = std::max<size_t>(64, 2 * Size());
+  }
+
+  struct Slot {
+    Napi::ObjectReference ref;
+    void* native{nullptr};
+  };
+
+  std::vector<Slot> slots_;
+  std::vector<uint32_t> free_;
+  size_t sweep_at_{64};
+};
+
+// One decoded command, as seen by its handler.
+class Command {
+ public:
+  inline Command(
+    Napi::Env env, double const* args, uint32_t size, Span<double>& results, size_t& count)
+    : env_(env), args_(args), size_(size), results_(results), count_(count) {}
+
+  inline Napi::Env Env() const { return env_; }
+  inline uint32_t Length() const { return size_; }
+
+  // Argument `i`, or 0 if the command has fewer arguments
+  inline double operator[](uint32_t i) const { return i < size_ ? args_[i] : 0; }
+
+  // The object whose handle is argument `i`
+  inline Napi::Object Object(uint32_t i) const {
+    return HandleTable::For(env_).Get(env_, static_cast<uint32_t>((*this)[i]));
+  }
+
+  // The ObjectWrap<T> instance whose handle is argument `i`
+  template <typename T>
+  inline T* Handle(uint32_t i) const {
+    return HandleTable::For(env_).Unwrap<T>(env_, static_cast<uint32_t>((*this)[i]));
+  }
+
+  // Append a value to the batch's results
+  inline void Return(double value) {
+    if (count_ >= results_.size()) {
+      NAPI_THROW_VOID(Napi::RangeError::New(env_, "Command results buffer is full"));
+    }
+    results_.data()[count_++] = value;
+  }
+
+ private:
+  Napi::Env env_;
+  double const* args_;
+  uint32_t size_;
+  Span<double>& results_;
+  size_t& count_;
+};
+
+// A module's set of batchable operations, for running many native calls in one N-API crossing.
+//
+// JS encodes commands into a Float64Array. Each command is one 8-byte header slot holding two
+// uint32s, the op code and the number of arguments, followed by that many number arguments. One
+// `execute(commands, length, results)` call runs the first `length` slots' commands in order, and
+// handlers append their results to the `results` Float64Array. See `CommandEncoder` in
+// @nvidia/rapids-core.
+class CommandTable {
+ public:
+  using Handler = void (*)(Command&);
+
+  inline CommandTable(std::initializer_list<std::pair<char const*, Handler>> ops) {
+    for (auto const& op : ops) {
+      names_.emplace_back(op.first);
+      handlers_.push_back(op.second);
+    }
+  }
+
+  // Run the first `length` slots of `commands`. Returns the number of results written.
+  inline size_t Execute(Napi::Env env, Span<double> commands, size_t length, Span<double> results) {
+    size_t count{0};
+    size_t index{0};
+    length = std::min(length, commands.size());
+    for (size_t slot = 0; slot < length; ++index) {
+      uint32_t header[2];
+      std::memcpy(header, commands.data() + slot, sizeof(header));
+      auto op   = header[0];
+      auto size = header[1];
+      if (op >= handlers_.size() || slot + 1 + size > length) {
+        NAPI_THROW(Error(env, index, "Malformed command at slot " + std::to_string(slot)), count);
+      }
+      Command command{env, commands.data() + slot + 1, size, results, count};
+      try {
+        handlers_[op](command);
+      } catch (Napi::Error& e) {
+        e.Set("commandIndex", Napi::Number::New(env, index));
+        throw;
+      }
+      slot += 1 + size;
+    }
+    return count;
+  }
+
+  // Export `{ops, execute, createHandle, releaseHandle}` as `exports[name]`.
+  inline void Export(Napi::Env env, Napi::Object exports, char const* name) {
+    auto commands = Napi::Object::New(env);
+    auto ops      = Napi::Object::New(env);
+    for (size_t i = 0; i < names_.size(); ++i) { ops.Set(names_[i], static_cast<double>(i)); }
+    commands.Set("ops", ops);
+    auto execute = [this](CallbackArgs const& args) {
+      return CPPToNapi(args)(Execute(args.Env(), args[0], args[1], args[2]));
+    };
+    auto create_handle = [](CallbackArgs const& args) {
+      return CPPToNapi(args)(HandleTable::For(args.Env()).Add(args[0].As<Napi::Object>()));
+    };
+    auto release_handle = [](CallbackArgs const& args) {
+      HandleTable::For(args.Env()).Remove(args[0]);
+      return args.Env().Undefined();
+    };
+    EXPORT_FUNC(env, commands, "execute", execute);
+    EXPORT_FUNC(env, commands, "createHandle", create_handle);
+    EXPORT_FUNC(env, commands, "releaseHandle", release_handle);
+    exports.Set(name, commands);
+  }
+
+ private:
+  static inline Napi::Error Error(Napi::Env env, size_t index, std::string const& message) {
+    auto error = Napi::Error::New(env, message);
+    error.Set("commandIndex", Napi::Number::New(env, index));
+    return error;
+  }
+
+  std::vector<std::string> names_;
+  std::vector<Handler> handlers_;
+};
+
+}  // namespace nv
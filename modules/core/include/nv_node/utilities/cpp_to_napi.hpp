@@ -15,11 +15,13 @@
 #pragma once
 
 #include "span.hpp"
+#include "trace.hpp"
 
 #include <napi.h>
 
 #include <initializer_list>
 #include <map>
+#include <memory>
 #include <stdexcept>
 #include <string>
 #include <type_traits>
@@ -45,9 +47,36 @@ template <std::size_t I = 0, typename FuncT, typename... Tp>
 
 }  // namespace casting
 
+// An owned host buffer that CPPToNapi returns to JS as a TypedArray over an external ArrayBuffer.
+// Ownership moves to the ArrayBuffer, and the buffer is released when it's garbage collected, so
+// converting it is O(1) instead of copying (or creating a JS value for) each element.
+template <typename T>
+struct ExternalArray {
+  // Take ownership of a vector's storage
+  inline ExternalArray(std::vector<T>&& vec) {
+    auto owned = std::make_shared<std::vector<T>>(std::move(vec));
+    data_      = owned->data();
+    size_      = owned->size();
+    owner_     = std::move(owned);
+  }
+
+  // Share ownership of an arbitrary host allocation of `size` elements of T
+  inline ExternalArray(std::shared_ptr<void> owner, T* data, size_t size)
+    : owner_(std::move(owner)), data_(data), size_(size) {}
+
+  inline T* data() const { return data_; }
+  inline size_t size() const { return size_; }
+  inline std::shared_ptr<void> const& owner() const { return owner_; }
+
+ private:
+  std::shared_ptr<void> owner_{};
+  T* data_{nullptr};
+  size_t size_{0};
+};
+
 struct CPPToNapi {
   Napi::Env const env;
-  inline CPPToNapi(Napi::Env const& env) : env(env) {}
+  inline CPPToNapi(Napi::Env const& env) : env(env) { trace::mark_convert(); }
   inline CPPToNapi(Napi::CallbackInfo const& info) : CPPToNapi(info.Env()) {}
 
   template <typename Arg>
@@ -191,6 +220,17 @@ struct CPPToNapi {
     return buffer_to_typed_array<T>(buf);
   }
 
+  template <typename T>
+  inline Napi::Value operator()(ExternalArray<T> const& ary) const {
+    if (ary.data() == nullptr || ary.size() == 0) {
+      return buffer_to_typed_array<T>(Napi::ArrayBuffer::New(env, 0));
+    }
+    auto owner = ary.owner();
+    auto buf   = Napi::ArrayBuffer::New(
+      env, ary.data(), ary.size() * sizeof(T), [owner](Napi::Env, void*) mutable { owner.reset(); });
+    return buffer_to_typed_array<T>(buf);
+  }
+
   template <typename T>
   inline Napi::Value operator()(Span<T> const& span) const {
     auto obj          = Napi::Object::New(env);
@@ -0,0 +1,92 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <napi.h>
+
+#include <memory>
+#include <unordered_map>
+
+namespace nv {
+
+namespace detail {
+
+// The EnvLocal values of the env running on the calling thread, keyed by EnvLocal address.
+// Node runs the main env and each worker_thread's env on its own thread, so this is enough to
+// find the right value in code that doesn't have an env handy (e.g. static factories, or C
+// callbacks from a library like GLFW).
+inline std::unordered_map<void const*, void*>& thread_env_locals() {
+  static thread_local std::unordered_map<void const*, void*> locals;
+  return locals;
+}
+
+}  // namespace detail
+
+// The addon's per-env state, stored with napi_set_instance_data. It owns every EnvLocal value
+// created in the env, and releases them when the env is torn down.
+struct InstanceData {
+  static inline InstanceData& Get(napi_env env) {
+    void* data{nullptr};
+    napi_get_instance_data(env, &data);
+    if (data == nullptr) {
+      data = new InstanceData();
+      napi_set_instance_data(env, data, &InstanceData::Finalize, nullptr);
+    }
+    return *static_cast<InstanceData*>(data);
+  }
+
+  template <typename T>
+  inline T& value(void const* key) {
+    auto iter = values_.find(key);
+    if (iter == values_.end()) {
+      iter = values_.emplace(key, std::make_shared<T>()).first;
+      detail::thread_env_locals()[key] = iter->second.get();
+    }
+    return *static_cast<T*>(iter->second.get());
+  }
+
+ private:
+  InstanceData() = default;
+
+  static inline void Finalize(napi_env, void* data, void*) {
+    auto self    = static_cast<InstanceData*>(data);
+    auto& locals = detail::thread_env_locals();
+    for (auto const& kv : self->values_) { locals.erase(kv.first); }
+    delete self;
+  }
+
+  std::unordered_map<void const*, std::shared_ptr<void>> values_;
+};
+
+// A value that's separate in each env (the main thread and each worker_thread) the addon is
+// loaded into. Use this instead of a global or static for anything that holds JS handles.
+template <typename T>
+struct EnvLocal {
+  inline EnvLocal() = default;
+  EnvLocal(EnvLocal const&) = delete;
+  EnvLocal& operator=(EnvLocal const&) = delete;
+
+  // The value for `env`, default-constructed on first use.
+  inline T& get(napi_env env) const { return InstanceData::Get(env).template value<T>(this); }
+
+  // The value for the env running on the calling thread, or nullptr if it hasn't been created.
+  inline T* get() const {
+    auto& locals = detail::thread_env_locals();
+    auto iter    = locals.find(this);
+    return iter == locals.end() ? nullptr : static_cast<T*>(iter->second);
+  }
+};
+
+}  // namespace nv
@@ -0,0 +1,71 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "args.hpp"
+
+#include <napi.h>
+
+namespace nv {
+
+// Defines classes on first use. `T` must have a static `Init(env, exports)` that assigns its static
+// ConstructorReference `constructor` and exports nothing but the class, and must befriend
+// LazyClass if `constructor` is private.
+template <typename T>
+struct LazyClass {
+  // Defer `T::Init()` until native code first needs `T::constructor` in this env. For classes
+  // that are only constructed from C++.
+  static inline void Defer(Napi::Env env) {
+    T::constructor.Defer(env, [env]() {
+      Napi::HandleScope scope(env);
+      T::Init(env, Napi::Object::New(env));
+    });
+  }
+
+  // Define `exports[name]` as a getter that runs `T::Init()` the first time it's read, then
+  // replaces itself with the class.
+  static inline void Define(Napi::Env env, Napi::Object exports, const char* name) {
+    Defer(env);
+    exports.DefineProperty(Napi::PropertyDescriptor::Accessor(
+      env,
+      exports,
+      name,
+      [name](Napi::CallbackInfo const& info) -> Napi::Value {
+        auto ctor = T::constructor.Value();
+        info.This().As<Napi::Object>().DefineProperty(Napi::PropertyDescriptor::Value(
+          name,
+          ctor,
+          static_cast<napi_property_attributes>(napi_writable | napi_enumerable |
+                                                napi_configurable)));
+        return ctor;
+      },
+      static_cast<napi_property_attributes>(napi_enumerable | napi_configurable)));
+  }
+};
+
+// Export `T` as `exports[name]`, but only define it when it's first used. Defining a class with
+// hundreds of methods isn't free, so this keeps it off the addon's load time for programs that
+// never touch it.
+template <typename T>
+inline void DefineLazyClass(Napi::Env env, Napi::Object exports, const char* name) {
+  LazyClass<T>::Define(env, exports, name);
+}
+
+template <typename T>
+inline void DeferClass(Napi::Env env) {
+  LazyClass<T>::Defer(env);
+}
+
+}  // namespace nv
@@ -14,6 +14,7 @@
 
 #pragma once
 
+#include "property_keys.hpp"
 #include "span.hpp"
 
 #include <napi.h>
@@ -27,6 +28,30 @@
 
 namespace nv {
 
+namespace detail {
+
+// The napi_typedarray_type whose elements have the same representation as T, or -1
+template <typename T>
+struct typed_array_type : std::integral_constant<int, -1> {};
+template <>
+struct typed_array_type<int8_t> : std::integral_constant<int, napi_int8_array> {};
+template <>
+struct typed_array_type<uint8_t> : std::integral_constant<int, napi_uint8_array> {};
+template <>
+struct typed_array_type<int16_t> : std::integral_constant<int, napi_int16_array> {};
+template <>
+struct typed_array_type<uint16_t> : std::integral_constant<int, napi_uint16_array> {};
+template <>
+struct typed_array_type<int32_t> : std::integral_constant<int, napi_int32_array> {};
+template <>
+struct typed_array_type<uint32_t> : std::integral_constant<int, napi_uint32_array> {};
+template <>
+struct typed_array_type<float> : std::integral_constant<int, napi_float32_array> {};
+template <>
+struct typed_array_type<double> : std::integral_constant<int, napi_float64_array> {};
+
+}  // namespace detail
+
 struct NapiToCPP {
   Napi::Value val;
   inline NapiToCPP(const Napi::Value& val) : val(val) {}
@@ -81,8 +106,9 @@ struct NapiToCPP {
 
   inline bool IsMemoryViewLike() const {
     if (IsTypedArray() || IsDataView() || IsBuffer()) { return true; }
-    if (val.IsObject() and not val.IsNull() and val.As<Napi::Object>().Has("buffer")) {
-      return NapiToCPP(val.As<Napi::Object>().Get("buffer")).IsMemoryLike();
+    if (val.IsObject() and not val.IsNull()) {
+      auto buffer = GetProperty(val, PropertyKeys::buffer);
+      return !buffer.IsUndefined() && NapiToCPP(buffer).IsMemoryLike();
     }
     return false;
   }
@@ -90,11 +116,11 @@ struct NapiToCPP {
   inline bool IsMemoryLike() const {
     if (IsArrayBuffer() || IsTypedArray() || IsDataView() || IsBuffer()) { return true; }
     if (val.IsObject() and not val.IsNull()) {
-      auto obj = val.As<Napi::Object>();
-      if (obj.Has("buffer")) {  //
-        return NapiToCPP(obj.Get("buffer")).IsMemoryLike();
+      auto buffer = GetProperty(val, PropertyKeys::buffer);
+      if (!buffer.IsUndefined()) {  //
+        return NapiToCPP(buffer).IsMemoryLike();
       }
-      return obj.Has("ptr") and obj.Get("ptr").IsNumber();
+      return GetProperty(val, PropertyKeys::ptr).IsNumber();
     }
     return false;
   }
@@ -174,6 +200,24 @@ struct NapiToCPP {
       }
       return vec;
     }
+    if (val.IsTypedArray()) {
+      auto ary = val.As<Napi::TypedArray>();
+      // Copy the elements directly when they have the same representation as T
+      if (static_cast<int>(ary.TypedArrayType()) == detail::typed_array_type<T>::value) {
+        Span<T> span = ary;
+        return std::vector<T>(span.data(), span.data() + span.size());
+      }
+      auto env = Env();
+      NapiToCPP v{env.Null()};
+      std::vector<T> vec;
+      vec.reserve(ary.ElementLength());
+      for (uint32_t i = 0; i < ary.ElementLength(); ++i) {
+        Napi::HandleScope scope{env};
+        v.val = ary.Get(i);
+        vec.push_back(v);
+      }
+      return vec;
+    }
     if (!(val.IsNull() || val.IsEmpty())) {  //
       return std::vector<T>{this->operator T()};
     }
@@ -263,23 +307,16 @@ struct NapiToCPP {
     if (val.IsObject() and not val.IsNull()) {
       size_t length{0};
       size_t offset{0};
-      auto obj = val.As<Napi::Object>();
-      if (obj.Has("byteOffset") and obj.Get("byteOffset").IsNumber()) {
-        offset = NapiToCPP(obj.Get("byteOffset"));
-      }
-      if (obj.Has("byteLength") and obj.Get("byteLength").IsNumber()) {
-        length = NapiToCPP(obj.Get("byteLength"));
-      }
-      if (obj.Has("buffer") and obj.Get("buffer").IsObject()) {
-        obj = obj.Get("buffer").As<Napi::Object>();
-      }
-      if (obj.Has("ptr")) {
-        if (obj.Get("ptr").IsNumber()) {
-          return Span<T>(static_cast<char*>(NapiToCPP(obj.Get("ptr"))) + offset, length);
+      auto props = MemoryProperties::Get(val.As<Napi::Object>());
+      if (props.byteOffset.IsNumber()) { offset = NapiToCPP(props.byteOffset); }
+      if (props.byteLength.IsNumber()) { length = NapiToCPP(props.byteLength); }
+      if (!props.ptr.IsUndefined()) {
+        if (props.ptr.IsNumber()) {
+          return Span<T>(static_cast<char*>(NapiToCPP(props.ptr)) + offset, length);
         }
         NAPI_THROW("Expected `ptr` to be numeric");
       }
-      auto span = NapiToCPP(obj).as_span<T>() + offset;
+      auto span = NapiToCPP(props.source).as_span<T>() + offset;
       if (span.data() != nullptr) {  //
         return Span<T>(span.data(), std::min(span.size(), length));
       }
@@ -289,14 +326,24 @@ struct NapiToCPP {
 
   template <typename T>
   inline T to_numeric() const {
-    if (val.IsNull() || val.IsEmpty()) { return 0; }
-    if (val.IsNumber() || val.IsString()) { return val.ToNumber(); }
-    if (val.IsBigInt()) {
-      bool lossless = true;
-      return std::is_signed<T>() ? static_cast<T>(val.As<Napi::BigInt>().Int64Value(&lossless))
-                                 : static_cast<T>(val.As<Napi::BigInt>().Uint64Value(&lossless));
+    if (val.IsEmpty()) { return 0; }
+    // Dispatch on a single napi_typeof call. Numbers and booleans are read directly rather than
+    // through the ToNumber()/ToBoolean() coercions, which create an intermediate JS value.
+    switch (val.Type()) {
+      case napi_null:
+      case napi_undefined: return 0;
+      case napi_number: return val.As<Napi::Number>();
+      case napi_string: return val.ToNumber();
+      case napi_boolean: return val.As<Napi::Boolean>().Value();
+      case napi_bigint: {
+        bool lossless = true;
+        return std::is_signed<T>() ? static_cast<T>(val.As<Napi::BigInt>().Int64Value(&lossless))
+                                   : static_cast<T>(val.As<Napi::BigInt>().Uint64Value(&lossless));
+      }
+      case napi_object:
+      case napi_function: break;
+      default: return 0;
     }
-    if (val.IsBoolean()) { return val.ToBoolean().operator bool(); }
 
     // Accept single-element numeric Arrays (e.g. OpenGL)
     if (val.IsArray()) {
@@ -312,9 +359,8 @@ struct NapiToCPP {
     }
     // Accept Objects with a numeric "ptr" field (e.g. OpenGL)
     if (val.IsObject()) {
-      auto obj = val.As<Napi::Object>();
-      if (obj.Has("ptr")) {
-        auto ptr = obj.Get("ptr");
+      auto ptr = GetProperty(val, PropertyKeys::ptr);
+      if (!ptr.IsUndefined()) {
         if (ptr.IsNumber()) {  //
           return static_cast<T>(NapiToCPP(ptr));
         }
@@ -323,6 +369,34 @@ struct NapiToCPP {
     }
     return 0;
   }
+
+  // Reads a property by its cached key. Missing properties are returned as `undefined`.
+  static inline Napi::Value GetProperty(Napi::Value const& obj, PropertyKeys::Key key) {
+    napi_value value{nullptr};
+    auto env = obj.Env();
+    NAPI_THROW_IF_FAILED(
+      env, napi_get_property(env, obj, PropertyKeys::Get(env, key), &value), Napi::Value());
+    return Napi::Value(env, value);
+  }
+
+  // The properties of an Object wrapping raw memory, fetched in a single pass:
+  // * `byteOffset` and `byteLength` from the Object
+  // * `ptr` from the Object's "buffer" field if it's an Object, otherwise from the Object itself
+  struct MemoryProperties {
+    Napi::Value byteOffset;
+    Napi::Value byteLength;
+    Napi::Value ptr;
+    Napi::Object source;
+
+    static inline MemoryProperties Get(Napi::Object const& obj) {
+      auto buffer = GetProperty(obj, PropertyKeys::buffer);
+      auto source = buffer.IsObject() ? buffer.As<Napi::Object>() : obj;
+      return {GetProperty(obj, PropertyKeys::byteOffset),
+              GetProperty(obj, PropertyKeys::byteLength),
+              GetProperty(source, PropertyKeys::ptr),
+              source};
+    }
+  };
 };
 
 }  // namespace nv
@@ -0,0 +1,89 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <napi.h>
+
+#include <memory>
+#include <unordered_map>
+
+namespace nv {
+
+// Persistent per-env handles to the property names NapiToCPP reads on every conversion, so hot
+// paths don't create a new JS string from a C-string key on each lookup.
+struct PropertyKeys {
+  enum Key : uint32_t { buffer = 0, byteLength, byteOffset, ptr, num_keys };
+
+  static inline napi_value Get(napi_env env, Key key) {
+    napi_value value{nullptr};
+    napi_get_reference_value(env, Refs::For(env).keys[key], &value);
+    return value;
+  }
+
+ private:
+  struct Refs {
+    napi_ref keys[num_keys]{};
+
+    explicit Refs(napi_env env) {
+      static const char* const names[num_keys] = {"buffer", "byteLength", "byteOffset", "ptr"};
+      Napi::HandleScope scope(env);
+      for (uint32_t i = 0; i < num_keys; ++i) {
+        napi_value name;
+        napi_create_string_utf8(env, names[i], NAPI_AUTO_LENGTH, &name);
+        napi_create_reference(env, name, 1, &keys[i]);
+      }
+    }
+
+    // Keys are cached per thread, since each env (main or worker_thread) runs on its own thread.
+    static inline Refs& For(napi_env env) {
+      auto& cache = Cache::Local();
+      if (env != cache.last_env) {
+        auto iter = cache.envs.find(env);
+        if (iter == cache.envs.end()) {
+          iter = cache.envs.emplace(env, std::unique_ptr<Refs>(new Refs(env))).first;
+          napi_add_env_cleanup_hook(env, &Refs::Cleanup, env);
+        }
+        cache.last_env  = env;
+        cache.last_refs = iter->second.get();
+      }
+      return *cache.last_refs;
+    }
+
+    static inline void Cleanup(void* arg) {
+      auto env    = static_cast<napi_env>(arg);
+      auto& cache = Cache::Local();
+      auto iter   = cache.envs.find(env);
+      if (iter != cache.envs.end()) {
+        for (auto ref : iter->second->keys) { napi_delete_reference(env, ref); }
+        cache.envs.erase(iter);
+      }
+      cache.last_env  = nullptr;
+      cache.last_refs = nullptr;
+    }
+  };
+
+  struct Cache {
+    napi_env last_env{nullptr};
+    Refs* last_refs{nullptr};
+    std::unordered_map<napi_env, std::unique_ptr<Refs>> envs;
+
+    static inline Cache& Local() {
+      static thread_local Cache cache;
+      return cache;
+    }
+  };
+};
+
+}  // namespace nv
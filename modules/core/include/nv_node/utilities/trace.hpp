@@ -0,0 +1,419 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <napi.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nv {
+namespace trace {
+
+// Opt-in tracing of JS -> C++ binding calls.
+//
+// Every EXPORT_FUNC binding is dispatched through `Call()`, and every ObjectWrap instance method
+// through `InstanceMethod()` (or webgl's INST_METHOD). When tracing is disabled, that's a single
+// relaxed load and branch before calling the binding. When enabled, each call is split into three
+// phases:
+//   * marshal: from entry until the binding is invoked (unwrapping `this`, building CallbackArgs)
+//   * native: the binding body, until it constructs the CPPToNapi that converts its result
+//   * convert: from that CPPToNapi until the binding returns
+// Bindings that convert their arguments up front can call `mark_native()` once they're done, to
+// move that time from "native" into "marshal".
+//
+// Each thread records into its own fixed-size buffers, so the hot path never takes a lock. Stats
+// are kept for every call. Individual events are kept until a thread's event buffer fills up.
+
+constexpr uint32_t max_names   = 1024;
+constexpr uint32_t num_buckets = 32;  // histogram bucket `i` counts calls taking [2^i, 2^(i+1)) ns
+constexpr uint32_t max_events  = 1 << 16;
+
+struct Event {
+  uint32_t name;
+  uint32_t thread;
+  uint64_t start;
+  uint64_t native;
+  uint64_t convert;
+  uint64_t end;
+};
+
+struct Stats {
+  std::atomic<uint64_t> count;
+  std::atomic<uint64_t> marshal_ns;
+  std::atomic<uint64_t> native_ns;
+  std::atomic<uint64_t> convert_ns;
+  std::atomic<uint64_t> buckets[num_buckets];
+};
+
+inline uint64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::steady_clock::now().time_since_epoch())
+    .count();
+}
+
+inline std::atomic<bool>& enabled_flag() {
+  static std::atomic<bool> flag{false};  // constant-initialized, so no guard check
+  return flag;
+}
+
+inline bool enabled() { return enabled_flag().load(std::memory_order_relaxed); }
+
+inline void set_enabled(bool enabled) { enabled_flag().store(enabled, std::memory_order_relaxed); }
+
+namespace detail {
+
+struct ThreadBuffer {
+  explicit ThreadBuffer(uint32_t id) : thread(id) {}
+  uint32_t const thread;
+  std::unique_ptr<Stats[]> stats{new Stats[max_names]()};
+  std::unique_ptr<Event[]> events{new Event[max_events]};
+  std::atomic<uint32_t> num_events{0};
+  std::atomic<uint64_t> dropped{0};
+};
+
+struct Registry {
+  std::mutex mutex;
+  std::deque<std::string> names;
+  std::unordered_map<std::string, uint32_t> ids;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  uint32_t num_threads{0};
+  // What threads that have since exited recorded. It's one of `buffers`, so it's reported and reset
+  // with the others.
+  ThreadBuffer* retired{nullptr};
+
+  // Never destroyed, so threads that exit after static destructors run can still retire
+  static inline Registry& get() {
+    static auto registry = new Registry{};
+    return *registry;
+  }
+
+  // Fold an exiting thread's buffer into `retired`, and free it
+  inline void retire(ThreadBuffer* buffer) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (retired == nullptr) {
+      buffers.emplace_back(new ThreadBuffer(num_threads++));
+      retired = buffers.back().get();
+    }
+    for (uint32_t i = 0; i < max_names; ++i) {
+      auto& from = buffer->stats[i];
+      auto& to   = retired->stats[i];
+      to.count.fetch_add(from.count.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      to.marshal_ns.fetch_add(from.marshal_ns.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+      to.native_ns.fetch_add(from.native_ns.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+      to.convert_ns.fetch_add(from.convert_ns.load(std::memory_order_relaxed),
+                              std::memory_order_relaxed);
+      for (uint32_t j = 0; j < num_buckets; ++j) {
+        to.buckets[j].fetch_add(from.buckets[j].load(std::memory_order_relaxed),
+                                std::memory_order_relaxed);
+      }
+    }
+    auto size  = buffer->num_events.load(std::memory_order_acquire);
+    auto start = retired->num_events.load(std::memory_order_relaxed);
+    auto kept  = std::min(size, max_events - start);
+    std::copy(buffer->events.get(), buffer->events.get() + kept, retired->events.get() + start);
+    retired->num_events.store(start + kept, std::memory_order_release);
+    retired->dropped.fetch_add(buffer->dropped.load(std::memory_order_relaxed) + (size - kept),
+                               std::memory_order_relaxed);
+    buffers.erase(std::find_if(buffers.begin(), buffers.end(), [&](auto const& b) {
+      return b.get() == buffer;
+    }));
+  }
+};
+
+// Owns this thread's buffer, and retires it when the thread exits
+struct ThreadBufferOwner {
+  ThreadBuffer* buffer{nullptr};
+  inline ~ThreadBufferOwner() {
+    if (buffer != nullptr) { Registry::get().retire(buffer); }
+  }
+};
+
+inline ThreadBuffer& thread_buffer() {
+  static thread_local ThreadBufferOwner owner;
+  if (owner.buffer == nullptr) {
+    auto& registry = Registry::get();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.buffers.emplace_back(new ThreadBuffer(registry.num_threads++));
+    owner.buffer = registry.buffers.back().get();
+  }
+  return *owner.buffer;
+}
+
+inline uint32_t log2_bucket(uint64_t ns) {
+  uint32_t i{0};
+  while (ns > 1 && i < num_buckets - 1) { ns >>= 1, ++i; }
+  return i;
+}
+
+}  // namespace detail
+
+// Intern a binding name. Called once per binding at registration.
+inline uint32_t intern(std::string const& name) {
+  auto& registry = detail::Registry::get();
+  std::lock_guard<std::mutex> lock(registry.mutex);
+  auto iter = registry.ids.find(name);
+  if (iter == registry.ids.end()) {
+    if (registry.names.size() >= max_names) { return max_names; }
+    registry.names.push_back(name);
+    iter = registry.ids.emplace(name, registry.names.size() - 1).first;
+  }
+  return iter->second;
+}
+
+// The in-flight traced call on this thread. Calls nest when a binding calls back into JS.
+struct Scope {
+  inline explicit Scope(uint32_t name) : name_(name), parent_(current()), start_(now()) {
+    current() = this;
+  }
+
+  inline ~Scope() {
+    auto end = now();
+    current() = parent_;
+    if (name_ >= max_names) { return; }
+    if (native_ == 0) { native_ = start_; }
+    if (convert_ == 0) { convert_ = end; }
+
+    auto& buffer = detail::thread_buffer();
+    auto& stats  = buffer.stats[name_];
+    stats.count.fetch_add(1, std::memory_order_relaxed);
+    stats.marshal_ns.fetch_add(native_ - start_, std::memory_order_relaxed);
+    stats.native_ns.fetch_add(convert_ - native_, std::memory_order_relaxed);
+    stats.convert_ns.fetch_add(end - convert_, std::memory_order_relaxed);
+    stats.buckets[detail::log2_bucket(end - start_)].fetch_add(1, std::memory_order_relaxed);
+
+    auto idx = buffer.num_events.load(std::memory_order_relaxed);
+    if (idx < max_events) {
+      buffer.events[idx] = {name_, buffer.thread, start_, native_, convert_, end};
+      buffer.num_events.store(idx + 1, std::memory_order_release);
+    } else {
+      buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  inline void native_begin() { native_ = now(); }
+  inline void convert_begin() {
+    convert_ = now();
+    if (native_ == 0) { native_ = start_; }
+  }
+
+  static inline Scope*& current() {
+    static thread_local Scope* scope{nullptr};
+    return scope;
+  }
+
+ private:
+  uint32_t name_;
+  Scope* parent_;
+  uint64_t start_{0};
+  uint64_t native_{0};
+  uint64_t convert_{0};
+};
+
+// Mark the end of argument marshalling in the current traced call.
+inline void mark_native() {
+  if (enabled()) {
+    if (auto scope = Scope::current()) { scope->native_begin(); }
+  }
+}
+
+// Mark the start of result conversion in the current traced call.
+inline void mark_convert() {
+  if (enabled()) {
+    if (auto scope = Scope::current()) { scope->convert_begin(); }
+  }
+}
+
+// Invoke `func(info)`, tracing it as `name` if tracing is enabled.
+template <typename Func>
+inline auto Call(uint32_t name, Func const& func, Napi::CallbackInfo const& info)
+  -> decltype(func(info)) {
+  if (!enabled()) { return func(info); }
+  Scope scope{name};
+  scope.native_begin();
+  return func(info);
+}
+
+// Wrap a binding for EXPORT_FUNC.
+template <typename Func>
+inline auto Wrap(std::string const& name, Func func) {
+  auto id = intern(name);
+  return [id, func](Napi::CallbackInfo const& info) { return Call(id, func, info); };
+}
+
+namespace detail {
+
+template <typename T>
+inline Napi::Function WrapInstanceMethod(Napi::Env env,
+                                         uint32_t id,
+                                         std::string const& name,
+                                         Napi::Value (T::*method)(Napi::CallbackInfo const&)) {
+  return Napi::Function::New(
+    env,
+    [id, method](Napi::CallbackInfo const& info) -> Napi::Value {
+      if (!enabled()) {
+        auto self = T::Unwrap(info.This().As<Napi::Object>());
+        return self != nullptr ? (self->*method)(info) : info.Env().Undefined();
+      }
+      Scope scope{id};
+      auto self = T::Unwrap(info.This().As<Napi::Object>());
+      scope.native_begin();
+      return self != nullptr ? (self->*method)(info) : info.Env().Undefined();
+    },
+    name);
+}
+
+}  // namespace detail
+
+// Wrap an ObjectWrap instance method, for use with InstanceValue(). Unwrapping `this` is counted
+// as marshalling.
+template <typename T>
+inline Napi::Function WrapInstanceMethod(Napi::Env env,
+                                         std::string const& name,
+                                         Napi::Value (T::*method)(Napi::CallbackInfo const&)) {
+  return detail::WrapInstanceMethod(env, intern(name), name, method);
+}
+
+// A traced ObjectWrap<T>::InstanceMethod, for the property list passed to DefineClass(). Stats are
+// kept as "<class_name>.<name>", so methods of the same name on different classes stay apart.
+template <typename T>
+inline Napi::ClassPropertyDescriptor<T> InstanceMethod(
+  Napi::Env env,
+  std::string const& class_name,
+  const char* name,
+  Napi::Value (T::*method)(Napi::CallbackInfo const&),
+  napi_property_attributes attributes = napi_default) {
+  auto id = intern(class_name + "." + name);
+  return Napi::ObjectWrap<T>::InstanceValue(
+    name, detail::WrapInstanceMethod(env, id, name, method), attributes);
+}
+
+// Export the `_trace` object that `@nvidia/rapids-core` uses to aggregate stats and events across
+// every loaded module. Addons may or may not share one registry (depending on how the dynamic
+// linker resolves these inline statics), so `_trace.id` identifies the registry to de-duplicate.
+inline void Init(Napi::Env env, Napi::Object exports) {
+  auto& registry = detail::Registry::get();
+  auto trace     = Napi::Object::New(env);
+
+  trace.Set("id", std::to_string(reinterpret_cast<uintptr_t>(&registry)));
+
+  trace.Set("setEnabled", Napi::Function::New(env, [](Napi::CallbackInfo const& info) {
+              set_enabled(info[0].ToBoolean());
+              return info.Env().Undefined();
+            }));
+
+  trace.Set("reset", Napi::Function::New(env, [](Napi::CallbackInfo const& info) {
+              auto& registry = detail::Registry::get();
+              std::lock_guard<std::mutex> lock(registry.mutex);
+              for (auto& buffer : registry.buffers) {
+                buffer->num_events.store(0, std::memory_order_relaxed);
+                buffer->dropped.store(0, std::memory_order_relaxed);
+                for (uint32_t i = 0; i < max_names; ++i) {
+                  auto& stats = buffer->stats[i];
+                  stats.count.store(0, std::memory_order_relaxed);
+                  stats.marshal_ns.store(0, std::memory_order_relaxed);
+                  stats.native_ns.store(0, std::memory_order_relaxed);
+                  stats.convert_ns.store(0, std::memory_order_relaxed);
+                  for (auto& bucket : stats.buckets) { bucket.store(0, std::memory_order_relaxed); }
+                }
+              }
+              return info.Env().Undefined();
+            }));
+
+  // Returns [{name, count, marshal, native, convert, histogram}], with phase totals in ns.
+  trace.Set("getStats", Napi::Function::New(env, [](Napi::CallbackInfo const& info) {
+              auto env       = info.Env();
+              auto& registry = detail::Registry::get();
+              std::lock_guard<std::mutex> lock(registry.mutex);
+              auto result = Napi::Array::New(env);
+              for (uint32_t id = 0; id < registry.names.size(); ++id) {
+                uint64_t count{0}, marshal{0}, native{0}, convert{0};
+                uint64_t buckets[num_buckets]{};
+                for (auto& buffer : registry.buffers) {
+                  auto& stats = buffer->stats[id];
+                  count += stats.count.load(std::memory_order_relaxed);
+                  marshal += stats.marshal_ns.load(std::memory_order_relaxed);
+                  native += stats.native_ns.load(std::memory_order_relaxed);
+                  convert += stats.convert_ns.load(std::memory_order_relaxed);
+                  for (uint32_t i = 0; i < num_buckets; ++i) {
+                    buckets[i] += stats.buckets[i].load(std::memory_order_relaxed);
+                  }
+                }
+                if (count == 0) { continue; }
+                auto histogram = Napi::Array::New(env, num_buckets);
+                for (uint32_t i = 0; i < num_buckets; ++i) {
+                  histogram.Set(i, Napi::Number::New(env, buckets[i]));
+                }
+                auto entry = Napi::Object::New(env);
+                entry.Set("name", registry.names[id]);
+                entry.Set("count", Napi::Number::New(env, count));
+                entry.Set("marshal", Napi::Number::New(env, marshal));
+                entry.Set("native", Napi::Number::New(env, native));
+                entry.Set("convert", Napi::Number::New(env, convert));
+                entry.Set("histogram", histogram);
+                result.Set(result.Length(), entry);
+              }
+              return result;
+            }));
+
+  // Returns {names, dropped, events}, where `events` packs each Event as 6 doubles.
+  trace.Set("getEvents", Napi::Function::New(env, [](Napi::CallbackInfo const& info) {
+              auto env       = info.Env();
+              auto& registry = detail::Registry::get();
+              std::lock_guard<std::mutex> lock(registry.mutex);
+              auto names = Napi::Array::New(env, registry.names.size());
+              for (uint32_t id = 0; id < registry.names.size(); ++id) {
+                names.Set(id, registry.names[id]);
+              }
+              std::vector<double> events;
+              uint64_t dropped{0};
+              for (auto& buffer : registry.buffers) {
+                auto size = buffer->num_events.load(std::memory_order_acquire);
+                dropped += buffer->dropped.load(std::memory_order_relaxed);
+                for (uint32_t i = 0; i < size; ++i) {
+                  auto const& e = buffer->events[i];
+                  events.insert(events.end(),
+                                {static_cast<double>(e.name),
+                                 static_cast<double>(e.thread),
+                                 static_cast<double>(e.start),
+                                 static_cast<double>(e.native),
+                                 static_cast<double>(e.convert),
+                                 static_cast<double>(e.end)});
+                }
+              }
+              auto packed = Napi::Float64Array::New(env, events.size());
+              std::copy(events.begin(), events.end(), packed.Data());
+              auto result = Napi::Object::New(env);
+              result.Set("names", names);
+              result.Set("dropped", Napi::Number::New(env, dropped));
+              result.Set("events", packed);
+              return result;
+            }));
+
+  exports.Set("_trace", trace);
+}
+
+}  // namespace trace
+}  // namespace nv
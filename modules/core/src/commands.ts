@@ -0,0 +1,121 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+/** A native module's batchable operations, as exported by `nv::CommandTable::Export()`. */
+export interface NativeCommands {
+  /** Op codes by name */
+  ops: Record<string, number>;
+  execute(commands: Float64Array, length: number, results: Float64Array): number;
+  createHandle(object: any): number;
+  releaseHandle(handle: number): void;
+}
+
+/**
+ * Records calls to a native module's batchable operations, and runs them all in one native call.
+ *
+ * Each command is a header slot (two uint32s: the op code and the argument count) followed by
+ * its number arguments. The buffers are reused from one batch to the next, and grow as needed.
+ *
+ * ```
+ * const encoder = new CommandEncoder(addon.commands);
+ * for (const [a, b] of pairs) { encoder.push(encoder.ops.add, a, b); }
+ * const count = encoder.submit();  // encoder.results[0..count) hold the sums
+ * ```
+ */
+export class CommandEncoder {
+  public readonly ops: Record<string, number>;
+
+  /** Results of the last submit(). Only the first `n` are valid, where `n` is what it returned. */
+  public results: Float64Array;
+
+  protected native: NativeCommands;
+  protected f64: Float64Array;
+  protected u32: Uint32Array;
+  protected length = 0;
+  protected handles = new WeakMap<any, number>();
+
+  constructor(native: NativeCommands, capacity = 4096, resultCapacity = capacity) {
+    this.native  = native;
+    this.ops     = native.ops;
+    this.f64     = new Float64Array(capacity);
+    this.u32     = new Uint32Array(this.f64.buffer);
+    this.results = new Float64Array(resultCapacity);
+  }
+
+  /** The size of the recorded commands in bytes */
+  public get byteLength() { return this.length * 8; }
+
+  /** Record a call to `op`. Arguments must be numbers; pass objects through handle(). */
+  public push(op: number, ...args: number[]) { return this.pushArgs(op, args); }
+
+  /** Record a call to `op` with the first `n` elements of `args`. */
+  public pushArgs(op: number, args: ArrayLike<number>, n = args.length) {
+    this.reserve(n + 1);
+    const i             = this.length;
+    this.u32[i * 2]     = op;
+    this.u32[i * 2 + 1] = n;
+    for (let j = 0; j < n; ++j) { this.f64[i + 1 + j] = args[j]; }
+    this.length = i + 1 + n;
+    return this;
+  }
+
+  /**
+   * The handle commands use to refer to `object`. Registered with the native module once, which
+   * holds `object` weakly: the handle doesn't keep it alive, and commands that use the handle after
+   * it's collected throw.
+   */
+  public handle(object: any) {
+    let id = this.handles.get(object);
+    if (id === undefined) {
+      id = this.native.createHandle(object);
+      this.handles.set(object, id);
+    }
+    return id;
+  }
+
+  /** Let the native module drop its reference to `object`. */
+  public releaseHandle(object: any) {
+    const id = this.handles.get(object);
+    if (id !== undefined) {
+      this.handles.delete(object);
+      this.native.releaseHandle(id);
+    }
+  }
+
+  /**
+   * Run the recorded commands in order, and clear them. Returns the number of values written to
+   * `results`. If a command throws, the error's `commandIndex` is the index of that command, and
+   * the commands before it have run.
+   */
+  public submit() {
+    const length = this.length;
+    this.length  = 0;
+    return length === 0 ? 0 : this.native.execute(this.f64, length, this.results);
+  }
+
+  /** Drop the recorded commands without running them. */
+  public reset() {
+    this.length = 0;
+    return this;
+  }
+
+  protected reserve(slots: number) {
+    if (this.length + slots > this.f64.length) {
+      const f64 = new Float64Array(Math.max(this.f64.length * 2, this.length + slots));
+      f64.set(this.f64.subarray(0, this.length));
+      this.f64 = f64;
+      this.u32 = new Uint32Array(f64.buffer);
+    }
+  }
+}
@@ -14,7 +14,10 @@
 
 import * as Path from 'path';
 
+export * from './commands';
 export * from './loadnativemodule';
+export * from './scheduler';
+export * from './trace';
 
 export const modules_path = Path.resolve(__dirname, '..', '..', '..');
 
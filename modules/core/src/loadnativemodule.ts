@@ -14,8 +14,30 @@
 
 import * as Path from 'path';
 
+import {registerNativeTrace} from './trace';
+
 const NODE_DEBUG = ((<any>process.env).NODE_DEBUG || (<any>process.env).NODE_ENV === 'debug');
 
+/** How long loading a native module took, in milliseconds. */
+export interface NativeModuleTiming {
+  name: string;
+  path: string;
+  /** Time in `require()`: loading the shared library and running its module initializer */
+  require: number;
+  /** Time in the module's `init()` */
+  init: number;
+}
+
+const timings: NativeModuleTiming[] = [];
+
+/**
+ * The time spent loading each native module so far, in load order. Classes are only defined the
+ * first time they're used, so this doesn't include that.
+ */
+export function getNativeModuleTimings() { return timings.slice(); }
+
+const elapsedMs = (start: bigint) => Number(process.hrtime.bigint() - start) / 1e6;
+
 export function loadNativeModule<T = any>({id}: import('module'), name: string): T {
   let moduleBasePath            = Path.dirname(id);
   let nativeModule: T|undefined = undefined;
@@ -27,21 +49,41 @@ export function loadNativeModule<T = any>({id}: import('module'), name: string):
     moduleBasePath = Path.dirname(moduleBasePath);
     moduleBasePath = Path.join(moduleBasePath, 'build', 'js');
   }
+  let path  = '';
+  let start = process.hrtime.bigint();
   for (const type of (NODE_DEBUG ? ['Debug', 'Release'] : ['Release'])) {
     try {
-      if ((nativeModule = require(Path.join(moduleBasePath, '..', type, `${name}.node`)))) {
-        break;
-      }
+      path  = Path.join(moduleBasePath, '..', type, `${name}.node`);
+      start = process.hrtime.bigint();
+      if ((nativeModule = require(path))) { break; }
     } catch (e) {
       errors.push(e);
       continue;
     }
   }
   if (nativeModule) {
+    const timing = {name, path, require: elapsedMs(start), init: 0};
+    timings.push(timing);
+    registerNativeTrace(nativeModule);
+    attachScheduler(nativeModule);
     if (typeof (<any>nativeModule).init === 'function') {
-      return (<any>nativeModule).init() || nativeModule;
+      start        = process.hrtime.bigint();
+      const result = (<any>nativeModule).init() || nativeModule;
+      timing.init  = elapsedMs(start);
+      return result;
     }
     return nativeModule;
   }
   throw new Error(errors.join('\n'));
 }
+
+let coreModule: any;
+
+// Hand modules that schedule native work the core module's Scheduler, so every module shares its
+// thread pools (and `configureScheduler()` applies to all of them).
+function attachScheduler(nativeModule: any) {
+  if (typeof nativeModule._attachScheduler === 'function') {
+    coreModule = coreModule || loadNativeModule(module, 'node_rapids_core');
+    nativeModule._attachScheduler(coreModule.scheduler.instance);
+  }
+}
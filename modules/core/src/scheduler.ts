@@ -0,0 +1,63 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {loadNativeModule} from './loadnativemodule';
+
+/** The native scheduler's thread pools. */
+export type SchedulerPool = 'io'|'cpu'|'gpu';
+
+/** A snapshot of a scheduler pool's counters. Times are in nanoseconds. */
+export interface SchedulerPoolStats {
+  threads: number;
+  /** Jobs waiting to start */
+  queued: number;
+  running: number;
+  submitted: number;
+  completed: number;
+  /** Jobs run by a thread other than the one they were queued on */
+  stolen: number;
+  /** Total time jobs spent queued */
+  waitNs: number;
+  maxWaitNs: number;
+  /** Total time jobs spent running */
+  runNs: number;
+}
+
+type PerPool<T> = Partial<Record<SchedulerPool, T>>;
+
+interface NativeScheduler {
+  configure(threads: PerPool<number>): PerPool<boolean>;
+  getStats(): Record<SchedulerPool, SchedulerPoolStats>;
+}
+
+let scheduler: NativeScheduler|undefined;
+
+// Every module shares one native scheduler, so core's addon can speak for all of them
+function nativeScheduler() {
+  return scheduler || (scheduler = loadNativeModule<any>(module, 'node_rapids_core').scheduler);
+}
+
+/**
+ * Set the number of threads in the native scheduler's pools. A pool can only be resized before it
+ * runs its first job, so call this early. Returns whether each requested pool was resized.
+ *
+ * Pool sizes can also be set with the `NV_NODE_IO_THREADS`, `NV_NODE_CPU_THREADS`, and
+ * `NV_NODE_GPU_THREADS` environment variables.
+ */
+export function configureScheduler(threads: PerPool<number>) {
+  return nativeScheduler().configure(threads);
+}
+
+/** Queue depths, wait times and run times of each of the native scheduler's pools. */
+export function getSchedulerStats() { return nativeScheduler().getStats(); }
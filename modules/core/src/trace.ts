@@ -0,0 +1,105 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as Fs from 'fs';
+
+/** Per-binding call statistics. Phase times are totals in nanoseconds. */
+export interface TraceStats {
+  name: string;
+  count: number;
+  marshal: number;
+  native: number;
+  convert: number;
+  /** `histogram[i]` is the number of calls that took [2^i, 2^(i+1)) ns. */
+  histogram: number[];
+}
+
+interface NativeTrace {
+  id: string;
+  setEnabled(enabled: boolean): void;
+  reset(): void;
+  getStats(): TraceStats[];
+  getEvents(): {names: string[], dropped: number, events: Float64Array};
+}
+
+// Native modules may or may not share a tracing registry, so key them by registry id.
+const registries = new Map<string, NativeTrace>();
+
+let tracingEnabled = !!(<any>process.env).NV_NODE_TRACE;
+
+/** @ignore */
+export function registerNativeTrace(nativeModule: any) {
+  const trace = nativeModule && <NativeTrace|undefined>nativeModule._trace;
+  if (trace && !registries.has(trace.id)) {
+    registries.set(trace.id, trace);
+    trace.setEnabled(tracingEnabled);
+  }
+}
+
+/**
+ * Enable or disable tracing of native binding calls in every loaded (and later loaded) module.
+ * Tracing starts enabled if the `NV_NODE_TRACE` environment variable is set.
+ */
+export function setTracingEnabled(enabled: boolean) {
+  tracingEnabled = enabled;
+  registries.forEach((trace) => trace.setEnabled(enabled));
+}
+
+/** Clear all recorded stats and events. */
+export function resetTrace() { registries.forEach((trace) => trace.reset()); }
+
+/** Per-binding call counts, phase totals and latency histograms, slowest total first. */
+export function getStats(): TraceStats[] {
+  const stats = new Map<string, TraceStats>();
+  registries.forEach((trace) => {
+    for (const s of trace.getStats()) {
+      const t = stats.get(s.name);
+      if (!t) {
+        stats.set(s.name, s);
+      } else {
+        t.count += s.count;
+        t.marshal += s.marshal;
+        t.native += s.native;
+        t.convert += s.convert;
+        s.histogram.forEach((n, i) => t.histogram[i] += n);
+      }
+    }
+  });
+  const total = (s: TraceStats) => s.marshal + s.native + s.convert;
+  return [...stats.values()].sort((a, b) => total(b) - total(a));
+}
+
+/**
+ * Write the recorded calls to `path` in Chrome trace-event format, for chrome://tracing or
+ * https://ui.perfetto.dev. Each call is a complete event, with its phases nested inside it.
+ */
+export function dumpTrace(path: string) {
+  const traceEvents: any[] = [];
+  let dropped              = 0;
+  registries.forEach((trace) => {
+    const {names, events, dropped: d} = trace.getEvents();
+    dropped += d;
+    for (let i = 0; i < events.length; i += 6) {
+      const [name, tid, start, native, convert, end] = events.subarray(i, i + 6);
+      const common = {pid: process.pid, tid, cat: 'nv_node'};
+      // Chrome trace timestamps and durations are in microseconds
+      traceEvents.push(
+        {...common, ph: 'X', name: names[name], ts: start / 1e3, dur: (end - start) / 1e3},
+        {...common, ph: 'X', name: 'marshal', ts: start / 1e3, dur: (native - start) / 1e3},
+        {...common, ph: 'X', name: 'native', ts: native / 1e3, dur: (convert - native) / 1e3},
+        {...common, ph: 'X', name: 'convert', ts: convert / 1e3, dur: (end - convert) / 1e3});
+    }
+  });
+  Fs.writeFileSync(path, JSON.stringify({traceEvents, otherData: {dropped}}));
+}
@@ -0,0 +1,101 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as Fs from 'fs';
+import * as Path from 'path';
+
+import {CommandEncoder} from '../src/commands';
+
+// Host-only tests of nv::CommandTable, via the trivial `noop`, `add` and `handle` commands the
+// core addon exports for benchmarking. Skipped unless it's built with its bench bindings
+// (`yarn cpp:build:bench`).
+
+const addonPath =
+  ['Release', 'Debug']
+    .map((type) => Path.join(__dirname, '..', 'build', type, 'node_rapids_core.node'))
+    .find((path) => Fs.existsSync(path) && require(path).bench);
+
+const describeIfBuilt = addonPath ? describe : describe.skip;
+
+describeIfBuilt('CommandEncoder', () => {
+  const {bench} = addonPath ? require(addonPath) : <any>{};
+
+  test('runs commands in order and collects their results', () => {
+    const encoder     = new CommandEncoder(bench.commands);
+    const {noop, add} = encoder.ops;
+    encoder.push(add, 1, 2).push(noop).push(add, 0.5, -4).push(noop, 1, 2, 3);
+    expect(encoder.submit()).toBe(2);
+    expect([...encoder.results.subarray(0, 2)]).toEqual([3, -3.5]);
+    // The encoder is empty again after a submit
+    expect(encoder.submit()).toBe(0);
+  });
+
+  test('grows its command buffer', () => {
+    const encoder = new CommandEncoder(bench.commands, 4, 1000);
+    for (let i = 0; i < 1000; ++i) { encoder.push(encoder.ops.add, i, i); }
+    expect(encoder.submit()).toBe(1000);
+    expect(encoder.results[999]).toBe(1998);
+  });
+
+  test('looks up objects by handle', () => {
+    const encoder = new CommandEncoder(bench.commands);
+    const object  = {};
+    const handle  = encoder.handle(object);
+    expect(handle).toBeGreaterThan(0);
+    expect(encoder.handle(object)).toBe(handle);
+    encoder.push(encoder.ops.handle, handle);
+    expect(encoder.submit()).toBe(1);
+    expect(encoder.results[0]).toBe(1);
+
+    encoder.releaseHandle(object);
+    encoder.push(encoder.ops.noop).push(encoder.ops.handle, handle);
+    let error: any;
+    try { encoder.submit(); } catch (e) { error = e; }
+    expect(error).toMatchObject({commandIndex: 1, message: `Invalid handle ${handle}`});
+  });
+
+  // Needs node --expose-gc
+  const testIfGC =
+    typeof (<any>global).gc === 'function' && (<any>global).FinalizationRegistry ? test : test.skip;
+
+  testIfGC('doesn\'t keep objects alive through their handles', async () => {
+    const encoder = new CommandEncoder(bench.commands);
+    let collected = false;
+    const registry = new (<any>global).FinalizationRegistry(() => { collected = true; });
+    const handle   = (() => {
+      const object = {};
+      registry.register(object, null);
+      return encoder.handle(object);
+    })();
+    for (let i = 0; i < 10 && !collected; ++i) {
+      (<any>global).gc();
+      await new Promise((resolve) => setTimeout(resolve, 0));
+    }
+    expect(collected).toBe(true);
+    encoder.push(encoder.ops.handle, handle);
+    expect(() => encoder.submit()).toThrow(`The object of handle ${handle} was collected`);
+  });
+
+  test('rejects unknown op codes', () => {
+    const encoder = new CommandEncoder(bench.commands);
+    encoder.push(1000);
+    expect(() => encoder.submit()).toThrow(/Malformed command/);
+  });
+
+  test('throws when the results buffer is full', () => {
+    const encoder = new CommandEncoder(bench.commands, 16, 1);
+    encoder.push(encoder.ops.add, 1, 1).push(encoder.ops.add, 2, 2);
+    expect(() => encoder.submit()).toThrow('Command results buffer is full');
+  });
+});
@@ -0,0 +1,126 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {spawnSync} from 'child_process';
+import * as Fs from 'fs';
+import * as Path from 'path';
+
+// Host-only tests of the native Scheduler, via `testing.spin(pool, priority, ms, options)`, which
+// busy-waits on a pool thread and resolves with the order its job started in. Skipped unless the
+// core addon is built with its testing bindings (`yarn cpp:build:bench`).
+
+const addonPath =
+  ['Release', 'Debug']
+    .map((type) => Path.join(__dirname, '..', 'build', type, 'node_rapids_core.node'))
+    .find((path) => Fs.existsSync(path) && require(path).testing);
+
+const {AbortController} = <any>global;
+
+const describeIfBuilt = addonPath ? describe : describe.skip;
+
+describeIfBuilt('Scheduler', () => {
+  const {testing, scheduler} = addonPath ? require(addonPath) : <any>{};
+
+  test('runs queued jobs in priority order', async () => {
+    // Use a single io thread so jobs queue up behind the first one. Must run before any other test
+    // uses the io pool.
+    expect(scheduler.configure({io: 1})).toEqual({io: true});
+    const blocker = testing.spin('io', 'normal', 100);
+    await new Promise((resolve) => setTimeout(resolve, 20));
+    const low    = testing.spin('io', 'low', 0);
+    const normal = testing.spin('io', 'normal', 0);
+    const high   = testing.spin('io', 'high', 0);
+    const [b, l, n, h] = await Promise.all([blocker, low, normal, high]);
+    expect(b).toBeLessThan(h);
+    expect(h).toBeLessThan(n);
+    expect(n).toBeLessThan(l);
+    expect(scheduler.configure({io: 4})).toEqual({io: false});
+  });
+
+  test('runs jobs on each pool', async () => {
+    const jobs = ['io', 'cpu', 'gpu'].map((pool) => testing.spin(pool, 'normal', 1));
+    expect((await Promise.all(jobs)).every((order) => typeof order === 'number')).toBe(true);
+  });
+
+  test('runs every job submitted', async () => {
+    const jobs = Array.from({length: 200}, () => testing.spin('cpu', 'normal', 1));
+    expect(new Set(await Promise.all(jobs)).size).toBe(200);
+  });
+
+  test('reports queue depth and wait times', async () => {
+    const before = scheduler.getStats().cpu;
+    await Promise.all(Array.from({length: 20}, () => testing.spin('cpu', 'normal', 1)));
+    const after = scheduler.getStats().cpu;
+    expect(after.threads).toBeGreaterThan(0);
+    expect(after.submitted - before.submitted).toBe(20);
+    expect(after.completed - before.completed).toBe(20);
+    expect(after.queued).toBe(0);
+    expect(after.running).toBe(0);
+    expect(after.waitNs).toBeGreaterThan(before.waitNs);
+    expect(after.runNs).toBeGreaterThan(before.runNs);
+    expect(after.maxWaitNs).toBeGreaterThan(0);
+  });
+
+  test('rejects when the job throws', async () => {
+    await expect(testing.spin('cpu', 'normal', -1)).rejects.toThrow('ms must not be negative');
+  });
+
+  test('rejects when the job throws an empty message, or something other than an exception',
+       async () => {
+         await expect(testing.fail('empty')).rejects.toBeInstanceOf(Error);
+         await expect(testing.fail('other')).rejects.toThrow('unknown exception');
+       });
+
+  test('rejects unknown pools and priorities', () => {
+    expect(() => testing.spin('disk', 'normal', 0)).toThrow('Unknown scheduler pool');
+    expect(() => testing.spin('cpu', 'urgent', 0)).toThrow('Unknown scheduler priority');
+  });
+
+  test('times out long-running jobs', async () => {
+    await expect(testing.spin('cpu', 'normal', 10000, {timeout: 20}))
+      .rejects.toMatchObject({name: 'TimeoutError'});
+  });
+
+  const testIfAbortController = AbortController ? test : test.skip;
+
+  testIfAbortController('aborts jobs', async () => {
+    const controller = new AbortController();
+    const promise    = testing.spin('cpu', 'normal', 10000, {signal: controller.signal});
+    controller.abort();
+    await expect(promise).rejects.toMatchObject({name: 'AbortError'});
+  });
+
+  test('runs jobs in an env created after the last one was torn down', () => {
+    // In a fresh process, so the only envs using the Scheduler are the two workers. The first one
+    // exiting stops the pools, and the second must start them again rather than hang.
+    const script = `
+      const {Worker} = require('worker_threads');
+      const spin = () => new Promise((resolve, reject) => {
+        const worker = new Worker(\`
+          const {parentPort, workerData} = require('worker_threads');
+          require(workerData).testing.spin('cpu', 'normal', 1).then((order) => {
+            parentPort.postMessage(order);
+          });
+        \`, {eval: true, workerData: process.argv[1]});
+        worker.once('message', () => worker.once('exit', resolve));
+        worker.once('error', reject);
+      });
+      spin().then(spin).then(() => console.log('settled'));
+    `;
+    const {stdout, stderr} =
+      spawnSync(process.execPath, ['-e', script, addonPath], {encoding: 'utf8', timeout: 10000});
+    expect(stderr).toBe('');
+    expect(stdout.trim()).toBe('settled');
+  });
+});
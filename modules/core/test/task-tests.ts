@@ -0,0 +1,73 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as Fs from 'fs';
+import * as Path from 'path';
+
+// Host-only tests of nv::Task cancellation and timeouts, via `testing.sleep(ms, options)`. Skipped
+// unless the core addon is built with its testing bindings (`yarn cpp:build:bench`).
+
+const addonPath =
+  ['Release', 'Debug']
+    .map((type) => Path.join(__dirname, '..', 'build', type, 'node_rapids_core.node'))
+    .find((path) => Fs.existsSync(path) && require(path).testing);
+
+const {AbortController} = <any>global;
+
+const describeIfBuilt = addonPath ? describe : describe.skip;
+
+describeIfBuilt('Task', () => {
+  const {testing} = addonPath ? require(addonPath) : <any>{};
+
+  test('resolves when not cancelled', async () => {
+    await expect(testing.sleep(10)).resolves.toBeUndefined();
+    await expect(testing.sleep(10, {timeout: 1000})).resolves.toBeUndefined();
+  });
+
+  test('rejects with a TimeoutError after the timeout', async () => {
+    const start = Date.now();
+    await expect(testing.sleep(10000, {timeout: 20}))
+      .rejects.toMatchObject({name: 'TimeoutError', code: 'ETIMEDOUT'});
+    expect(Date.now() - start).toBeLessThan(5000);
+  });
+
+  const testIfAbortController = AbortController ? test : test.skip;
+
+  testIfAbortController('rejects with an AbortError when the signal aborts', async () => {
+    const controller = new AbortController();
+    const promise    = testing.sleep(10000, {signal: controller.signal});
+    controller.abort();
+    await expect(promise).rejects.toMatchObject({name: 'AbortError', code: 'ABORT_ERR'});
+  });
+
+  testIfAbortController('rejects immediately if the signal is already aborted', async () => {
+    const controller = new AbortController();
+    controller.abort();
+    await expect(testing.sleep(10000, {signal: controller.signal}))
+      .rejects.toMatchObject({name: 'AbortError'});
+  });
+
+  testIfAbortController('ignores an abort after the task settles', async () => {
+    const controller = new AbortController();
+    await expect(testing.sleep(1, {signal: controller.signal})).resolves.toBeUndefined();
+    expect(() => controller.abort()).not.toThrow();
+  });
+
+  testIfAbortController('the first of abort and timeout wins', async () => {
+    const controller = new AbortController();
+    const promise    = testing.sleep(10000, {signal: controller.signal, timeout: 5000});
+    controller.abort();
+    await expect(promise).rejects.toMatchObject({name: 'AbortError'});
+  });
+});
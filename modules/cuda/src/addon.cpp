@@ -76,6 +76,7 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
   nv::Device::Init(env, exports);
   nv::memory::initModule(env, exports, driver, runtime);
 
+  nv::trace::Init(env, exports);
   return exports;
 }
 
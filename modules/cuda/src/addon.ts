@@ -53,6 +53,19 @@ export interface CUDA {
     unmapResources(resources: CUgraphicsResource[]): void;
     getMappedArray(resource: CUgraphicsResource): CUDAArray;
     getMappedPointer(resource: CUgraphicsResource): MappedGLMemory;
+    /**
+     * Copy `height` rows of `width` texels from device (or host) memory into a registered image.
+     * Maps the image for the copy, and unmaps it after.
+     */
+    copyToImage(resource: CUgraphicsResource,
+                source: CUdeviceptr,
+                width: number,
+                height: number,
+                x?: number,
+                y?: number,
+                mipLevel?: number,
+                pitch?: number,
+                stream?: CUstream): void;
 
     readonly graphicsRegisterFlags:
                {readonly none: number; readonly read_only: number; readonly write_discard: number;}
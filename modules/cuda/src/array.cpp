@@ -21,7 +21,7 @@
 
 namespace nv {
 
-Napi::FunctionReference CUDAArray::constructor;
+ConstructorReference CUDAArray::constructor;
 
 Napi::Object CUDAArray::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor = DefineClass(
@@ -42,7 +42,6 @@ Napi::Object CUDAArray::Init(Napi::Env env, Napi::Object exports) {
       InstanceAccessor("ary", &CUDAArray::GetPointer, nullptr, napi_enumerable),
     });
   CUDAArray::constructor = Napi::Persistent(ctor);
-  CUDAArray::constructor.SuppressDestruct();
   return exports;
 }
 
@@ -18,10 +18,11 @@
 
 #include <nv_node/macros.hpp>
 #include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/trace.hpp>
 
 namespace nv {
 
-Napi::FunctionReference Device::constructor;
+ConstructorReference Device::constructor;
 
 Napi::Value Device::get_num_devices(Napi::CallbackInfo const& info) {
   return CPPToNapi(info)(Device::get_num_devices());
@@ -40,19 +41,18 @@ Napi::Object Device::Init(Napi::Env env, Napi::Object exports) {
       StaticAccessor("activeDeviceId", &Device::active_device_id, nullptr, napi_enumerable),
       InstanceAccessor("id", &Device::id, nullptr, napi_enumerable),
       InstanceAccessor("pciBusName", &Device::pci_bus_name, nullptr, napi_enumerable),
-      InstanceMethod("reset", &Device::reset),
-      InstanceMethod("activate", &Device::activate),
-      InstanceMethod("getFlags", &Device::get_flags),
-      InstanceMethod("setFlags", &Device::set_flags),
-      InstanceMethod("getProperties", &Device::get_properties),
-      InstanceMethod("synchronize", &Device::synchronize),
-      InstanceMethod("canAccessPeerDevice", &Device::can_access_peer_device),
-      InstanceMethod("enablePeerAccess", &Device::enable_peer_access),
-      InstanceMethod("disablePeerAccess", &Device::disable_peer_access),
-      InstanceMethod("callInContext", &Device::call_in_device_context),
+      trace::InstanceMethod(env, "Device", "reset", &Device::reset),
+      trace::InstanceMethod(env, "Device", "activate", &Device::activate),
+      trace::InstanceMethod(env, "Device", "getFlags", &Device::get_flags),
+      trace::InstanceMethod(env, "Device", "setFlags", &Device::set_flags),
+      trace::InstanceMethod(env, "Device", "getProperties", &Device::get_properties),
+      trace::InstanceMethod(env, "Device", "synchronize", &Device::synchronize),
+      trace::InstanceMethod(env, "Device", "canAccessPeerDevice", &Device::can_access_peer_device),
+      trace::InstanceMethod(env, "Device", "enablePeerAccess", &Device::enable_peer_access),
+      trace::InstanceMethod(env, "Device", "disablePeerAccess", &Device::disable_peer_access),
+      trace::InstanceMethod(env, "Device", "callInContext", &Device::call_in_device_context),
     });
   Device::constructor = Napi::Persistent(ctor);
-  Device::constructor.SuppressDestruct();
 
   auto DeviceFlags = Napi::Object::New(env);
   EXPORT_ENUM(env, DeviceFlags, "scheduleAuto", cudaDeviceScheduleAuto);
@@ -25,6 +25,8 @@
 #include <nv_node/macros.hpp>
 #include <nv_node/utilities/args.hpp>
 
+#include <algorithm>
+
 namespace nv {
 
 // cudaError_t CUDARTAPI cudaGLGetDevices(unsigned int *pCudaDeviceCount, int *pCudaDevices,
@@ -121,6 +123,61 @@ Napi::Value cudaGraphicsSubResourceGetMappedArray(CallbackArgs const& info) {
   return CUDAArray::New(array, extent, desc, flags, array_type::GL);
 }
 
+// copyToImage(resource, source, width, height, x = 0, y = 0, mipLevel = 0, pitch = 0, stream = 0)
+// Copy `height` rows of `width` texels from `source` to (x, y) in level `mipLevel` of a registered
+// image, without a round-trip through host memory. `pitch` is the bytes between rows of `source`,
+// or 0 if they're packed. The image is only mapped for the copy, so GL can draw with it between
+// copies.
+Napi::Value cudaGraphicsGLCopyToImage(CallbackArgs const& info) {
+  auto env                        = info.Env();
+  cudaGraphicsResource_t resource = info[0];
+  Span<char> source               = info[1];
+  size_t width                    = info[2];
+  size_t height                   = info[3];
+  size_t x                        = info[4];
+  size_t y                        = info[5];
+  uint32_t mip_level              = info[6];
+  size_t pitch                    = info[7];
+  cudaStream_t stream             = info[8];
+  NODE_CUDA_TRY(CUDARTAPI::cudaGraphicsMapResources(1, &resource, stream), env);
+
+  uint32_t flags{};
+  cudaArray_t array{};
+  cudaExtent extent{};
+  cudaChannelFormatDesc desc{};
+  auto status = CUDARTAPI::cudaGraphicsSubResourceGetMappedArray(&array, resource, 0, mip_level);
+  if (status == cudaSuccess) {
+    status = CUDARTAPI::cudaArrayGetInfo(&desc, &extent, &flags, array);
+  }
+  if (status == cudaSuccess) {
+    auto texel_bytes = static_cast<size_t>(desc.x + desc.y + desc.z + desc.w) >> 3;
+    auto row_bytes   = width * texel_bytes;
+    if (pitch == 0) { pitch = row_bytes; }
+    // Sources passed as bare pointers have no size to check
+    auto source_fits = source.size() == 0 || height == 0 ||
+                       source.size() >= pitch * (height - 1) + row_bytes;
+    if (x + width > extent.width || y + height > std::max(extent.height, size_t{1}) ||
+        pitch < row_bytes || !source_fits) {
+      status = cudaErrorInvalidValue;
+    } else {
+      status = CUDARTAPI::cudaMemcpy2DToArrayAsync(array,
+                                                   x * texel_bytes,
+                                                   y,
+                                                   source.data(),
+                                                   pitch,
+                                                   row_bytes,
+                                                   height,
+                                                   cudaMemcpyDefault,
+                                                   stream);
+    }
+  }
+  // Unmapping orders the copy before GL's next use of the image
+  auto unmapped = CUDARTAPI::cudaGraphicsUnmapResources(1, &resource, stream);
+  NODE_CUDA_TRY(status, env);
+  NODE_CUDA_TRY(unmapped, env);
+  return env.Undefined();
+}
+
 namespace gl {
 Napi::Object initModule(Napi::Env env, Napi::Object exports) {
   EXPORT_FUNC(env, exports, "getDevices", nv::cudaGLGetDevices);
@@ -131,6 +188,7 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
   EXPORT_FUNC(env, exports, "unmapResources", nv::cudaGraphicsUnmapResources);
   EXPORT_FUNC(env, exports, "getMappedPointer", nv::cudaGraphicsResourceGetMappedPointer);
   EXPORT_FUNC(env, exports, "getMappedArray", nv::cudaGraphicsSubResourceGetMappedArray);
+  EXPORT_FUNC(env, exports, "copyToImage", nv::cudaGraphicsGLCopyToImage);
 
   auto cudaGraphicsRegisterFlags = Napi::Object::New(env);
   EXPORT_ENUM(env, cudaGraphicsRegisterFlags, "none", CU_GRAPHICS_REGISTER_FLAGS_NONE);
@@ -15,9 +15,11 @@
 #include "node_cuda/memory.hpp"
 #include "node_cuda/utilities/napi_to_cpp.hpp"
 
+#include <nv_node/utilities/trace.hpp>
+
 namespace nv {
 
-Napi::FunctionReference DeviceMemory::constructor;
+ConstructorReference DeviceMemory::constructor;
 
 Napi::Object DeviceMemory::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
@@ -30,10 +32,9 @@ Napi::Object DeviceMemory::Init(Napi::Env env, Napi::Object exports) {
                   InstanceAccessor("byteLength", &DeviceMemory::size, nullptr, napi_enumerable),
                   InstanceAccessor("device", &DeviceMemory::device, nullptr, napi_enumerable),
                   InstanceAccessor("ptr", &DeviceMemory::ptr, nullptr, napi_enumerable),
-                  InstanceMethod("slice", &DeviceMemory::slice),
+                  trace::InstanceMethod(env, "DeviceMemory", "slice", &DeviceMemory::slice),
                 });
   DeviceMemory::constructor = Napi::Persistent(ctor);
-  DeviceMemory::constructor.SuppressDestruct();
 
   exports.Set("DeviceMemory", ctor);
 
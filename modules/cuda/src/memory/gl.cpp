@@ -15,9 +15,11 @@
 #include "node_cuda/memory.hpp"
 #include "node_cuda/utilities/napi_to_cpp.hpp"
 
+#include <nv_node/utilities/trace.hpp>
+
 namespace nv {
 
-Napi::FunctionReference MappedGLMemory::constructor;
+ConstructorReference MappedGLMemory::constructor;
 
 Napi::Object MappedGLMemory::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
@@ -30,10 +32,9 @@ Napi::Object MappedGLMemory::Init(Napi::Env env, Napi::Object exports) {
                   InstanceAccessor("byteLength", &MappedGLMemory::size, nullptr, napi_enumerable),
                   InstanceAccessor("device", &MappedGLMemory::device, nullptr, napi_enumerable),
                   InstanceAccessor("ptr", &MappedGLMemory::ptr, nullptr, napi_enumerable),
-                  InstanceMethod("slice", &MappedGLMemory::slice),
+                  trace::InstanceMethod(env, "MappedGLMemory", "slice", &MappedGLMemory::slice),
                 });
   MappedGLMemory::constructor = Napi::Persistent(ctor);
-  MappedGLMemory::constructor.SuppressDestruct();
 
   exports.Set("MappedGLMemory", ctor);
 
@@ -15,9 +15,11 @@
 #include "node_cuda/memory.hpp"
 #include "node_cuda/utilities/napi_to_cpp.hpp"
 
+#include <nv_node/utilities/trace.hpp>
+
 namespace nv {
 
-Napi::FunctionReference IpcMemory::constructor;
+ConstructorReference IpcMemory::constructor;
 
 Napi::Object IpcMemory::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
@@ -30,11 +32,10 @@ Napi::Object IpcMemory::Init(Napi::Env env, Napi::Object exports) {
                   InstanceAccessor("byteLength", &IpcMemory::size, nullptr, napi_enumerable),
                   InstanceAccessor("device", &IpcMemory::device, nullptr, napi_enumerable),
                   InstanceAccessor("ptr", &IpcMemory::ptr, nullptr, napi_enumerable),
-                  InstanceMethod("slice", &IpcMemory::slice),
-                  InstanceMethod("close", &IpcMemory::close),
+                  trace::InstanceMethod(env, "IpcMemory", "slice", &IpcMemory::slice),
+                  trace::InstanceMethod(env, "IpcMemory", "close", &IpcMemory::close),
                 });
   IpcMemory::constructor = Napi::Persistent(ctor);
-  IpcMemory::constructor.SuppressDestruct();
 
   exports.Set("IpcMemory", ctor);
 
@@ -89,7 +90,7 @@ Napi::Value IpcMemory::slice(Napi::CallbackInfo const& info) {
   return copy;
 }
 
-Napi::FunctionReference IpcHandle::constructor;
+ConstructorReference IpcHandle::constructor;
 
 Napi::Object IpcHandle::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
@@ -102,10 +103,9 @@ Napi::Object IpcHandle::Init(Napi::Env env, Napi::Object exports) {
                   InstanceAccessor("buffer", &IpcHandle::buffer, nullptr, napi_enumerable),
                   InstanceAccessor("device", &IpcHandle::device, nullptr, napi_enumerable),
                   InstanceAccessor("handle", &IpcHandle::handle, nullptr, napi_enumerable),
-                  InstanceMethod("close", &IpcHandle::close),
+                  trace::InstanceMethod(env, "IpcHandle", "close", &IpcHandle::close),
                 });
   IpcHandle::constructor = Napi::Persistent(ctor);
-  IpcHandle::constructor.SuppressDestruct();
 
   exports.Set("IpcHandle", ctor);
 
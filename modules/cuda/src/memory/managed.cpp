@@ -15,9 +15,11 @@
 #include "node_cuda/memory.hpp"
 #include "node_cuda/utilities/napi_to_cpp.hpp"
 
+#include <nv_node/utilities/trace.hpp>
+
 namespace nv {
 
-Napi::FunctionReference ManagedMemory::constructor;
+ConstructorReference ManagedMemory::constructor;
 
 Napi::Object ManagedMemory::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
@@ -30,10 +32,9 @@ Napi::Object ManagedMemory::Init(Napi::Env env, Napi::Object exports) {
                   InstanceAccessor("byteLength", &ManagedMemory::size, nullptr, napi_enumerable),
                   InstanceAccessor("device", &ManagedMemory::device, nullptr, napi_enumerable),
                   InstanceAccessor("ptr", &ManagedMemory::ptr, nullptr, napi_enumerable),
-                  InstanceMethod("slice", &ManagedMemory::slice),
+                  trace::InstanceMethod(env, "ManagedMemory", "slice", &ManagedMemory::slice),
                 });
   ManagedMemory::constructor = Napi::Persistent(ctor);
-  ManagedMemory::constructor.SuppressDestruct();
 
   exports.Set("ManagedMemory", ctor);
 
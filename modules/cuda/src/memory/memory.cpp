@@ -16,6 +16,7 @@
 #include "node_cuda/utilities/napi_to_cpp.hpp"
 
 #include <nv_node/macros.hpp>
+#include <nv_node/utilities/lazy_class.hpp>
 
 namespace nv {
 
@@ -115,12 +116,12 @@ Napi::Object initModule(Napi::Env env,
                         Napi::Object exports,
                         Napi::Object driver,
                         Napi::Object runtime) {
-  nv::PinnedMemory::Init(env, exports);
-  nv::DeviceMemory::Init(env, exports);
-  nv::ManagedMemory::Init(env, exports);
-  nv::IpcMemory::Init(env, exports);
-  nv::IpcHandle::Init(env, exports);
-  nv::MappedGLMemory::Init(env, exports);
+  nv::DefineLazyClass<nv::PinnedMemory>(env, exports, "PinnedMemory");
+  nv::DefineLazyClass<nv::DeviceMemory>(env, exports, "DeviceMemory");
+  nv::DefineLazyClass<nv::ManagedMemory>(env, exports, "ManagedMemory");
+  nv::DefineLazyClass<nv::IpcMemory>(env, exports, "IpcMemory");
+  nv::DefineLazyClass<nv::IpcHandle>(env, exports, "IpcHandle");
+  nv::DefineLazyClass<nv::MappedGLMemory>(env, exports, "MappedGLMemory");
 
   EXPORT_FUNC(env, runtime, "cudaMemset", cudaMemsetNapi);
   EXPORT_FUNC(env, runtime, "cudaMemcpy", cudaMemcpyNapi);
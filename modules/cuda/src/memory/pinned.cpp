@@ -15,9 +15,11 @@
 #include "node_cuda/memory.hpp"
 #include "node_cuda/utilities/napi_to_cpp.hpp"
 
+#include <nv_node/utilities/trace.hpp>
+
 namespace nv {
 
-Napi::FunctionReference PinnedMemory::constructor;
+ConstructorReference PinnedMemory::constructor;
 
 Napi::Object PinnedMemory::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
@@ -30,10 +32,9 @@ Napi::Object PinnedMemory::Init(Napi::Env env, Napi::Object exports) {
                   InstanceAccessor("byteLength", &PinnedMemory::size, nullptr, napi_enumerable),
                   InstanceAccessor("device", &PinnedMemory::device, nullptr, napi_enumerable),
                   InstanceAccessor("ptr", &PinnedMemory::ptr, nullptr, napi_enumerable),
-                  InstanceMethod("slice", &PinnedMemory::slice),
+                  trace::InstanceMethod(env, "PinnedMemory", "slice", &PinnedMemory::slice),
                 });
   PinnedMemory::constructor = Napi::Persistent(ctor);
-  PinnedMemory::constructor.SuppressDestruct();
 
   exports.Set("PinnedMemory", ctor);
 
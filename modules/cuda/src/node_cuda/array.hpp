@@ -14,6 +14,8 @@
 
 #pragma once
 
+#include <nv_node/utilities/args.hpp>
+
 #include <cuda_runtime_api.h>
 #include <napi.h>
 
@@ -50,7 +52,9 @@ class CUDAArray : public Napi::ObjectWrap<CUDAArray> {
   // void Finalize(Napi::Env env) override;
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::Value GetPointer(Napi::CallbackInfo const& info);
   Napi::Value GetByteLength(Napi::CallbackInfo const& info);
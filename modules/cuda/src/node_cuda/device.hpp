@@ -209,7 +209,7 @@ class Device : public Napi::ObjectWrap<Device> {
   std::string const& pci_bus_name() const { return pci_bus_name_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  static ConstructorReference constructor;
 
   int32_t id_{};              ///< The CUDA device identifer
   cudaDeviceProp props_;      ///< The CUDA device properties
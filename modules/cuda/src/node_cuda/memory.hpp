@@ -121,7 +121,9 @@ class PinnedMemory : public Napi::ObjectWrap<PinnedMemory>, public Memory {
   void Finalize(Napi::Env env) override;
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::Value slice(Napi::CallbackInfo const& info);
 };
@@ -181,7 +183,9 @@ class DeviceMemory : public Napi::ObjectWrap<DeviceMemory>, public Memory {
   void Finalize(Napi::Env env) override;
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::Value slice(Napi::CallbackInfo const& info);
 };
@@ -241,7 +245,9 @@ class ManagedMemory : public Napi::ObjectWrap<ManagedMemory>, public Memory {
   void Finalize(Napi::Env env) override;
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::Value slice(Napi::CallbackInfo const& info);
 };
@@ -309,7 +315,9 @@ class IpcMemory : public Napi::ObjectWrap<IpcMemory>, public Memory {
   void close(Napi::Env const& env);
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::Value slice(Napi::CallbackInfo const& info);
   Napi::Value close(Napi::CallbackInfo const& info);
@@ -384,7 +392,9 @@ class IpcHandle : public Napi::ObjectWrap<IpcHandle> {
   void close(Napi::Env const& env);
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::ObjectReference dmem_;
   Napi::Reference<Napi::Uint8Array> handle_;
@@ -450,7 +460,9 @@ class MappedGLMemory : public Napi::ObjectWrap<MappedGLMemory>, public Memory {
   void Finalize(Napi::Env env) override;
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::Value slice(Napi::CallbackInfo const& info);
 };
@@ -14,11 +14,13 @@
 
 #include "node_cuda/array.hpp"
 
+#include <nv_node/utilities/lazy_class.hpp>
+
 namespace nv {
 
 namespace texture {
 Napi::Object initModule(Napi::Env env, Napi::Object exports) {
-  nv::CUDAArray::Init(env, exports);
+  nv::DeferClass<nv::CUDAArray>(env);
   return exports;
 }
 }  // namespace texture
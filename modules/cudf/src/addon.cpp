@@ -20,6 +20,7 @@
 #include <node_cudf/utilities/dtypes.hpp>
 
 #include <nv_node/macros.hpp>
+#include <nv_node/utilities/lazy_class.hpp>
 
 #include <napi.h>
 
@@ -36,11 +37,12 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
   EXPORT_FUNC(env, exports, "init", nv::cudfInit);
   EXPORT_FUNC(env, exports, "findCommonType", nv::find_common_type);
 
-  nv::Column::Init(env, exports);
-  nv::Table::Init(env, exports);
-  nv::Scalar::Init(env, exports);
-  nv::GroupBy::Init(env, exports);
+  nv::DefineLazyClass<nv::Column>(env, exports, "Column");
+  nv::DefineLazyClass<nv::Table>(env, exports, "Table");
+  nv::DefineLazyClass<nv::Scalar>(env, exports, "Scalar");
+  nv::DefineLazyClass<nv::GroupBy>(env, exports, "GroupBy");
 
+  nv::trace::Init(env, exports);
   return exports;
 }
 
@@ -29,6 +29,7 @@
 #include <nv_node/utilities/args.hpp>
 #include <nv_node/utilities/cpp_to_napi.hpp>
 #include <nv_node/utilities/napi_to_cpp.hpp>
+#include <nv_node/utilities/trace.hpp>
 
 #include <cudf/column/column.hpp>
 #include <cudf/column/column_view.hpp>
@@ -116,7 +117,7 @@ ObjectUnwrap<DeviceBuffer> get_or_create_data(NapiToCPP const& value, cudf::data
 // Public API
 //
 
-Napi::FunctionReference Column::constructor;
+ConstructorReference Column::constructor;
 
 Napi::Object Column::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
@@ -133,93 +134,93 @@ Napi::Object Column::Init(Napi::Env env, Napi::Object exports) {
                   InstanceAccessor<&Column::is_nullable>("nullable"),
                   InstanceAccessor<&Column::num_children>("numChildren"),
 
-                  InstanceMethod<&Column::get_child>("getChild"),
-                  InstanceMethod<&Column::get_value>("getValue"),
-                  InstanceMethod<&Column::set_null_mask>("setNullMask"),
-                  InstanceMethod<&Column::set_null_count>("setNullCount"),
+                  trace::InstanceMethod(env, "Column", "getChild", &Column::get_child),
+                  trace::InstanceMethod(env, "Column", "getValue", &Column::get_value),
+                  trace::InstanceMethod(env, "Column", "setNullMask", &Column::set_null_mask),
+                  trace::InstanceMethod(env, "Column", "setNullCount", &Column::set_null_count),
                   // column/copying.cpp
-                  InstanceMethod<&Column::gather>("gather"),
+                  trace::InstanceMethod(env, "Column", "gather", &Column::gather),
                   // column/binaryop.cpp
-                  InstanceMethod<&Column::add>("add"),
-                  InstanceMethod<&Column::sub>("sub"),
-                  InstanceMethod<&Column::mul>("mul"),
-                  InstanceMethod<&Column::div>("div"),
-                  InstanceMethod<&Column::true_div>("true_div"),
-                  InstanceMethod<&Column::floor_div>("floor_div"),
-                  InstanceMethod<&Column::mod>("mod"),
-                  InstanceMethod<&Column::pow>("pow"),
-                  InstanceMethod<&Column::eq>("eq"),
-                  InstanceMethod<&Column::ne>("ne"),
-                  InstanceMethod<&Column::lt>("lt"),
-                  InstanceMethod<&Column::gt>("gt"),
-                  InstanceMethod<&Column::le>("le"),
-                  InstanceMethod<&Column::ge>("ge"),
-                  InstanceMethod<&Column::bitwise_and>("bitwise_and"),
-                  InstanceMethod<&Column::bitwise_or>("bitwise_or"),
-                  InstanceMethod<&Column::bitwise_xor>("bitwise_xor"),
-                  InstanceMethod<&Column::logical_and>("logical_and"),
-                  InstanceMethod<&Column::logical_or>("logical_or"),
-                  InstanceMethod<&Column::coalesce>("coalesce"),
-                  InstanceMethod<&Column::shift_left>("shift_left"),
-                  InstanceMethod<&Column::shift_right>("shift_right"),
-                  InstanceMethod<&Column::shift_right_unsigned>("shift_right_unsigned"),
-                  InstanceMethod<&Column::log_base>("log_base"),
-                  InstanceMethod<&Column::atan2>("atan2"),
-                  InstanceMethod<&Column::null_equals>("null_equals"),
-                  InstanceMethod<&Column::null_max>("null_max"),
-                  InstanceMethod<&Column::null_min>("null_min"),
+                  trace::InstanceMethod(env, "Column", "add", &Column::add),
+                  trace::InstanceMethod(env, "Column", "sub", &Column::sub),
+                  trace::InstanceMethod(env, "Column", "mul", &Column::mul),
+                  trace::InstanceMethod(env, "Column", "div", &Column::div),
+                  trace::InstanceMethod(env, "Column", "true_div", &Column::true_div),
+                  trace::InstanceMethod(env, "Column", "floor_div", &Column::floor_div),
+                  trace::InstanceMethod(env, "Column", "mod", &Column::mod),
+                  trace::InstanceMethod(env, "Column", "pow", &Column::pow),
+                  trace::InstanceMethod(env, "Column", "eq", &Column::eq),
+                  trace::InstanceMethod(env, "Column", "ne", &Column::ne),
+                  trace::InstanceMethod(env, "Column", "lt", &Column::lt),
+                  trace::InstanceMethod(env, "Column", "gt", &Column::gt),
+                  trace::InstanceMethod(env, "Column", "le", &Column::le),
+                  trace::InstanceMethod(env, "Column", "ge", &Column::ge),
+                  trace::InstanceMethod(env, "Column", "bitwise_and", &Column::bitwise_and),
+                  trace::InstanceMethod(env, "Column", "bitwise_or", &Column::bitwise_or),
+                  trace::InstanceMethod(env, "Column", "bitwise_xor", &Column::bitwise_xor),
+                  trace::InstanceMethod(env, "Column", "logical_and", &Column::logical_and),
+                  trace::InstanceMethod(env, "Column", "logical_or", &Column::logical_or),
+                  trace::InstanceMethod(env, "Column", "coalesce", &Column::coalesce),
+                  trace::InstanceMethod(env, "Column", "shift_left", &Column::shift_left),
+                  trace::InstanceMethod(env, "Column", "shift_right", &Column::shift_right),
+                  trace::InstanceMethod(
+                    env, "Column", "shift_right_unsigned", &Column::shift_right_unsigned),
+                  trace::InstanceMethod(env, "Column", "log_base", &Column::log_base),
+                  trace::InstanceMethod(env, "Column", "atan2", &Column::atan2),
+                  trace::InstanceMethod(env, "Column", "null_equals", &Column::null_equals),
+                  trace::InstanceMethod(env, "Column", "null_max", &Column::null_max),
+                  trace::InstanceMethod(env, "Column", "null_min", &Column::null_min),
                   // column/stream_compaction.cpp
-                  InstanceMethod<&Column::drop_nulls>("drop_nulls"),
-                  InstanceMethod<&Column::drop_nans>("drop_nans"),
+                  trace::InstanceMethod(env, "Column", "drop_nulls", &Column::drop_nulls),
+                  trace::InstanceMethod(env, "Column", "drop_nans", &Column::drop_nans),
                   // column/transform.cpp
-                  InstanceMethod<&Column::nans_to_nulls>("nans_to_nulls"),
+                  trace::InstanceMethod(env, "Column", "nans_to_nulls", &Column::nans_to_nulls),
                   // column/reduction.cpp
-                  InstanceMethod<&Column::min>("min"),
-                  InstanceMethod<&Column::max>("max"),
-                  InstanceMethod<&Column::minmax>("minmax"),
-                  InstanceMethod<&Column::sum>("sum"),
-                  InstanceMethod<&Column::product>("product"),
-                  InstanceMethod<&Column::any>("any"),
-                  InstanceMethod<&Column::all>("all"),
-                  InstanceMethod<&Column::sum_of_squares>("sum_of_squares"),
-                  InstanceMethod<&Column::mean>("mean"),
-                  InstanceMethod<&Column::median>("median"),
-                  InstanceMethod<&Column::nunique>("nunique"),
-                  InstanceMethod<&Column::variance>("var"),
-                  InstanceMethod<&Column::std>("std"),
-                  InstanceMethod<&Column::quantile>("quantile"),
+                  trace::InstanceMethod(env, "Column", "min", &Column::min),
+                  trace::InstanceMethod(env, "Column", "max", &Column::max),
+                  trace::InstanceMethod(env, "Column", "minmax", &Column::minmax),
+                  trace::InstanceMethod(env, "Column", "sum", &Column::sum),
+                  trace::InstanceMethod(env, "Column", "product", &Column::product),
+                  trace::InstanceMethod(env, "Column", "any", &Column::any),
+                  trace::InstanceMethod(env, "Column", "all", &Column::all),
+                  trace::InstanceMethod(env, "Column", "sum_of_squares", &Column::sum_of_squares),
+                  trace::InstanceMethod(env, "Column", "mean", &Column::mean),
+                  trace::InstanceMethod(env, "Column", "median", &Column::median),
+                  trace::InstanceMethod(env, "Column", "nunique", &Column::nunique),
+                  trace::InstanceMethod(env, "Column", "var", &Column::variance),
+                  trace::InstanceMethod(env, "Column", "std", &Column::std),
+                  trace::InstanceMethod(env, "Column", "quantile", &Column::quantile),
                   // column/unaryop.cpp
-                  InstanceMethod<&Column::cast>("cast"),
-                  InstanceMethod<&Column::is_null>("isNull"),
-                  InstanceMethod<&Column::is_valid>("isValid"),
-                  InstanceMethod<&Column::is_nan>("isNaN"),
-                  InstanceMethod<&Column::is_not_nan>("isNotNaN"),
-                  InstanceMethod<&Column::sin>("sin"),
-                  InstanceMethod<&Column::cos>("cos"),
-                  InstanceMethod<&Column::tan>("tan"),
-                  InstanceMethod<&Column::arcsin>("asin"),
-                  InstanceMethod<&Column::arccos>("acos"),
-                  InstanceMethod<&Column::arctan>("atan"),
-                  InstanceMethod<&Column::sinh>("sinh"),
-                  InstanceMethod<&Column::cosh>("cosh"),
-                  InstanceMethod<&Column::tanh>("tanh"),
-                  InstanceMethod<&Column::arcsinh>("asinh"),
-                  InstanceMethod<&Column::arccosh>("acosh"),
-                  InstanceMethod<&Column::arctanh>("atanh"),
-                  InstanceMethod<&Column::exp>("exp"),
-                  InstanceMethod<&Column::log>("log"),
-                  InstanceMethod<&Column::sqrt>("sqrt"),
-                  InstanceMethod<&Column::cbrt>("cbrt"),
-                  InstanceMethod<&Column::ceil>("ceil"),
-                  InstanceMethod<&Column::floor>("floor"),
-                  InstanceMethod<&Column::abs>("abs"),
-                  InstanceMethod<&Column::rint>("rint"),
-                  InstanceMethod<&Column::bit_invert>("bit_invert"),
-                  InstanceMethod<&Column::unary_not>("not"),
+                  trace::InstanceMethod(env, "Column", "cast", &Column::cast),
+                  trace::InstanceMethod(env, "Column", "isNull", &Column::is_null),
+                  trace::InstanceMethod(env, "Column", "isValid", &Column::is_valid),
+                  trace::InstanceMethod(env, "Column", "isNaN", &Column::is_nan),
+                  trace::InstanceMethod(env, "Column", "isNotNaN", &Column::is_not_nan),
+                  trace::InstanceMethod(env, "Column", "sin", &Column::sin),
+                  trace::InstanceMethod(env, "Column", "cos", &Column::cos),
+                  trace::InstanceMethod(env, "Column", "tan", &Column::tan),
+                  trace::InstanceMethod(env, "Column", "asin", &Column::arcsin),
+                  trace::InstanceMethod(env, "Column", "acos", &Column::arccos),
+                  trace::InstanceMethod(env, "Column", "atan", &Column::arctan),
+                  trace::InstanceMethod(env, "Column", "sinh", &Column::sinh),
+                  trace::InstanceMethod(env, "Column", "cosh", &Column::cosh),
+                  trace::InstanceMethod(env, "Column", "tanh", &Column::tanh),
+                  trace::InstanceMethod(env, "Column", "asinh", &Column::arcsinh),
+                  trace::InstanceMethod(env, "Column", "acosh", &Column::arccosh),
+                  trace::InstanceMethod(env, "Column", "atanh", &Column::arctanh),
+                  trace::InstanceMethod(env, "Column", "exp", &Column::exp),
+                  trace::InstanceMethod(env, "Column", "log", &Column::log),
+                  trace::InstanceMethod(env, "Column", "sqrt", &Column::sqrt),
+                  trace::InstanceMethod(env, "Column", "cbrt", &Column::cbrt),
+                  trace::InstanceMethod(env, "Column", "ceil", &Column::ceil),
+                  trace::InstanceMethod(env, "Column", "floor", &Column::floor),
+                  trace::InstanceMethod(env, "Column", "abs", &Column::abs),
+                  trace::InstanceMethod(env, "Column", "rint", &Column::rint),
+                  trace::InstanceMethod(env, "Column", "bit_invert", &Column::bit_invert),
+                  trace::InstanceMethod(env, "Column", "not", &Column::unary_not),
                 });
 
   Column::constructor = Napi::Persistent(ctor);
-  Column::constructor.SuppressDestruct();
   exports.Set("Column", ctor);
 
   return exports;
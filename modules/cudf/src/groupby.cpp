@@ -20,6 +20,7 @@
 #include <cudf/groupby.hpp>
 #include <cudf/types.hpp>
 #include <node_cuda/utilities/error.hpp>
+#include <nv_node/utilities/trace.hpp>
 
 #include <napi.h>
 
@@ -29,31 +30,31 @@ namespace nv {
 // Public API
 //
 
-Napi::FunctionReference GroupBy::constructor;
+ConstructorReference GroupBy::constructor;
 
 Napi::Object GroupBy::Init(Napi::Env env, Napi::Object exports) {
-  Napi::Function ctor = DefineClass(env,
-                                    "GroupBy",
-                                    {
-                                      InstanceMethod<&GroupBy::get_groups>("_getGroups"),
-                                      // aggregations
-                                      InstanceMethod<&GroupBy::argmax>("_argmax"),
-                                      InstanceMethod<&GroupBy::argmin>("_argmin"),
-                                      InstanceMethod<&GroupBy::count>("_count"),
-                                      InstanceMethod<&GroupBy::max>("_max"),
-                                      InstanceMethod<&GroupBy::mean>("_mean"),
-                                      InstanceMethod<&GroupBy::median>("_median"),
-                                      InstanceMethod<&GroupBy::min>("_min"),
-                                      InstanceMethod<&GroupBy::nth>("_nth"),
-                                      InstanceMethod<&GroupBy::nunique>("_nunique"),
-                                      InstanceMethod<&GroupBy::std>("_std"),
-                                      InstanceMethod<&GroupBy::sum>("_sum"),
-                                      InstanceMethod<&GroupBy::var>("_var"),
-                                      InstanceMethod<&GroupBy::quantile>("_quantile"),
-                                    });
+  Napi::Function ctor = DefineClass(
+    env,
+    "GroupBy",
+    {
+      trace::InstanceMethod(env, "GroupBy", "_getGroups", &GroupBy::get_groups),
+      // aggregations
+      trace::InstanceMethod(env, "GroupBy", "_argmax", &GroupBy::argmax),
+      trace::InstanceMethod(env, "GroupBy", "_argmin", &GroupBy::argmin),
+      trace::InstanceMethod(env, "GroupBy", "_count", &GroupBy::count),
+      trace::InstanceMethod(env, "GroupBy", "_max", &GroupBy::max),
+      trace::InstanceMethod(env, "GroupBy", "_mean", &GroupBy::mean),
+      trace::InstanceMethod(env, "GroupBy", "_median", &GroupBy::median),
+      trace::InstanceMethod(env, "GroupBy", "_min", &GroupBy::min),
+      trace::InstanceMethod(env, "GroupBy", "_nth", &GroupBy::nth),
+      trace::InstanceMethod(env, "GroupBy", "_nunique", &GroupBy::nunique),
+      trace::InstanceMethod(env, "GroupBy", "_std", &GroupBy::std),
+      trace::InstanceMethod(env, "GroupBy", "_sum", &GroupBy::sum),
+      trace::InstanceMethod(env, "GroupBy", "_var", &GroupBy::var),
+      trace::InstanceMethod(env, "GroupBy", "_quantile", &GroupBy::quantile),
+    });
 
   GroupBy::constructor = Napi::Persistent(ctor);
-  GroupBy::constructor.SuppressDestruct();
   exports.Set("GroupBy", ctor);
 
   return exports;
@@ -110,8 +111,8 @@ Napi::Value GroupBy::get_groups(Napi::CallbackInfo const& info) {
   auto result = Napi::Object::New(info.Env());
   result.Set("keys", Table::New(std::move(groups.keys)));
 
-  auto const& offsets = groups.offsets;
-  result.Set("offsets", CPPToNapi(info)(std::make_tuple(offsets.data(), offsets.size())));
+  result.Set("offsets",
+             CPPToNapi(info)(ExternalArray<cudf::size_type>(std::move(groups.offsets))));
 
   if (groups.values != nullptr) { result.Set("values", Table::New(std::move(groups.values))); }
   return result;
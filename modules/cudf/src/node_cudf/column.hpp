@@ -628,7 +628,9 @@ class Column : public Napi::ObjectWrap<Column> {
     rmm::mr::device_memory_resource* mr = rmm::mr::get_current_device_resource()) const;
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   cudf::size_type size_{};                     ///< The number of elements in the column
   cudf::size_type offset_{};                   ///< The offset of elements in the data
@@ -59,7 +59,9 @@ class GroupBy : public Napi::ObjectWrap<GroupBy> {
   void Finalize(Napi::Env env) override;
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   std::unique_ptr<cudf::groupby::groupby> groupby_;
 
@@ -151,7 +151,9 @@ class Scalar : public Napi::ObjectWrap<Scalar> {
   void set_value(Napi::CallbackInfo const& info, Napi::Value const& value);
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::Reference<Napi::Object> type_{};  ///< Logical type of elements in the column
   std::unique_ptr<cudf::scalar> scalar_;
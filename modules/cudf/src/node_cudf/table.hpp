@@ -178,7 +178,9 @@ class Table : public Napi::ObjectWrap<Table> {
     rmm::mr::device_memory_resource* mr      = rmm::mr::get_current_device_resource()) const;
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   cudf::size_type num_columns_{};           ///< The number of columns in the table
   cudf::size_type num_rows_{};              ///< The number of rows
@@ -78,7 +78,7 @@ struct set_scalar_value {
 
 }  // namespace
 
-Napi::FunctionReference Scalar::constructor;
+ConstructorReference Scalar::constructor;
 
 Napi::Object Scalar::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor = DefineClass(
@@ -90,7 +90,6 @@ Napi::Object Scalar::Init(Napi::Env env, Napi::Object exports) {
     });
 
   Scalar::constructor = Napi::Persistent(ctor);
-  Scalar::constructor.SuppressDestruct();
   exports.Set("Scalar", ctor);
 
   return exports;
@@ -20,6 +20,7 @@
 #include <cudf/column/column.hpp>
 #include <cudf/sorting.hpp>
 #include <cudf/types.hpp>
+#include <nv_node/utilities/trace.hpp>
 
 #include <napi.h>
 
@@ -29,26 +30,26 @@ namespace nv {
 // Public API
 //
 
-Napi::FunctionReference Table::constructor;
+ConstructorReference Table::constructor;
 
 Napi::Object Table::Init(Napi::Env env, Napi::Object exports) {
-  Napi::Function ctor = DefineClass(env,
-                                    "Table",
-                                    {
-                                      InstanceAccessor<&Table::num_columns>("numColumns"),
-                                      InstanceAccessor<&Table::num_rows>("numRows"),
-                                      InstanceMethod<&Table::gather>("gather"),
-                                      InstanceMethod<&Table::get_column>("getColumnByIndex"),
-                                      InstanceMethod<&Table::to_arrow>("toArrow"),
-                                      InstanceMethod<&Table::order_by>("orderBy"),
-                                      StaticMethod<&Table::read_csv>("readCSV"),
-                                      InstanceMethod<&Table::write_csv>("writeCSV"),
-                                      InstanceMethod<&Table::drop_nans>("drop_nans"),
-                                      InstanceMethod<&Table::drop_nulls>("drop_nulls"),
-                                    });
+  Napi::Function ctor = DefineClass(
+    env,
+    "Table",
+    {
+      InstanceAccessor<&Table::num_columns>("numColumns"),
+      InstanceAccessor<&Table::num_rows>("numRows"),
+      trace::InstanceMethod(env, "Table", "gather", &Table::gather),
+      trace::InstanceMethod(env, "Table", "getColumnByIndex", &Table::get_column),
+      trace::InstanceMethod(env, "Table", "toArrow", &Table::to_arrow),
+      trace::InstanceMethod(env, "Table", "orderBy", &Table::order_by),
+      StaticMethod<&Table::read_csv>("readCSV"),
+      trace::InstanceMethod(env, "Table", "writeCSV", &Table::write_csv),
+      trace::InstanceMethod(env, "Table", "drop_nans", &Table::drop_nans),
+      trace::InstanceMethod(env, "Table", "drop_nulls", &Table::drop_nulls),
+    });
 
   Table::constructor = Napi::Persistent(ctor);
-  Table::constructor.SuppressDestruct();
   exports.Set("Table", ctor);
 
   return exports;
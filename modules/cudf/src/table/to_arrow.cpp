@@ -14,6 +14,7 @@
 
 #include <node_cudf/column.hpp>
 #include <node_cudf/table.hpp>
+#include <node_cudf/utilities/cpp_to_napi.hpp>
 
 #include <arrow/io/memory.h>
 #include <arrow/ipc/writer.h>
@@ -40,18 +41,15 @@ std::vector<cudf::column_metadata> gather_metadata(Napi::Array const& names) {
 }  // namespace
 
 Napi::Value Table::to_arrow(Napi::CallbackInfo const& info) {
-  auto buffer = [&]() {
-    auto table  = cudf::to_arrow(*this, gather_metadata(info[0].As<Napi::Array>()));
-    auto sink   = arrow::io::BufferOutputStream::Create().ValueOrDie();
-    auto writer = arrow::ipc::NewStreamWriter(sink.get(), table->schema()).ValueOrDie();
-    auto status = writer->WriteTable(*table);
-    if (!status.ok()) { NAPI_THROW(Napi::Error::New(info.Env(), status.message())); }
-    auto buffer = sink->Finish().ValueOrDie();
-    auto arybuf = Napi::ArrayBuffer::New(info.Env(), buffer->size());
-    memcpy(arybuf.Data(), buffer->data(), buffer->size());
-    return arybuf;
-  }();
-
-  return Napi::Uint8Array::New(info.Env(), buffer.ByteLength(), buffer, 0);
+  auto table  = cudf::to_arrow(*this, gather_metadata(info[0].As<Napi::Array>()));
+  auto sink   = arrow::io::BufferOutputStream::Create().ValueOrDie();
+  auto writer = arrow::ipc::NewStreamWriter(sink.get(), table->schema()).ValueOrDie();
+  auto status = writer->WriteTable(*table);
+  if (!status.ok()) { NAPI_THROW(Napi::Error::New(info.Env(), status.message())); }
+  std::shared_ptr<arrow::Buffer> buffer = sink->Finish().ValueOrDie();
+  // Hand the IPC buffer to JS without copying it
+  auto data = const_cast<uint8_t*>(buffer->data());
+  auto size = static_cast<size_t>(buffer->size());
+  return CPPToNapi(info)(ExternalArray<uint8_t>(std::move(buffer), data, size));
 }
 }  // namespace nv
@@ -16,6 +16,7 @@
 #include <node_cugraph/graph_coo.hpp>
 
 #include <nv_node/macros.hpp>
+#include <nv_node/utilities/lazy_class.hpp>
 
 #include <napi.h>
 
@@ -28,7 +29,8 @@ Napi::Value cugraphInit(Napi::CallbackInfo const& info) {
 
 Napi::Object initModule(Napi::Env env, Napi::Object exports) {
   EXPORT_FUNC(env, exports, "init", nv::cugraphInit);
-  nv::GraphCOO::Init(env, exports);
+  nv::DefineLazyClass<nv::GraphCOO>(env, exports, "GraphCOO");
+  nv::trace::Init(env, exports);
   return exports;
 }
 
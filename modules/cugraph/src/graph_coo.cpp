@@ -16,6 +16,7 @@
 
 #include <node_cuda/utilities/error.hpp>
 #include <node_cuda/utilities/napi_to_cpp.hpp>
+#include <nv_node/utilities/trace.hpp>
 
 #include <cudf/types.hpp>
 
@@ -23,18 +24,18 @@
 
 namespace nv {
 
-Napi::FunctionReference GraphCOO::constructor;
+ConstructorReference GraphCOO::constructor;
 
 Napi::Object GraphCOO::Init(Napi::Env env, Napi::Object exports) {
-  const Napi::Function ctor = DefineClass(env,
-                                          "GraphCOO",
-                                          {
-                                            InstanceAccessor<&GraphCOO::num_edges>("numEdges"),
-                                            InstanceAccessor<&GraphCOO::num_nodes>("numNodes"),
-                                            InstanceMethod<&GraphCOO::force_atlas2>("forceAtlas2"),
-                                          });
+  const Napi::Function ctor = DefineClass(
+    env,
+    "GraphCOO",
+    {
+      InstanceAccessor<&GraphCOO::num_edges>("numEdges"),
+      InstanceAccessor<&GraphCOO::num_nodes>("numNodes"),
+      trace::InstanceMethod(env, "GraphCOO", "forceAtlas2", &GraphCOO::force_atlas2),
+    });
   GraphCOO::constructor     = Napi::Persistent(ctor);
-  GraphCOO::constructor.SuppressDestruct();
   exports.Set("GraphCOO", ctor);
   return exports;
 }
@@ -96,7 +96,9 @@ class GraphCOO : public Napi::ObjectWrap<GraphCOO> {
   cugraph::GraphCOOView<int32_t, int32_t, float> view();
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   Napi::Value num_edges(Napi::CallbackInfo const& info);
   Napi::Value num_nodes(Napi::CallbackInfo const& info);
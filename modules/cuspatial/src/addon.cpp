@@ -39,6 +39,7 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
     env, exports, "findPolylineNearestToEachPoint", nv::find_polyline_nearest_to_each_point);
   EXPORT_FUNC(env, exports, "computePolygonBoundingBoxes", nv::compute_polygon_bounding_boxes);
   EXPORT_FUNC(env, exports, "computePolylineBoundingBoxes", nv::compute_polyline_bounding_boxes);
+  nv::trace::Init(env, exports);
   return exports;
 }
 
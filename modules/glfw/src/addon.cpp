@@ -571,6 +571,7 @@ Napi::Object initModule(Napi::Env env, Napi::Object exports) {
 
   EXPORT_ENUM(env, exports, "DONT_CARE", GLFW_DONT_CARE);
 
+  nv::trace::Init(env, exports);
   return exports;
 }
 
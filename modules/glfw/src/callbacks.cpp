@@ -17,6 +17,7 @@
 
 #include <nv_node/utilities/args.hpp>
 #include <nv_node/utilities/cpp_to_napi.hpp>
+#include <nv_node/utilities/env_local.hpp>
 
 namespace nv {
 
@@ -27,45 +28,44 @@ struct js_callback;
 
 template <typename R, typename... Args>
 struct js_callback<R (*)(Args...)> {
-  Napi::FunctionReference cb{};
-  auto Env() { return cb.Env(); }
-  void Reset() { cb.Reset(); }
-  void Reset(const Napi::Function& value) {
-    cb = Napi::Persistent(value);
-    cb.SuppressDestruct();
-  }
+  // GLFW invokes callbacks on the thread that called glfwPollEvents, so each env (main thread or
+  // worker_thread) only ever sees the callback it registered itself.
+  EnvLocal<Napi::FunctionReference> cb{};
+  void Reset(Napi::Env const& env) { cb.get(env).Reset(); }
+  void Reset(const Napi::Function& value) { cb.get(value.Env()) = Napi::Persistent(value); }
   R operator()(Args const&... args) {
-    if (!cb.IsEmpty()) {
-      Napi::Env env = Env();
+    auto fn = cb.get();
+    if (fn != nullptr && !fn->IsEmpty()) {
+      Napi::Env env = fn->Env();
       auto cast_t   = CPPToNapi(env);
       std::vector<napi_value> xs{};
       std::tuple<Args...> ys{args...};
       casting::for_each(ys, [&](auto v) { xs.push_back(cast_t(v)); });
-      cb.MakeCallback(env.Global(), xs);
+      fn->MakeCallback(env.Global(), xs);
     }
   }
 };
 }  // namespace
 
-auto GLFWerror_cb_js              = js_callback<void (*)(int, std::string)>{};  // GLFWerrorfun
-auto GLFWmonitor_cb_js            = js_callback<GLFWmonitorfun>{};
-auto GLFWjoystick_cb_js           = js_callback<GLFWjoystickfun>{};
-auto GLFWwindowpos_cb_js          = js_callback<GLFWwindowposfun>{};
-auto GLFWwindowsize_cb_js         = js_callback<GLFWwindowsizefun>{};
-auto GLFWwindowclose_cb_js        = js_callback<GLFWwindowclosefun>{};
-auto GLFWwindowrefresh_cb_js      = js_callback<GLFWwindowrefreshfun>{};
-auto GLFWwindowfocus_cb_js        = js_callback<GLFWwindowfocusfun>{};
-auto GLFWwindowiconify_cb_js      = js_callback<GLFWwindowiconifyfun>{};
-auto GLFWwindowmaximize_cb_js     = js_callback<GLFWwindowmaximizefun>{};
-auto GLFWframebuffersize_cb_js    = js_callback<GLFWframebuffersizefun>{};
-auto GLFWwindowcontentscale_cb_js = js_callback<GLFWwindowcontentscalefun>{};
-auto GLFWkey_cb_js                = js_callback<GLFWkeyfun>{};
-auto GLFWchar_cb_js               = js_callback<GLFWcharfun>{};
-auto GLFWcharmods_cb_js           = js_callback<GLFWcharmodsfun>{};
-auto GLFWmousebutton_cb_js        = js_callback<GLFWmousebuttonfun>{};
-auto GLFWcursorpos_cb_js          = js_callback<GLFWcursorposfun>{};
-auto GLFWcursorenter_cb_js        = js_callback<GLFWcursorenterfun>{};
-auto GLFWscroll_cb_js             = js_callback<GLFWscrollfun>{};
+js_callback<void (*)(int, std::string)> GLFWerror_cb_js;  // GLFWerrorfun
+js_callback<GLFWmonitorfun> GLFWmonitor_cb_js;
+js_callback<GLFWjoystickfun> GLFWjoystick_cb_js;
+js_callback<GLFWwindowposfun> GLFWwindowpos_cb_js;
+js_callback<GLFWwindowsizefun> GLFWwindowsize_cb_js;
+js_callback<GLFWwindowclosefun> GLFWwindowclose_cb_js;
+js_callback<GLFWwindowrefreshfun> GLFWwindowrefresh_cb_js;
+js_callback<GLFWwindowfocusfun> GLFWwindowfocus_cb_js;
+js_callback<GLFWwindowiconifyfun> GLFWwindowiconify_cb_js;
+js_callback<GLFWwindowmaximizefun> GLFWwindowmaximize_cb_js;
+js_callback<GLFWframebuffersizefun> GLFWframebuffersize_cb_js;
+js_callback<GLFWwindowcontentscalefun> GLFWwindowcontentscale_cb_js;
+js_callback<GLFWkeyfun> GLFWkey_cb_js;
+js_callback<GLFWcharfun> GLFWchar_cb_js;
+js_callback<GLFWcharmodsfun> GLFWcharmods_cb_js;
+js_callback<GLFWmousebuttonfun> GLFWmousebutton_cb_js;
+js_callback<GLFWcursorposfun> GLFWcursorpos_cb_js;
+js_callback<GLFWcursorenterfun> GLFWcursorenter_cb_js;
+js_callback<GLFWscrollfun> GLFWscroll_cb_js;
 
 void GLFWerror_cb(int32_t error_code, const char* description) {
   GLFWerror_cb_js(error_code, std::string{description == nullptr ? description : ""});
@@ -111,19 +111,21 @@ void GLFWcursorenter_cb(GLFWwindow* window, int32_t entered) {
 }
 void GLFWscroll_cb(GLFWwindow* window, double x, double y) { GLFWscroll_cb_js(window, x, y); }
 
-Napi::FunctionReference GLFWdrop_cb_js;
+EnvLocal<Napi::FunctionReference> GLFWdrop_cb_js;
 void GLFWdrop_cb(GLFWwindow* window, int count, const char** paths) {
-  auto env    = GLFWdrop_cb_js.Env();
-  auto cast_t = CPPToNapi(env);
-  GLFWdrop_cb_js.MakeCallback(env.Global(),
-                              {cast_t(std::vector<std::string>{paths, paths + count})});
+  auto fn = GLFWdrop_cb_js.get();
+  if (fn != nullptr && !fn->IsEmpty()) {
+    auto env    = fn->Env();
+    auto cast_t = CPPToNapi(env);
+    fn->MakeCallback(env.Global(), {cast_t(std::vector<std::string>{paths, paths + count})});
+  }
 }
 
 // GLFWAPI GLFWerrorfun glfwSetErrorCallback(GLFWerrorfun callback);
 Napi::Value glfwSetErrorCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   if (info[0].IsNull() || info[0].IsEmpty()) {
-    GLFWerror_cb_js.Reset();
+    GLFWerror_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetErrorCallback(NULL));
   } else {
     GLFWerror_cb_js.Reset(info[0].As<Napi::Function>());
@@ -136,7 +138,7 @@ Napi::Value glfwSetErrorCallback(Napi::CallbackInfo const& info) {
 Napi::Value glfwSetMonitorCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   if (info[0].IsNull() || info[0].IsEmpty()) {
-    GLFWmonitor_cb_js.Reset();
+    GLFWmonitor_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetMonitorCallback(NULL));
   } else {
     GLFWmonitor_cb_js.Reset(info[0].As<Napi::Function>());
@@ -149,7 +151,7 @@ Napi::Value glfwSetMonitorCallback(Napi::CallbackInfo const& info) {
 Napi::Value glfwSetJoystickCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   if (info[0].IsNull() || info[0].IsEmpty()) {
-    GLFWjoystick_cb_js.Reset();
+    GLFWjoystick_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetJoystickCallback(NULL));
   } else {
     GLFWjoystick_cb_js.Reset(info[0].As<Napi::Function>());
@@ -163,7 +165,7 @@ Napi::Value glfwSetWindowPosCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWwindowpos_cb_js.Reset();
+    GLFWwindowpos_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetWindowPosCallback(args[0], NULL));
   } else {
     GLFWwindowpos_cb_js.Reset(info[1].As<Napi::Function>());
@@ -178,7 +180,7 @@ Napi::Value glfwSetWindowSizeCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWwindowsize_cb_js.Reset();
+    GLFWwindowsize_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetWindowSizeCallback(args[0], NULL));
   } else {
     GLFWwindowsize_cb_js.Reset(info[1].As<Napi::Function>());
@@ -193,7 +195,7 @@ Napi::Value glfwSetWindowCloseCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWwindowclose_cb_js.Reset();
+    GLFWwindowclose_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetWindowCloseCallback(args[0], NULL));
   } else {
     GLFWwindowclose_cb_js.Reset(info[1].As<Napi::Function>());
@@ -208,7 +210,7 @@ Napi::Value glfwSetWindowRefreshCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWwindowrefresh_cb_js.Reset();
+    GLFWwindowrefresh_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetWindowRefreshCallback(args[0], NULL));
   } else {
     GLFWwindowrefresh_cb_js.Reset(info[1].As<Napi::Function>());
@@ -223,7 +225,7 @@ Napi::Value glfwSetWindowFocusCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWwindowfocus_cb_js.Reset();
+    GLFWwindowfocus_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetWindowFocusCallback(args[0], NULL));
   } else {
     GLFWwindowfocus_cb_js.Reset(info[1].As<Napi::Function>());
@@ -238,7 +240,7 @@ Napi::Value glfwSetWindowIconifyCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWwindowiconify_cb_js.Reset();
+    GLFWwindowiconify_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetWindowIconifyCallback(args[0], NULL));
   } else {
     GLFWwindowiconify_cb_js.Reset(info[1].As<Napi::Function>());
@@ -253,7 +255,7 @@ Napi::Value glfwSetWindowMaximizeCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWwindowmaximize_cb_js.Reset();
+    GLFWwindowmaximize_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetWindowMaximizeCallback(args[0], NULL));
   } else {
     GLFWwindowmaximize_cb_js.Reset(info[1].As<Napi::Function>());
@@ -268,7 +270,7 @@ Napi::Value glfwSetFramebufferSizeCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWframebuffersize_cb_js.Reset();
+    GLFWframebuffersize_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetFramebufferSizeCallback(args[0], NULL));
   } else {
     GLFWframebuffersize_cb_js.Reset(info[1].As<Napi::Function>());
@@ -283,7 +285,7 @@ Napi::Value glfwSetWindowContentScaleCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWwindowcontentscale_cb_js.Reset();
+    GLFWwindowcontentscale_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetWindowContentScaleCallback(args[0], NULL));
   } else {
     GLFWwindowcontentscale_cb_js.Reset(info[1].As<Napi::Function>());
@@ -297,7 +299,7 @@ Napi::Value glfwSetKeyCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWkey_cb_js.Reset();
+    GLFWkey_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetKeyCallback(args[0], NULL));
   } else {
     GLFWkey_cb_js.Reset(info[1].As<Napi::Function>());
@@ -311,7 +313,7 @@ Napi::Value glfwSetCharCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWchar_cb_js.Reset();
+    GLFWchar_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetCharCallback(args[0], NULL));
   } else {
     GLFWchar_cb_js.Reset(info[1].As<Napi::Function>());
@@ -325,7 +327,7 @@ Napi::Value glfwSetCharModsCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWcharmods_cb_js.Reset();
+    GLFWcharmods_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetCharModsCallback(args[0], NULL));
   } else {
     GLFWcharmods_cb_js.Reset(info[1].As<Napi::Function>());
@@ -340,7 +342,7 @@ Napi::Value glfwSetMouseButtonCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWmousebutton_cb_js.Reset();
+    GLFWmousebutton_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetMouseButtonCallback(args[0], NULL));
   } else {
     GLFWmousebutton_cb_js.Reset(info[1].As<Napi::Function>());
@@ -353,7 +355,7 @@ Napi::Value glfwSetCursorPosCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWcursorpos_cb_js.Reset();
+    GLFWcursorpos_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetCursorPosCallback(args[0], NULL));
   } else {
     GLFWcursorpos_cb_js.Reset(info[1].As<Napi::Function>());
@@ -368,7 +370,7 @@ Napi::Value glfwSetCursorEnterCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWcursorenter_cb_js.Reset();
+    GLFWcursorenter_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetCursorEnterCallback(args[0], NULL));
   } else {
     GLFWcursorenter_cb_js.Reset(info[1].As<Napi::Function>());
@@ -382,7 +384,7 @@ Napi::Value glfwSetScrollCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWscroll_cb_js.Reset();
+    GLFWscroll_cb_js.Reset(env);
     GLFW_TRY(env, GLFWAPI::glfwSetScrollCallback(args[0], NULL));
   } else {
     GLFWscroll_cb_js.Reset(info[1].As<Napi::Function>());
@@ -396,11 +398,10 @@ Napi::Value glfwSetDropCallback(Napi::CallbackInfo const& info) {
   auto env = info.Env();
   CallbackArgs args{info};
   if (info[1].IsNull() || info[1].IsEmpty() || info[1].IsUndefined()) {
-    GLFWdrop_cb_js.Reset();
+    GLFWdrop_cb_js.get(env).Reset();
     GLFW_TRY(env, GLFWAPI::glfwSetDropCallback(args[0], NULL));
   } else {
-    GLFWdrop_cb_js = Napi::Persistent(info[1].As<Napi::Function>());
-    GLFWdrop_cb_js.SuppressDestruct();
+    GLFWdrop_cb_js.get(env) = Napi::Persistent(info[1].As<Napi::Function>());
     GLFW_TRY(env, GLFWAPI::glfwSetDropCallback(args[0], GLFWdrop_cb));
   }
   return env.Undefined();
@@ -17,6 +17,8 @@
 #include "errors.hpp"
 #include "glfw.hpp"
 
+#include <nv_node/utilities/trace.hpp>
+
 #define EXPORT_PROP(exports, name, val) exports.Set(name, val);
 
 #define EXPORT_ENUM(env, exports, name, val) \
@@ -27,7 +29,7 @@
     env,                                                                                        \
     exports,                                                                                    \
     Napi::String::New(env, name),                                                               \
-    func,                                                                                       \
+    nv::trace::Wrap(name, func),                                                                \
     static_cast<napi_property_attributes>(napi_writable | napi_enumerable | napi_configurable), \
     nullptr));
 
@@ -17,6 +17,7 @@
 #include "node_rmm/memory_resource.hpp"
 
 #include <nv_node/macros.hpp>
+#include <nv_node/utilities/lazy_class.hpp>
 
 namespace nv {
 Napi::Value rmmInit(Napi::CallbackInfo const& info) {
@@ -34,8 +35,9 @@ Napi::Value set_per_device_resource(CallbackArgs const& args) {
 Napi::Object initModule(Napi::Env env, Napi::Object exports) {
   EXPORT_FUNC(env, exports, "init", nv::rmmInit);
   EXPORT_FUNC(env, exports, "setPerDeviceResource", nv::set_per_device_resource);
-  nv::MemoryResource::Init(env, exports);
-  nv::DeviceBuffer::Init(env, exports);
+  nv::DefineLazyClass<nv::MemoryResource>(env, exports, "MemoryResource");
+  nv::DefineLazyClass<nv::DeviceBuffer>(env, exports, "DeviceBuffer");
+  nv::trace::Init(env, exports);
   return exports;
 }
 
@@ -18,6 +18,7 @@
 #include "node_rmm/utilities/napi_to_cpp.hpp"
 
 #include <node_cuda/utilities/error.hpp>
+#include <nv_node/utilities/trace.hpp>
 
 namespace nv {
 
@@ -25,23 +26,22 @@ ConstructorReference DeviceBuffer::constructor;
 
 Napi::Object DeviceBuffer::Init(Napi::Env env, Napi::Object exports) {
   exports.Set("DeviceBuffer", [&]() {
-    (DeviceBuffer::constructor =
-       Napi::Persistent(DefineClass(env,
-                                    "DeviceBuffer",
-                                    {
-                                      InstanceAccessor<&DeviceBuffer::capacity>("capacity"),
-                                      InstanceAccessor<&DeviceBuffer::byte_length>("byteLength"),
-                                      InstanceAccessor<&DeviceBuffer::is_empty>("isEmpty"),
-                                      InstanceAccessor<&DeviceBuffer::ptr>("ptr"),
-                                      InstanceAccessor<&DeviceBuffer::device>("device"),
-                                      InstanceAccessor<&DeviceBuffer::stream>("stream"),
-                                      InstanceAccessor<&DeviceBuffer::get_mr>("memoryResource"),
-                                      InstanceMethod<&DeviceBuffer::resize>("resize"),
-                                      InstanceMethod<&DeviceBuffer::set_stream>("setStream"),
-                                      InstanceMethod<&DeviceBuffer::shrink_to_fit>("shrinkToFit"),
-                                      InstanceMethod<&DeviceBuffer::slice>("slice"),
-                                    })))
-      .SuppressDestruct();
+    DeviceBuffer::constructor = Napi::Persistent(DefineClass(
+      env,
+      "DeviceBuffer",
+      {
+        InstanceAccessor<&DeviceBuffer::capacity>("capacity"),
+        InstanceAccessor<&DeviceBuffer::byte_length>("byteLength"),
+        InstanceAccessor<&DeviceBuffer::is_empty>("isEmpty"),
+        InstanceAccessor<&DeviceBuffer::ptr>("ptr"),
+        InstanceAccessor<&DeviceBuffer::device>("device"),
+        InstanceAccessor<&DeviceBuffer::stream>("stream"),
+        InstanceAccessor<&DeviceBuffer::get_mr>("memoryResource"),
+        trace::InstanceMethod(env, "DeviceBuffer", "resize", &DeviceBuffer::resize),
+        trace::InstanceMethod(env, "DeviceBuffer", "setStream", &DeviceBuffer::set_stream),
+        trace::InstanceMethod(env, "DeviceBuffer", "shrinkToFit", &DeviceBuffer::shrink_to_fit),
+        trace::InstanceMethod(env, "DeviceBuffer", "slice", &DeviceBuffer::slice),
+      }));
     return DeviceBuffer::constructor.Value();
   }());
   return exports;
@@ -15,6 +15,8 @@
 #include "node_rmm/memory_resource.hpp"
 #include "node_rmm/utilities/napi_to_cpp.hpp"
 
+#include <nv_node/utilities/trace.hpp>
+
 #include <thrust/optional.h>
 
 namespace nv {
@@ -23,21 +25,23 @@ ConstructorReference MemoryResource::constructor;
 
 Napi::Object MemoryResource::Init(Napi::Env env, Napi::Object exports) {
   exports.Set("MemoryResource", [&]() {
-    (MemoryResource::constructor = Napi::Persistent(
-       DefineClass(env,
-                   "MemoryResource",
-                   {
-                     InstanceAccessor<&MemoryResource::get_device>("device"),
-                     InstanceAccessor<&MemoryResource::supports_streams>("supportsStreams"),
-                     InstanceAccessor<&MemoryResource::supports_get_mem_info>("supportsGetMemInfo"),
-                     InstanceMethod<&MemoryResource::is_equal>("isEqual"),
-                     InstanceMethod<&MemoryResource::get_mem_info>("getMemInfo"),
-                     InstanceMethod<&MemoryResource::add_bin>("addBin"),
-                     InstanceMethod<&MemoryResource::flush>("flush"),
-                     InstanceAccessor<&MemoryResource::get_file_path>("logFilePath"),
-                     InstanceAccessor<&MemoryResource::get_upstream_mr>("memoryResource"),
-                   })))
-      .SuppressDestruct();
+    MemoryResource::constructor = Napi::Persistent(
+      DefineClass(env,
+                  "MemoryResource",
+                  {
+                    InstanceAccessor<&MemoryResource::get_device>("device"),
+                    InstanceAccessor<&MemoryResource::supports_streams>("supportsStreams"),
+                    InstanceAccessor<&MemoryResource::supports_get_mem_info>("supportsGetMemInfo"),
+                    trace::InstanceMethod(
+                      env, "MemoryResource", "isEqual", &MemoryResource::is_equal),
+                    trace::InstanceMethod(
+                      env, "MemoryResource", "getMemInfo", &MemoryResource::get_mem_info),
+                    trace::InstanceMethod(
+                      env, "MemoryResource", "addBin", &MemoryResource::add_bin),
+                    trace::InstanceMethod(env, "MemoryResource", "flush", &MemoryResource::flush),
+                    InstanceAccessor<&MemoryResource::get_file_path>("logFilePath"),
+                    InstanceAccessor<&MemoryResource::get_upstream_mr>("memoryResource"),
+                  }));
     return MemoryResource::constructor.Value();
   }());
 
@@ -158,6 +158,8 @@ struct DeviceBuffer : public Napi::ObjectWrap<DeviceBuffer> {
   inline operator Napi::Value() const { return Value(); }
 
  private:
+  template <typename>
+  friend struct LazyClass;
   static ConstructorReference constructor;
 
   rmm::device_buffer& buffer() const { return *buffer_; }
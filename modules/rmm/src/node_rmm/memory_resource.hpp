@@ -151,6 +151,8 @@ struct MemoryResource : public Napi::ObjectWrap<MemoryResource> {
   void add_bin(size_t allocation_size, ObjectUnwrap<MemoryResource> const& bin_resource);
 
  private:
+  template <typename>
+  friend struct LazyClass;
   static ConstructorReference constructor;
 
   inline rmm::mr::binning_memory_resource<rmm::mr::device_memory_resource>* get_bin_mr() {
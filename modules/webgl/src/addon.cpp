@@ -12,32 +12,44 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include "headless.hpp"
 #include "webgl.hpp"
 
+#include <nv_node/async/scheduler.hpp>
+#include <nv_node/utilities/lazy_class.hpp>
 #include <nv_node/utilities/napi_to_cpp.hpp>
+#include <nv_node/utilities/trace.hpp>
 
 std::ostream& operator<<(std::ostream& os, const nv::NapiToCPP& self) {
   return os << self.operator std::string();
 };
 
 Napi::Object initModule(Napi::Env env, Napi::Object exports) {
-  nv::WebGL2RenderingContext::Init(env, exports);
-  nv::WebGLActiveInfo::Init(env, exports);
-  nv::WebGLShaderPrecisionFormat::Init(env, exports);
-  nv::WebGLBuffer::Init(env, exports);
-  nv::WebGLContextEvent::Init(env, exports);
-  nv::WebGLFramebuffer::Init(env, exports);
-  nv::WebGLProgram::Init(env, exports);
-  nv::WebGLQuery::Init(env, exports);
-  nv::WebGLRenderbuffer::Init(env, exports);
-  nv::WebGLSampler::Init(env, exports);
-  nv::WebGLShader::Init(env, exports);
-  nv::WebGLSync::Init(env, exports);
-  nv::WebGLTexture::Init(env, exports);
-  nv::WebGLTransformFeedback::Init(env, exports);
-  nv::WebGLUniformLocation::Init(env, exports);
-  nv::WebGLVertexArrayObject::Init(env, exports);
+  nv::DefineLazyClass<nv::WebGL2RenderingContext>(env, exports, "WebGL2RenderingContext");
+  nv::DefineLazyClass<nv::WebGLActiveInfo>(env, exports, "WebGLActiveInfo");
+  nv::DefineLazyClass<nv::WebGLShaderPrecisionFormat>(env, exports, "WebGLShaderPrecisionFormat");
+  nv::DefineLazyClass<nv::WebGLBuffer>(env, exports, "WebGLBuffer");
+  nv::DefineLazyClass<nv::WebGLContextEvent>(env, exports, "WebGLContextEvent");
+  nv::DefineLazyClass<nv::WebGLFramebuffer>(env, exports, "WebGLFramebuffer");
+  nv::DefineLazyClass<nv::WebGLProgram>(env, exports, "WebGLProgram");
+  nv::DefineLazyClass<nv::WebGLQuery>(env, exports, "WebGLQuery");
+  nv::DefineLazyClass<nv::WebGLRenderbuffer>(env, exports, "WebGLRenderbuffer");
+  nv::DefineLazyClass<nv::WebGLSampler>(env, exports, "WebGLSampler");
+  nv::DefineLazyClass<nv::WebGLShader>(env, exports, "WebGLShader");
+  nv::DefineLazyClass<nv::WebGLSync>(env, exports, "WebGLSync");
+  nv::DefineLazyClass<nv::WebGLTexture>(env, exports, "WebGLTexture");
+  nv::DefineLazyClass<nv::WebGLTransformFeedback>(env, exports, "WebGLTransformFeedback");
+  nv::DefineLazyClass<nv::WebGLUniformLocation>(env, exports, "WebGLUniformLocation");
+  nv::DefineLazyClass<nv::WebGLVertexArrayObject>(env, exports, "WebGLVertexArrayObject");
+  nv::DefineLazyClass<nv::StreamingBuffer>(env, exports, "StreamingBuffer");
+  nv::DefineLazyClass<nv::FrameProfiler>(env, exports, "FrameProfiler");
+  nv::DefineLazyClass<nv::FrameCapture>(env, exports, "FrameCapture");
+  nv::DefineLazyClass<nv::HeadlessContext>(env, exports, "HeadlessContext");
 
+  nv::WebGL2RenderingContext::commands.Export(env, exports, "commands");
+
+  nv::trace::Init(env, exports);
+  nv::Scheduler::Init(env, exports);
   return exports;
 }
 
@@ -23,8 +23,11 @@ namespace nv {
 // GLEWAPI void glBindAttribLocation (GLuint program, GLuint index, const GLchar* name);
 Napi::Value WebGL2RenderingContext::BindAttribLocation(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
+  GLuint program    = args[0];
+  GLuint index      = args[1];
   std::string name  = args[2];
-  GL_EXPORT::glBindAttribLocation(args[0], args[1], name.data());
+  GL_EXPORT::glBindAttribLocation(program, index, name.data());
+  if (program_cache_) { link_inputs_[program].attribs[name] = index; }
   return info.Env().Undefined();
 }
 
@@ -44,7 +44,9 @@ Napi::Value WebGL2RenderingContext::BlendEquationSeparate(Napi::CallbackInfo con
 // GL_EXPORT void glBlendFunc (GLenum sfactor, GLenum dfactor);
 Napi::Value WebGL2RenderingContext::BlendFunc(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glBlendFunc(args[0], args[1]);
+  GLenum src        = args[0];
+  GLenum dst        = args[1];
+  state_->SetBlendFunc(src, dst, src, dst, [&] { GL_EXPORT::glBlendFunc(src, dst); });
   return info.Env().Undefined();
 }
 
@@ -52,7 +54,13 @@ Napi::Value WebGL2RenderingContext::BlendFunc(Napi::CallbackInfo const& info) {
 // GLenum dfactorAlpha);
 Napi::Value WebGL2RenderingContext::BlendFuncSeparate(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glBlendFuncSeparate(args[0], args[1], args[2], args[3]);
+  GLenum src_rgb    = args[0];
+  GLenum dst_rgb    = args[1];
+  GLenum src_alpha  = args[2];
+  GLenum dst_alpha  = args[3];
+  state_->SetBlendFunc(src_rgb, dst_rgb, src_alpha, dst_alpha, [&] {
+    GL_EXPORT::glBlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+  });
   return info.Env().Undefined();
 }
 
@@ -23,7 +23,9 @@ namespace nv {
 // GL_EXPORT void glBindBuffer (GLenum target, GLuint buffer);
 Napi::Value WebGL2RenderingContext::BindBuffer(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glBindBuffer(args[0], args[1]);
+  GLenum target     = args[0];
+  GLuint buffer     = args[1];
+  state_->SetBuffer(target, buffer, [&] { GL_EXPORT::glBindBuffer(target, buffer); });
   return info.Env().Undefined();
 }
 
@@ -53,19 +55,17 @@ Napi::Value WebGL2RenderingContext::BufferSubData(Napi::CallbackInfo const& info
 }
 
 // GL_EXPORT void glCreateBuffers (GLsizei n, GLuint* buffers);
+// Names come from a pool filled in batches, and wrappers from recycled buffers when there are any
 Napi::Value WebGL2RenderingContext::CreateBuffer(Napi::CallbackInfo const& info) {
-  CallbackArgs args = info;
-  GLuint buffer{};
-  GL_EXPORT::glCreateBuffers(1, &buffer);
-  return WebGLBuffer::New(buffer);
+  return buffer_wrappers_.Wrap(buffer_names_.Take());
 }
 
 // GL_EXPORT void glCreateBuffers (GLsizei n, GLuint* buffers);
+// Returns the names, without wrappers
 Napi::Value WebGL2RenderingContext::CreateBuffers(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  std::vector<GLuint> buffers(args[0].operator size_t());
-  GL_EXPORT::glCreateBuffers(buffers.size(), buffers.data());
-  return CPPToNapi(info)(buffers);
+  auto buffers      = buffer_names_.Take(args[0].operator size_t());
+  return CPPToNapi(info)(ExternalArray<GLuint>(std::move(buffers)));
 }
 
 // GL_EXPORT void glDeleteBuffers (GLsizei n, const GLuint* buffers);
@@ -73,14 +73,33 @@ Napi::Value WebGL2RenderingContext::DeleteBuffer(Napi::CallbackInfo const& info)
   CallbackArgs args   = info;
   const GLuint buffer = args[0];
   GL_EXPORT::glDeleteBuffers(1, &buffer);
+  state_->DeletedBuffer(buffer);
   return info.Env().Undefined();
 }
 
 // GL_EXPORT void glDeleteBuffers (GLsizei n, const GLuint* buffers);
+// Takes names or WebGLBuffers
 Napi::Value WebGL2RenderingContext::DeleteBuffers(Napi::CallbackInfo const& info) {
   CallbackArgs args           = info;
   std::vector<GLuint> buffers = args[0];
   GL_EXPORT::glDeleteBuffers(buffers.size(), buffers.data());
+  for (auto buffer : buffers) { state_->DeletedBuffer(buffer); }
+  return info.Env().Undefined();
+}
+
+// GL_EXPORT void glDeleteBuffers (GLsizei n, const GLuint* buffers);
+// Deletes the buffer, and keeps its WebGLBuffer for createBuffer() to hand out again
+Napi::Value WebGL2RenderingContext::RecycleBuffer(Napi::CallbackInfo const& info) {
+  if (!WebGLBuffer::IsInstance(info[0])) {
+    NAPI_THROW(Napi::TypeError::New(info.Env(), "Expected a WebGLBuffer"));
+  }
+  auto wrapper  = info[0].As<Napi::Object>();
+  GLuint buffer = *WebGLBuffer::Unwrap(wrapper);
+  // Already deleted or recycled
+  if (buffer == 0) { return info.Env().Undefined(); }
+  GL_EXPORT::glDeleteBuffers(1, &buffer);
+  state_->DeletedBuffer(buffer);
+  buffer_wrappers_.Recycle(wrapper);
   return info.Env().Undefined();
 }
 
@@ -102,6 +121,7 @@ Napi::Value WebGL2RenderingContext::IsBuffer(Napi::CallbackInfo const& info) {
 Napi::Value WebGL2RenderingContext::BindBufferBase(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
   GL_EXPORT::glBindBufferBase(args[0], args[1], args[2]);
+  state_->ForgetBuffer(args[0]);
   return info.Env().Undefined();
 }
 
@@ -110,6 +130,7 @@ Napi::Value WebGL2RenderingContext::BindBufferBase(Napi::CallbackInfo const& inf
 Napi::Value WebGL2RenderingContext::BindBufferRange(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
   GL_EXPORT::glBindBufferRange(args[0], args[1], args[2], args[3], args[4]);
+  state_->ForgetBuffer(args[0]);
   return info.Env().Undefined();
 }
 
@@ -0,0 +1,244 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "i420.hpp"
+#include "macros.hpp"
+#include "webgl.hpp"
+
+#include <nv_node/async/scheduler.hpp>
+#include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/cpp_to_napi.hpp>
+#include <nv_node/utilities/trace.hpp>
+
+#include <memory>
+
+namespace nv {
+
+namespace {
+
+constexpr GLbitfield map_flags = GL_MAP_READ_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+// An ArrayBuffer that owns `size` bytes allocated with new[]
+inline Napi::ArrayBuffer owned_array_buffer(Napi::Env env, uint8_t* data, size_t size) {
+  return Napi::ArrayBuffer::New(
+    env, data, size, [](Napi::Env, void* data) { delete[] static_cast<uint8_t*>(data); });
+}
+
+}  // namespace
+
+ConstructorReference FrameCapture::constructor;
+
+FrameCapture::FrameCapture(Napi::CallbackInfo const& info) : Napi::ObjectWrap<FrameCapture>(info) {
+  CallbackArgs args = info;
+  if (!info[0].IsObject()) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  // Throws unless it's a context
+  gl_context_    = WebGL2RenderingContext::Unwrap(info[0].As<Napi::Object>())->gl_context();
+  width_         = args[1];
+  height_        = args[2];
+  uint32_t slots = info[3].IsNumber() ? args[3].operator uint32_t() : 3;
+  // I420 subsamples 2x2 blocks
+  if (width_ <= 0 || height_ <= 0 || width_ % 2 != 0 || height_ % 2 != 0 || slots == 0) {
+    GLEW_THROW(info.Env(), GL_INVALID_VALUE);
+  }
+
+  auto size = static_cast<GLsizeiptr>(width_) * height_ * 4;
+  slots_.resize(slots);
+  for (auto& slot : slots_) {
+    GL_EXPORT::glCreateBuffers(1, &slot.buffer);
+    GL_EXPORT::glNamedBufferStorage(slot.buffer, size, nullptr, map_flags);
+    slot.pixels = GL_EXPORT::glMapNamedBufferRange(slot.buffer, 0, size, map_flags);
+    if (slot.pixels == nullptr) {
+      auto code = GL_EXPORT::glGetError();
+      destroyed_ = true;
+      release();
+      GLEW_THROW(info.Env(), code);
+    }
+  }
+};
+
+// A conversion in flight holds a reference, so this only runs with one if the env is torn down.
+// Its slot is leaked then, since a pool thread may still be reading the mapped buffer.
+FrameCapture::~FrameCapture() {
+  destroyed_ = true;
+  release();
+}
+
+Napi::Object FrameCapture::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function ctor = DefineClass(
+    env,
+    "FrameCapture",
+    {
+      StaticMethod("rgbaToI420", &FrameCapture::RGBAToI420),
+      InstanceAccessor("width", &FrameCapture::GetWidth, nullptr, napi_enumerable),
+      InstanceAccessor("height", &FrameCapture::GetHeight, nullptr, napi_enumerable),
+      InstanceAccessor("slots", &FrameCapture::GetSlots, nullptr, napi_enumerable),
+      trace::InstanceMethod(env, "FrameCapture", "capture", &FrameCapture::Capture),
+      trace::InstanceMethod(env, "FrameCapture", "poll", &FrameCapture::Poll),
+      trace::InstanceMethod(env, "FrameCapture", "convert", &FrameCapture::Convert),
+      trace::InstanceMethod(env, "FrameCapture", "destroy", &FrameCapture::Destroy),
+    });
+  FrameCapture::constructor = Napi::Persistent(ctor);
+  exports.Set("FrameCapture", ctor);
+  return exports;
+};
+
+// FrameCapture.rgbaToI420(rgba: Uint8Array, width, height, flipY = false): Uint8Array
+// The conversion capture frames go through, on the calling thread.
+Napi::Value FrameCapture::RGBAToI420(Napi::CallbackInfo const& info) {
+  CallbackArgs args  = info;
+  Span<uint8_t> rgba = args[0];
+  int32_t width      = args[1];
+  int32_t height     = args[2];
+  bool flip_y        = info[3].ToBoolean().Value();
+  if (width <= 0 || height <= 0 || width % 2 != 0 || height % 2 != 0 ||
+      rgba.size() < static_cast<size_t>(width) * height * 4) {
+    GLEW_THROW(info.Env(), GL_INVALID_VALUE);
+  }
+  auto size  = i420_size(width, height);
+  auto frame = new uint8_t[size];
+  rgba_to_i420(rgba.data(), width, height, flip_y, frame);
+  return Napi::Uint8Array::New(info.Env(), size, owned_array_buffer(info.Env(), frame, size), 0);
+}
+
+// capture(framebuffer = null, x = 0, y = 0): Start reading `framebuffer` into a free slot, and
+// fence the read. Returns the slot to poll() and convert(), or -1 if every slot is busy.
+Napi::Value FrameCapture::Capture(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  if (destroyed_) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  GLuint framebuffer = info[0].IsUndefined() || info[0].IsNull() ? 0 : args[0].operator GLuint();
+  GLint x            = info[1].IsNumber() ? args[1].operator int32_t() : 0;
+  GLint y            = info[2].IsNumber() ? args[2].operator int32_t() : 0;
+
+  int32_t index{0};
+  while (index < static_cast<int32_t>(slots_.size()) && slots_[index].state != Slot::State::free) {
+    ++index;
+  }
+  if (index == static_cast<int32_t>(slots_.size())) { return CPPToNapi(info)(-1); }
+  auto& slot = slots_[index];
+
+  // Leave the bindings (and the state cache's idea of them) as we found them
+  GLint read_framebuffer{}, pack_buffer{}, pack_alignment{};
+  GL_EXPORT::glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &read_framebuffer);
+  GL_EXPORT::glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &pack_buffer);
+  GL_EXPORT::glGetIntegerv(GL_PACK_ALIGNMENT, &pack_alignment);
+  GL_EXPORT::glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+  GL_EXPORT::glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  GL_EXPORT::glPixelStorei(GL_PACK_ALIGNMENT, 4);
+  GL_EXPORT::glReadPixels(x, y, width_, height_, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+  GL_EXPORT::glPixelStorei(GL_PACK_ALIGNMENT, pack_alignment);
+  GL_EXPORT::glBindBuffer(GL_PIXEL_PACK_BUFFER, pack_buffer);
+  GL_EXPORT::glBindFramebuffer(GL_READ_FRAMEBUFFER, read_framebuffer);
+
+  slot.fence = GL_EXPORT::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot.state = Slot::State::reading;
+  return CPPToNapi(info)(index);
+}
+
+// Whether the read into `slot` is done. Never waits. Called from a timer, so it makes the
+// capture's context current for the check.
+Napi::Value FrameCapture::Poll(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  uint32_t index    = args[0];
+  if (index >= slots_.size() || slots_[index].state != Slot::State::reading) {
+    GLEW_THROW(info.Env(), GL_INVALID_VALUE);
+  }
+  ScopedCurrent current(gl_context_);
+  if (!current) { NAPI_THROW(Napi::Error::New(info.Env(), "The GL context was destroyed")); }
+  auto status = GL_EXPORT::glClientWaitSync(slots_[index].fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+  if (status == GL_WAIT_FAILED) { GLEW_THROW(info.Env(), GL_EXPORT::glGetError()); }
+  return CPPToNapi(info)(status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED);
+}
+
+// Convert the frame read into `slot` to I420 on the CPU pool, straight from the mapped buffer.
+// Resolves with a Uint8Array, and frees the slot. Poll the slot until it's done first.
+Napi::Value FrameCapture::Convert(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  uint32_t index    = args[0];
+  if (index >= slots_.size() || slots_[index].state != Slot::State::reading) {
+    GLEW_THROW(info.Env(), GL_INVALID_VALUE);
+  }
+  auto& slot   = slots_[index];
+  auto pixels  = static_cast<uint8_t const*>(slot.pixels);
+  auto width   = width_;
+  auto height  = height_;
+  auto promise = Schedule(
+    info.Env(),
+    Pool::cpu,
+    Priority::normal,
+    info.Env().Undefined(),
+    [=](CancellationToken&) {
+      auto size = i420_size(width, height);
+      // Freed here if the Task is cancelled before the result is taken
+      auto frame = std::make_shared<std::unique_ptr<uint8_t[]>>(new uint8_t[size]);
+      rgba_to_i420(pixels, width, height, true, frame->get());
+      return [=](Napi::Env env) -> Napi::Value {
+        auto data = frame->release();
+        return Napi::Uint8Array::New(env, size, owned_array_buffer(env, data, size), 0);
+      };
+    },
+    // Free the slot and drop the reference however the conversion ends
+    [this, index](Napi::Env) {
+      slots_[index].state = Slot::State::free;
+      if (destroyed_) { release(); }
+      Unref();
+    });
+
+  // Only once it's scheduled, so a Schedule() that throws leaves the slot as it was. `settled`
+  // runs on this thread, so not before this returns.
+  {
+    ScopedCurrent current(gl_context_);
+    if (current) { GL_EXPORT::glDeleteSync(slot.fence); }
+  }
+  slot.fence = nullptr;
+  slot.state = Slot::State::converting;
+  // Keep the buffers mapped until the conversion is done, even if this is collected
+  Ref();
+  return promise;
+}
+
+// Delete the buffers once the conversions in flight are done
+Napi::Value FrameCapture::Destroy(Napi::CallbackInfo const& info) {
+  destroyed_ = true;
+  release();
+  return info.Env().Undefined();
+}
+
+// Delete the fences and buffers of the slots not being converted, against the context the capture
+// was created for. If that context is gone, so are they.
+void FrameCapture::release() {
+  ScopedCurrent current(gl_context_);
+  for (auto& slot : slots_) {
+    if (slot.state == Slot::State::converting || slot.buffer == 0) { continue; }
+    if (current) {
+      if (slot.fence != nullptr) { GL_EXPORT::glDeleteSync(slot.fence); }
+      if (slot.pixels != nullptr) { GL_EXPORT::glUnmapNamedBuffer(slot.buffer); }
+      GL_EXPORT::glDeleteBuffers(1, &slot.buffer);
+    }
+    slot = Slot{};
+  }
+}
+
+Napi::Value FrameCapture::GetWidth(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(width_);
+}
+
+Napi::Value FrameCapture::GetHeight(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(height_);
+}
+
+Napi::Value FrameCapture::GetSlots(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(static_cast<uint32_t>(slots_.size()));
+}
+
+}  // namespace nv
@@ -0,0 +1,170 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {Readable} from 'stream';
+
+import gl from './addon';
+
+interface NativeFrameCapture {
+  readonly width: number;
+  readonly height: number;
+  readonly slots: number;
+  capture(framebuffer: WebGLFramebuffer|null, x: number, y: number): number;
+  poll(slot: number): boolean;
+  convert(slot: number): Promise<Uint8Array>;
+  destroy(): void;
+}
+
+// eslint-disable-next-line @typescript-eslint/no-redeclare
+const NativeFrameCapture: {
+  new(context: WebGL2RenderingContext, width: number, height: number, slots?: number):
+    NativeFrameCapture;
+  rgbaToI420(rgba: Uint8Array, width: number, height: number, flipY?: boolean): Uint8Array;
+} = gl.FrameCapture;
+
+/**
+ * Convert `width` x `height` RGBA pixels to I420 (BT.601, limited range): a Y plane, then U and V
+ * planes of half the width and height. `width` and `height` must be even. `flipY` reads the rows
+ * bottom-up, like `readPixels()` returns them. This is the conversion `FrameCaptureStream` runs on
+ * its worker threads.
+ */
+export function rgbaToI420(rgba: Uint8Array, width: number, height: number, flipY = false) {
+  return NativeFrameCapture.rgbaToI420(rgba, width, height, flipY);
+}
+
+export interface I420Frame {
+  /** The Y, U and V planes, top row first */
+  data: Uint8Array;
+  width: number;
+  height: number;
+  /** The timestamp passed to `capture()` */
+  timestamp: number;
+}
+
+export interface FrameCaptureOptions {
+  /** The size of the region to capture. Both must be even. */
+  width: number;
+  height: number;
+  /** The framebuffer to read from. Defaults to the default framebuffer. */
+  framebuffer?: WebGLFramebuffer|null;
+  /** The region's bottom-left corner. Defaults to 0, 0. */
+  x?: number;
+  y?: number;
+  /** The number of frames that can be read and converted at once. Defaults to 3. */
+  slots?: number;
+  /** The number of converted frames buffered for the reader. Defaults to 2. */
+  highWaterMark?: number;
+}
+
+/**
+ * A Readable stream of I420 frames captured from a framebuffer. Call `capture()` after rendering
+ * each frame. It reads the framebuffer into a pixel pack buffer without waiting for the GPU, and
+ * converts the pixels on a worker thread once they're there. Frames are pushed in the order they
+ * were captured.
+ *
+ * The render loop never waits on the reader: when the reader falls behind (or every slot is busy),
+ * `capture()` drops the frame and returns false.
+ *
+ * ```
+ * const stream = new FrameCaptureStream(gl, {width: 1280, height: 720});
+ * stream.on('data', ({data, timestamp}) => encoder.encode(data, timestamp));
+ * // each frame:
+ * render();
+ * stream.capture();
+ * ```
+ */
+export class FrameCaptureStream extends Readable {
+  constructor(context: WebGL2RenderingContext, options: FrameCaptureOptions) {
+    super({objectMode: true, highWaterMark: options.highWaterMark ?? 2});
+    const {width, height, slots} = options;
+    this._native                 = new NativeFrameCapture(context, width, height, slots);
+    this._framebuffer            = options.framebuffer ?? null;
+    this._x                      = options.x ?? 0;
+    this._y                      = options.y ?? 0;
+  }
+
+  private _native: NativeFrameCapture;
+  private _framebuffer: WebGLFramebuffer|null;
+  private _x: number;
+  private _y: number;
+  private _inFlight  = 0;
+  private _captured  = 0;
+  private _pushed    = 0;
+  private _finished  = false;
+  private _dropped   = 0;
+  private _converted = new Map<number, I420Frame>();
+
+  public get width() { return this._native.width; }
+  public get height() { return this._native.height; }
+  /** The number of frames `capture()` dropped */
+  public get dropped() { return this._dropped; }
+
+  /**
+   * Capture the framebuffer as it'll be once the GL calls so far are done. Returns false if the
+   * frame was dropped.
+   */
+  public capture(timestamp = Date.now()) {
+    if (this.destroyed || this._finished ||
+        this.readableLength + this._inFlight >= this.readableHighWaterMark) {
+      ++this._dropped;
+      return false;
+    }
+    const slot = this._native.capture(this._framebuffer, this._x, this._y);
+    if (slot < 0) {
+      ++this._dropped;
+      return false;
+    }
+    const sequence        = this._captured++;
+    const {width, height} = this._native;
+    ++this._inFlight;
+    const poll = () => {
+      if (this.destroyed) { return; }
+      try {
+        if (!this._native.poll(slot)) {
+          setTimeout(poll, 1);
+        } else {
+          this._native.convert(slot).then(
+            (data) => this._pushInOrder(sequence, {data, width, height, timestamp}),
+            (err) => this.destroy(err));
+        }
+      } catch (e) { this.destroy(e); }
+    };
+    setImmediate(poll);
+    return true;
+  }
+
+  /** Stop capturing. The stream ends once the frames in flight have been pushed. */
+  public finish() {
+    this._finished = true;
+    if (this._inFlight === 0) { this.push(null); }
+  }
+
+  _read() {}
+
+  _destroy(err: Error|null, callback: (err: Error|null) => void) {
+    this._native.destroy();
+    callback(err);
+  }
+
+  private _pushInOrder(sequence: number, frame: I420Frame) {
+    if (this.destroyed) { return; }
+    this._converted.set(sequence, frame);
+    for (let next; (next = this._converted.get(this._pushed));) {
+      this._converted.delete(this._pushed++);
+      --this._inFlight;
+      this.push(next);
+    }
+    if (this._finished && this._inFlight === 0) { this.push(null); }
+  }
+}
@@ -0,0 +1,239 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "macros.hpp"
+#include "webgl.hpp"
+
+#include <nv_node/utilities/command_buffer.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace nv {
+
+namespace {
+
+// Buffer offsets (`drawElements`, `vertexAttribPointer`) are passed to GL as pointers
+inline void* offset(double value) {
+  return reinterpret_cast<void*>(static_cast<uintptr_t>(value));
+}
+
+// Arguments `first` through the end of `command`, as a contiguous array of T. Array arguments
+// (e.g. `uniform4fv`'s values) are encoded inline, so they must be the last argument.
+template <typename T>
+inline std::vector<T> const& values(Command const& command, uint32_t first) {
+  static thread_local std::vector<T> values;
+  values.resize(command.Length() > first ? command.Length() - first : 0);
+  for (uint32_t i = 0; i < values.size(); ++i) { values[i] = command[first + i]; }
+  return values;
+}
+
+// The number of `size`-element items in the inline array from `first` on. Throws GL_INVALID_VALUE
+// like the immediate-mode methods if the array's length isn't a positive multiple of `size`.
+inline GLsizei count(Command const& command, uint32_t first, uint32_t size) {
+  auto length = command.Length() > first ? command.Length() - first : 0;
+  if (length < size || (length % size) != 0) {
+    NAPI_THROW(glewError(command.Env(), GL_INVALID_VALUE, __FILE__, __LINE__), 0);
+  }
+  return length / size;
+}
+
+// The state cache of the context whose handle is the first argument
+inline GLStateCache& state(Command const& command) {
+  return command.Handle<WebGL2RenderingContext>(0)->state();
+}
+
+}  // namespace
+
+// Object arguments are encoded as their GL names (`ptr`), uniform locations as -1 when null, and
+// booleans as 0 or 1. `clear` and the calls the state cache tracks are passed the context's handle
+// first, since they update the context's own state.
+CommandTable WebGL2RenderingContext::commands{
+  {"activeTexture", [](Command& c) { GL_EXPORT::glActiveTexture(c[0]); }},
+  {"bindBuffer",
+   [](Command& c) {
+     GLenum target = c[1];
+     GLuint buffer = c[2];
+     state(c).SetBuffer(target, buffer, [&] { GL_EXPORT::glBindBuffer(target, buffer); });
+   }},
+  {"bindBufferBase",
+   [](Command& c) {
+     GL_EXPORT::glBindBufferBase(c[1], c[2], c[3]);
+     state(c).ForgetBuffer(c[1]);
+   }},
+  {"bindBufferRange",
+   [](Command& c) {
+     GL_EXPORT::glBindBufferRange(c[1], c[2], c[3], c[4], c[5]);
+     state(c).ForgetBuffer(c[1]);
+   }},
+  {"bindFramebuffer", [](Command& c) { GL_EXPORT::glBindFramebuffer(c[0], c[1]); }},
+  {"bindRenderbuffer", [](Command& c) { GL_EXPORT::glBindRenderbuffer(c[0], c[1]); }},
+  {"bindSampler", [](Command& c) { GL_EXPORT::glBindSampler(c[0], c[1]); }},
+  {"bindTexture", [](Command& c) { GL_EXPORT::glBindTexture(c[0], c[1]); }},
+  {"bindVertexArray",
+   [](Command& c) {
+     GLuint vertex_array = c[1];
+     state(c).SetVertexArray(vertex_array, [&] { GL_EXPORT::glBindVertexArray(vertex_array); });
+   }},
+  {"blendColor", [](Command& c) { GL_EXPORT::glBlendColor(c[0], c[1], c[2], c[3]); }},
+  {"blendEquation", [](Command& c) { GL_EXPORT::glBlendEquation(c[0]); }},
+  {"blendEquationSeparate", [](Command& c) { GL_EXPORT::glBlendEquationSeparate(c[0], c[1]); }},
+  {"blendFunc",
+   [](Command& c) {
+     GLenum src = c[1];
+     GLenum dst = c[2];
+     state(c).SetBlendFunc(src, dst, src, dst, [&] { GL_EXPORT::glBlendFunc(src, dst); });
+   }},
+  {"blendFuncSeparate",
+   [](Command& c) {
+     GLenum src_rgb   = c[1];
+     GLenum dst_rgb   = c[2];
+     GLenum src_alpha = c[3];
+     GLenum dst_alpha = c[4];
+     state(c).SetBlendFunc(src_rgb, dst_rgb, src_alpha, dst_alpha, [&] {
+       GL_EXPORT::glBlendFuncSeparate(src_rgb, dst_rgb, src_alpha, dst_alpha);
+     });
+   }},
+  {"clear",
+   [](Command& c) {
+     GLbitfield mask = c[1];
+     c.Handle<WebGL2RenderingContext>(0)->clear_mask_ |= mask;
+     GL_EXPORT::glClear(mask);
+   }},
+  {"clearColor", [](Command& c) { GL_EXPORT::glClearColor(c[0], c[1], c[2], c[3]); }},
+  {"clearDepth", [](Command& c) { GL_EXPORT::glClearDepth(c[0]); }},
+  {"clearStencil", [](Command& c) { GL_EXPORT::glClearStencil(c[0]); }},
+  {"colorMask",
+   [](Command& c) { GL_EXPORT::glColorMask(c[0] != 0, c[1] != 0, c[2] != 0, c[3] != 0); }},
+  {"cullFace", [](Command& c) { GL_EXPORT::glCullFace(c[0]); }},
+  {"depthFunc", [](Command& c) { GL_EXPORT::glDepthFunc(c[0]); }},
+  {"depthMask", [](Command& c) { GL_EXPORT::glDepthMask(c[0] != 0); }},
+  {"depthRange", [](Command& c) { GL_EXPORT::glDepthRange(c[0], c[1]); }},
+  {"disable",
+   [](Command& c) {
+     GLenum cap = c[1];
+     state(c).SetCapability(cap, false, [&] { GL_EXPORT::glDisable(cap); });
+   }},
+  {"disableVertexAttribArray", [](Command& c) { GL_EXPORT::glDisableVertexAttribArray(c[0]); }},
+  {"drawArrays", [](Command& c) { GL_EXPORT::glDrawArrays(c[0], c[1], c[2]); }},
+  {"drawArraysInstanced",
+   [](Command& c) { GL_EXPORT::glDrawArraysInstanced(c[0], c[1], c[2], c[3]); }},
+  {"drawBuffers",
+   [](Command& c) {
+     auto& buffers = values<GLenum>(c, 0);
+     GL_EXPORT::glDrawBuffers(buffers.size(), buffers.data());
+   }},
+  {"drawElements",
+   [](Command& c) { GL_EXPORT::glDrawElements(c[0], c[1], c[2], offset(c[3])); }},
+  {"drawElementsInstanced",
+   [](Command& c) {
+     GL_EXPORT::glDrawElementsInstanced(c[0], c[1], c[2], offset(c[3]), c[4]);
+   }},
+  {"drawRangeElements",
+   [](Command& c) {
+     GL_EXPORT::glDrawRangeElements(c[0], c[1], c[2], c[3], c[4], offset(c[5]));
+   }},
+  {"enable",
+   [](Command& c) {
+     GLenum cap = c[1];
+     state(c).SetCapability(cap, true, [&] { GL_EXPORT::glEnable(cap); });
+   }},
+  {"enableVertexAttribArray", [](Command& c) { GL_EXPORT::glEnableVertexAttribArray(c[0]); }},
+  {"frontFace", [](Command& c) { GL_EXPORT::glFrontFace(c[0]); }},
+  {"lineWidth", [](Command& c) { GL_EXPORT::glLineWidth(c[0]); }},
+  {"polygonOffset", [](Command& c) { GL_EXPORT::glPolygonOffset(c[0], c[1]); }},
+  {"sampleCoverage", [](Command& c) { GL_EXPORT::glSampleCoverage(c[0], c[1] != 0); }},
+  {"scissor", [](Command& c) { GL_EXPORT::glScissor(c[0], c[1], c[2], c[3]); }},
+  {"stencilFunc", [](Command& c) { GL_EXPORT::glStencilFunc(c[0], c[1], c[2]); }},
+  {"stencilFuncSeparate",
+   [](Command& c) { GL_EXPORT::glStencilFuncSeparate(c[0], c[1], c[2], c[3]); }},
+  {"stencilMask", [](Command& c) { GL_EXPORT::glStencilMask(c[0]); }},
+  {"stencilMaskSeparate", [](Command& c) { GL_EXPORT::glStencilMaskSeparate(c[0], c[1]); }},
+  {"stencilOp", [](Command& c) { GL_EXPORT::glStencilOp(c[0], c[1], c[2]); }},
+  {"stencilOpSeparate",
+   [](Command& c) { GL_EXPORT::glStencilOpSeparate(c[0], c[1], c[2], c[3]); }},
+  {"uniform1f", [](Command& c) { GL_EXPORT::glUniform1f(c[0], c[1]); }},
+  {"uniform2f", [](Command& c) { GL_EXPORT::glUniform2f(c[0], c[1], c[2]); }},
+  {"uniform3f", [](Command& c) { GL_EXPORT::glUniform3f(c[0], c[1], c[2], c[3]); }},
+  {"uniform4f", [](Command& c) { GL_EXPORT::glUniform4f(c[0], c[1], c[2], c[3], c[4]); }},
+  {"uniform1i", [](Command& c) { GL_EXPORT::glUniform1i(c[0], c[1]); }},
+  {"uniform2i", [](Command& c) { GL_EXPORT::glUniform2i(c[0], c[1], c[2]); }},
+  {"uniform3i", [](Command& c) { GL_EXPORT::glUniform3i(c[0], c[1], c[2], c[3]); }},
+  {"uniform4i", [](Command& c) { GL_EXPORT::glUniform4i(c[0], c[1], c[2], c[3], c[4]); }},
+  {"uniform1ui", [](Command& c) { GL_EXPORT::glUniform1ui(c[0], c[1]); }},
+  {"uniform2ui", [](Command& c) { GL_EXPORT::glUniform2ui(c[0], c[1], c[2]); }},
+  {"uniform3ui", [](Command& c) { GL_EXPORT::glUniform3ui(c[0], c[1], c[2], c[3]); }},
+  {"uniform4ui", [](Command& c) { GL_EXPORT::glUniform4ui(c[0], c[1], c[2], c[3], c[4]); }},
+  {"uniform1fv",
+   [](Command& c) { GL_EXPORT::glUniform1fv(c[0], count(c, 1, 1), values<GLfloat>(c, 1).data()); }},
+  {"uniform2fv",
+   [](Command& c) { GL_EXPORT::glUniform2fv(c[0], count(c, 1, 2), values<GLfloat>(c, 1).data()); }},
+  {"uniform3fv",
+   [](Command& c) { GL_EXPORT::glUniform3fv(c[0], count(c, 1, 3), values<GLfloat>(c, 1).data()); }},
+  {"uniform4fv",
+   [](Command& c) { GL_EXPORT::glUniform4fv(c[0], count(c, 1, 4), values<GLfloat>(c, 1).data()); }},
+  {"uniform1iv",
+   [](Command& c) { GL_EXPORT::glUniform1iv(c[0], count(c, 1, 1), values<GLint>(c, 1).data()); }},
+  {"uniform2iv",
+   [](Command& c) { GL_EXPORT::glUniform2iv(c[0], count(c, 1, 2), values<GLint>(c, 1).data()); }},
+  {"uniform3iv",
+   [](Command& c) { GL_EXPORT::glUniform3iv(c[0], count(c, 1, 3), values<GLint>(c, 1).data()); }},
+  {"uniform4iv",
+   [](Command& c) { GL_EXPORT::glUniform4iv(c[0], count(c, 1, 4), values<GLint>(c, 1).data()); }},
+  {"uniformMatrix2fv",
+   [](Command& c) {
+     GL_EXPORT::glUniformMatrix2fv(
+       c[0], count(c, 2, 4), c[1] != 0, values<GLfloat>(c, 2).data());
+   }},
+  {"uniformMatrix3fv",
+   [](Command& c) {
+     GL_EXPORT::glUniformMatrix3fv(
+       c[0], count(c, 2, 9), c[1] != 0, values<GLfloat>(c, 2).data());
+   }},
+  {"uniformMatrix4fv",
+   [](Command& c) {
+     GL_EXPORT::glUniformMatrix4fv(
+       c[0], count(c, 2, 16), c[1] != 0, values<GLfloat>(c, 2).data());
+   }},
+  {"useProgram",
+   [](Command& c) {
+     GLuint program = c[1];
+     state(c).SetProgram(program, [&] { GL_EXPORT::glUseProgram(program); });
+   }},
+  {"vertexAttrib1f", [](Command& c) { GL_EXPORT::glVertexAttrib1f(c[0], c[1]); }},
+  {"vertexAttrib2f", [](Command& c) { GL_EXPORT::glVertexAttrib2f(c[0], c[1], c[2]); }},
+  {"vertexAttrib3f", [](Command& c) { GL_EXPORT::glVertexAttrib3f(c[0], c[1], c[2], c[3]); }},
+  {"vertexAttrib4f",
+   [](Command& c) { GL_EXPORT::glVertexAttrib4f(c[0], c[1], c[2], c[3], c[4]); }},
+  {"vertexAttribDivisor", [](Command& c) { GL_EXPORT::glVertexAttribDivisor(c[0], c[1]); }},
+  {"vertexAttribIPointer",
+   [](Command& c) {
+     GL_EXPORT::glVertexAttribIPointer(c[0], c[1], c[2], c[3], offset(c[4]));
+   }},
+  {"vertexAttribPointer",
+   [](Command& c) {
+     GL_EXPORT::glVertexAttribPointer(
+       c[0], c[1], c[2], c[3] != 0 ? GL_TRUE : GL_FALSE, c[4], offset(c[5]));
+   }},
+  {"viewport",
+   [](Command& c) {
+     GLint x        = c[1];
+     GLint y        = c[2];
+     GLsizei width  = c[3];
+     GLsizei height = c[4];
+     state(c).SetViewport(x, y, width, height, [&] { GL_EXPORT::glViewport(x, y, width, height); });
+   }},
+};
+
+}  // namespace nv
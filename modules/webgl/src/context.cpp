@@ -17,24 +17,85 @@
 
 #include <nv_node/utilities/args.hpp>
 #include <nv_node/utilities/cpp_to_napi.hpp>
+#include <nv_node/utilities/trace.hpp>
 
+#include <cstdlib>
+#include <cstring>
 #include <iterator>
 #include <sstream>
 
 namespace nv {
 
-Napi::FunctionReference WebGL2RenderingContext::constructor;
+ConstructorReference WebGL2RenderingContext::constructor;
 
 WebGL2RenderingContext::WebGL2RenderingContext(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGL2RenderingContext>(info) {
   glewExperimental = GL_TRUE;
   GL_EXPECT_OK(Env(), GLEWAPIENTRY::glewInit());
-  if (info[0].IsNull() || info[0].IsEmpty() || !info[0].IsObject()) {
-    context_attributes_ = Napi::Persistent(Napi::Object::New(Env()));
-  } else {
-    context_attributes_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  // Built once: the WebGL defaults, overridden by the attributes passed in
+  auto attrs = Napi::Object::New(Env());
+  attrs.Set("alpha", true);
+  attrs.Set("antialias", true);
+  attrs.Set("depth", true);
+  attrs.Set("desynchronized", false);
+  attrs.Set("failIfMajorPerformanceCaveat", false);
+  attrs.Set("powerPreference", "default");
+  attrs.Set("premultipliedAlpha", true);
+  attrs.Set("preserveDrawingBuffer", false);
+  attrs.Set("stencil", false);
+  if (!info[0].IsNull() && !info[0].IsEmpty() && info[0].IsObject()) {
+    auto passed = info[0].As<Napi::Object>();
+    auto keys   = passed.GetPropertyNames();
+    for (uint32_t i = 0; i < keys.Length(); ++i) {
+      auto key = keys.Get(i);
+      attrs.Set(key, passed.Get(key));
+    }
+  }
+  context_attributes_ = Napi::Persistent(attrs);
+  parameters_         = Napi::Persistent(Napi::Object::New(Env()));
+
+  state_ = GLStateCache::ForCurrent(!attrs.Has("stateCache") ||
+                                    attrs.Get("stateCache").ToBoolean().Value());
+
+  // `programCache: {directory, maxBytes, deferCompile}` caches linked programs in `directory`,
+  // which defaults to NVIDIA_NODE_WEBGL_PROGRAM_CACHE. `programCache: false` turns it off.
+  auto program_cache = attrs.Get("programCache");
+  if (!program_cache.IsBoolean() || program_cache.ToBoolean().Value()) {
+    std::string directory{};
+    size_t max_bytes{64 << 20};
+    bool defer_compile{false};
+    if (auto dir = std::getenv("NVIDIA_NODE_WEBGL_PROGRAM_CACHE")) { directory = dir; }
+    if (program_cache.IsObject()) {
+      auto opts = program_cache.As<Napi::Object>();
+      if (opts.Get("directory").IsString()) {
+        directory = opts.Get("directory").ToString().Utf8Value();
+      }
+      if (opts.Get("maxBytes").IsNumber()) {
+        max_bytes = opts.Get("maxBytes").ToNumber().Int64Value();
+      }
+      defer_compile = opts.Get("deferCompile").ToBoolean().Value();
+    }
+    if (!directory.empty()) {
+      program_cache_.reset(new ProgramCache(directory, max_bytes, defer_compile));
+    }
   }
 
+  // `errorChecks: "none" | "debug" | "strict"`
+  auto error_checks = attrs.Get("errorChecks");
+  if (error_checks.IsString()) {
+    auto mode = error_checks.ToString().Utf8Value();
+    if (mode == "debug") {
+      error_checks_ = ErrorChecks::debug;
+      InstallDebugLog();
+    } else if (mode == "strict") {
+      error_checks_ = ErrorChecks::strict;
+    } else if (mode != "none") {
+      GLEW_THROW(Env(), GL_INVALID_ENUM);
+    }
+  }
+  if (error_checks_ != ErrorChecks::none) { state_->check_errors = true; }
+
   // TODO: Is this necessary?
   //
   // auto attrs = context_attributes_.Value();
@@ -47,6 +108,41 @@ WebGL2RenderingContext::WebGL2RenderingContext(Napi::CallbackInfo const& info)
   // GL_EXPORT::glEnable(GL_POINT_SPRITE);
 };
 
+// Runs from the GC, so it makes this context current for the GL calls, and restores whichever
+// context was current after
+WebGL2RenderingContext::~WebGL2RenderingContext() {
+  ScopedCurrent current(gl_context_);
+  FreePixelPackRing();
+  if (current) {
+    for (auto const& entry : uniform_layouts_) { ReleaseUniformLayout(entry.second); }
+    buffer_names_.Free(
+      [](GLsizei n, GLuint const* names) { GL_EXPORT::glDeleteBuffers(n, names); });
+    query_names_.Free(
+      [](GLsizei n, GLuint const* names) { GL_EXPORT::glDeleteQueries(n, names); });
+  }
+  if (debug_log_ == nullptr) { return; }
+  if (!current) {
+    // The driver may still call back with the log if the context is alive but can't be made
+    // current here, so it's leaked rather than freed under it
+    debug_log_.release();
+    return;
+  }
+  // Only if it's still this context's log the driver calls back with
+  void* user_param{};
+  GL_EXPORT::glGetPointerv(GL_DEBUG_CALLBACK_USER_PARAM, &user_param);
+  if (user_param == debug_log_.get()) { GL_EXPORT::glDebugMessageCallback(nullptr, nullptr); }
+}
+
+template <Napi::Value (WebGL2RenderingContext::*method)(Napi::CallbackInfo const&)>
+Napi::Value WebGL2RenderingContext::Checked(Napi::CallbackInfo const& info) {
+  auto result = (this->*method)(info);
+  if (error_checks_ == ErrorChecks::strict) {
+    GLenum const code = state_->TakeError();
+    if (code != GL_NO_ERROR) { GLEW_THROW(info.Env(), code); }
+  }
+  return result;
+}
+
 Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor = DefineClass(
     env,
@@ -57,10 +153,10 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
                        &WebGL2RenderingContext::SetClearMask_,
                        napi_default),
 
-#define INST_METHOD(key, func) \
-  InstanceMethod(              \
-    key,                       \
-    func,                      \
+#define INST_METHOD(key, func)                                                   \
+  InstanceValue(                                                                 \
+    key,                                                                         \
+    trace::WrapInstanceMethod(env, key, &WebGL2RenderingContext::Checked<func>), \
     static_cast<napi_property_attributes>(napi_writable | napi_enumerable | napi_configurable))
 
       // INST_METHOD("isSupported", &WebGL2RenderingContext::IsSupported),
@@ -89,11 +185,22 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
       INST_METHOD("pixelStorei", &WebGL2RenderingContext::PixelStorei),
       INST_METHOD("polygonOffset", &WebGL2RenderingContext::PolygonOffset),
       INST_METHOD("readPixels", &WebGL2RenderingContext::ReadPixels),
+      INST_METHOD("_readPixelsToBuffer", &WebGL2RenderingContext::ReadPixelsToBuffer_),
+      INST_METHOD("_pollPixels", &WebGL2RenderingContext::PollPixels_),
+      INST_METHOD("_takePixels", &WebGL2RenderingContext::TakePixels_),
+      INST_METHOD("_releasePixels", &WebGL2RenderingContext::ReleasePixels_),
       INST_METHOD("scissor", &WebGL2RenderingContext::Scissor),
       INST_METHOD("viewport", &WebGL2RenderingContext::Viewport),
       INST_METHOD("drawRangeElements", &WebGL2RenderingContext::DrawRangeElements),
       INST_METHOD("sampleCoverage", &WebGL2RenderingContext::SampleCoverage),
       INST_METHOD("getContextAttributes", &WebGL2RenderingContext::GetContextAttributes),
+      INST_METHOD("getStateCacheStats", &WebGL2RenderingContext::GetStateCacheStats),
+      INST_METHOD("invalidateStateCache", &WebGL2RenderingContext::InvalidateStateCache),
+      INST_METHOD("getProgramCacheStats", &WebGL2RenderingContext::GetProgramCacheStats),
+      INST_METHOD("getDebugMessages", &WebGL2RenderingContext::GetDebugMessages),
+      INST_METHOD("createUniformLayout", &WebGL2RenderingContext::CreateUniformLayout),
+      INST_METHOD("setUniforms", &WebGL2RenderingContext::SetUniforms),
+      INST_METHOD("deleteUniformLayout", &WebGL2RenderingContext::DeleteUniformLayout),
       INST_METHOD("getFragDataLocation", &WebGL2RenderingContext::GetFragDataLocation),
       INST_METHOD("getParameter", &WebGL2RenderingContext::GetParameter),
       INST_METHOD("getSupportedExtensions", &WebGL2RenderingContext::GetSupportedExtensions),
@@ -130,6 +237,7 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
       INST_METHOD("createBuffers", &WebGL2RenderingContext::CreateBuffers),
       INST_METHOD("deleteBuffer", &WebGL2RenderingContext::DeleteBuffer),
       INST_METHOD("deleteBuffers", &WebGL2RenderingContext::DeleteBuffers),
+      INST_METHOD("recycleBuffer", &WebGL2RenderingContext::RecycleBuffer),
       INST_METHOD("getBufferParameter", &WebGL2RenderingContext::GetBufferParameter),
       INST_METHOD("isBuffer", &WebGL2RenderingContext::IsBuffer),
       INST_METHOD("bindBufferBase", &WebGL2RenderingContext::BindBufferBase),
@@ -159,6 +267,16 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
       INST_METHOD("invalidateSubFramebuffer", &WebGL2RenderingContext::InvalidateSubFramebuffer),
       INST_METHOD("drawArraysInstanced", &WebGL2RenderingContext::DrawArraysInstanced),
       INST_METHOD("drawElementsInstanced", &WebGL2RenderingContext::DrawElementsInstanced),
+      INST_METHOD("multiDrawArrays", &WebGL2RenderingContext::MultiDrawArrays),
+      INST_METHOD("multiDrawElements", &WebGL2RenderingContext::MultiDrawElements),
+      INST_METHOD("multiDrawArraysInstanced", &WebGL2RenderingContext::MultiDrawArraysInstanced),
+      INST_METHOD("multiDrawElementsInstanced",
+                  &WebGL2RenderingContext::MultiDrawElementsInstanced),
+      INST_METHOD("drawArraysIndirect", &WebGL2RenderingContext::DrawArraysIndirect),
+      INST_METHOD("drawElementsIndirect", &WebGL2RenderingContext::DrawElementsIndirect),
+      INST_METHOD("multiDrawArraysIndirect", &WebGL2RenderingContext::MultiDrawArraysIndirect),
+      INST_METHOD("multiDrawElementsIndirect",
+                  &WebGL2RenderingContext::MultiDrawElementsIndirect),
       INST_METHOD("vertexAttribDivisor", &WebGL2RenderingContext::VertexAttribDivisor),
       INST_METHOD("createProgram", &WebGL2RenderingContext::CreateProgram),
       INST_METHOD("deleteProgram", &WebGL2RenderingContext::DeleteProgram),
@@ -173,6 +291,7 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
       INST_METHOD("createQueries", &WebGL2RenderingContext::CreateQueries),
       INST_METHOD("deleteQuery", &WebGL2RenderingContext::DeleteQuery),
       INST_METHOD("deleteQueries", &WebGL2RenderingContext::DeleteQueries),
+      INST_METHOD("recycleQuery", &WebGL2RenderingContext::RecycleQuery),
       INST_METHOD("endQuery", &WebGL2RenderingContext::EndQuery),
       INST_METHOD("getQuery", &WebGL2RenderingContext::GetQuery),
       INST_METHOD("getQueryParameter", &WebGL2RenderingContext::GetQueryParameter),
@@ -209,6 +328,7 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
       INST_METHOD("clientWaitSync", &WebGL2RenderingContext::ClientWaitSync),
       INST_METHOD("deleteSync", &WebGL2RenderingContext::DeleteSync),
       INST_METHOD("fenceSync", &WebGL2RenderingContext::FenceSync),
+      INST_METHOD("recycleSync", &WebGL2RenderingContext::RecycleSync),
       INST_METHOD("getSyncParameter", &WebGL2RenderingContext::GetSyncParameter),
       INST_METHOD("isSync", &WebGL2RenderingContext::IsSync),
       INST_METHOD("waitSync", &WebGL2RenderingContext::WaitSync),
@@ -305,6 +425,8 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
       INST_METHOD("uniformBlockBinding", &WebGL2RenderingContext::UniformBlockBinding),
       INST_METHOD("createVertexArray", &WebGL2RenderingContext::CreateVertexArray),
       INST_METHOD("createVertexArrays", &WebGL2RenderingContext::CreateVertexArrays),
+      INST_METHOD("createVertexArrayFromLayout",
+                  &WebGL2RenderingContext::CreateVertexArrayFromLayout),
       INST_METHOD("bindVertexArray", &WebGL2RenderingContext::BindVertexArray),
       INST_METHOD("deleteVertexArray", &WebGL2RenderingContext::DeleteVertexArray),
       INST_METHOD("deleteVertexArrays", &WebGL2RenderingContext::DeleteVertexArrays),
@@ -360,6 +482,8 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
       INST_ENUM("STATIC_COPY", GL_STATIC_COPY),
       INST_ENUM("DYNAMIC_READ", GL_DYNAMIC_READ),
       INST_ENUM("DYNAMIC_COPY", GL_DYNAMIC_COPY),
+      INST_ENUM("DRAW_INDIRECT_BUFFER", GL_DRAW_INDIRECT_BUFFER),
+      INST_ENUM("DRAW_INDIRECT_BUFFER_BINDING", GL_DRAW_INDIRECT_BUFFER_BINDING),
       INST_ENUM("MAX_DRAW_BUFFERS", GL_MAX_DRAW_BUFFERS),
       INST_ENUM("DRAW_BUFFER0", GL_DRAW_BUFFER0),
       INST_ENUM("DRAW_BUFFER1", GL_DRAW_BUFFER1),
@@ -889,7 +1013,6 @@ Napi::Object WebGL2RenderingContext::Init(Napi::Env env, Napi::Object exports) {
     });
 
   WebGL2RenderingContext::constructor = Napi::Persistent(ctor);
-  WebGL2RenderingContext::constructor.SuppressDestruct();
 
   EXPORT_PROP(exports, "WebGL2RenderingContext", ctor);
 
@@ -957,7 +1080,8 @@ Napi::Value WebGL2RenderingContext::DepthRange(Napi::CallbackInfo const& info) {
 // GL_EXPORT void glDisable (GLenum cap);
 Napi::Value WebGL2RenderingContext::Disable(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glDisable(args[0]);
+  GLenum cap        = args[0];
+  state_->SetCapability(cap, false, [&] { GL_EXPORT::glDisable(cap); });
   return info.Env().Undefined();
 }
 
@@ -978,7 +1102,8 @@ Napi::Value WebGL2RenderingContext::DrawElements(Napi::CallbackInfo const& info)
 // GL_EXPORT void glEnable (GLenum cap);
 Napi::Value WebGL2RenderingContext::Enable(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glEnable(args[0]);
+  GLenum cap        = args[0];
+  state_->SetCapability(cap, true, [&] { GL_EXPORT::glEnable(cap); });
   return info.Env().Undefined();
 }
 
@@ -1005,28 +1130,131 @@ Napi::Value WebGL2RenderingContext::FrontFace(Napi::CallbackInfo const& info) {
 
 // GL_EXPORT GLenum glGetError (void);
 Napi::Value WebGL2RenderingContext::GetError(Napi::CallbackInfo const& info) {
-  return CPPToNapi(info.Env())(GL_EXPORT::glGetError());
+  return CPPToNapi(info.Env())(state_->TakeError());
+}
+
+namespace {
+
+// Parameters that are fixed for the life of the context: its limits and strings
+inline bool is_immutable(GLenum pname) {
+  switch (pname) {
+    case GL_ALIASED_LINE_WIDTH_RANGE:
+    case GL_ALIASED_POINT_SIZE_RANGE:
+    case GL_EXTENSIONS:
+    case GL_MAX_3D_TEXTURE_SIZE:
+    case GL_MAX_ARRAY_TEXTURE_LAYERS:
+    case GL_MAX_CLIENT_WAIT_TIMEOUT_WEBGL:
+    case GL_MAX_COLOR_ATTACHMENTS:
+    case GL_MAX_COMBINED_FRAGMENT_UNIFORM_COMPONENTS:
+    case GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_COMBINED_UNIFORM_BLOCKS:
+    case GL_MAX_COMBINED_VERTEX_UNIFORM_COMPONENTS:
+    case GL_MAX_CUBE_MAP_TEXTURE_SIZE:
+    case GL_MAX_DRAW_BUFFERS:
+    case GL_MAX_ELEMENT_INDEX:
+    case GL_MAX_ELEMENTS_INDICES:
+    case GL_MAX_ELEMENTS_VERTICES:
+    case GL_MAX_FRAGMENT_INPUT_COMPONENTS:
+    case GL_MAX_FRAGMENT_UNIFORM_BLOCKS:
+    case GL_MAX_FRAGMENT_UNIFORM_COMPONENTS:
+    case GL_MAX_FRAGMENT_UNIFORM_VECTORS:
+    case GL_MAX_PROGRAM_TEXEL_OFFSET:
+    case GL_MAX_RENDERBUFFER_SIZE:
+    case GL_MAX_SAMPLES:
+    case GL_MAX_SERVER_WAIT_TIMEOUT:
+    case GL_MAX_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_TEXTURE_LOD_BIAS:
+    case GL_MAX_TEXTURE_SIZE:
+    case GL_MAX_TRANSFORM_FEEDBACK_INTERLEAVED_COMPONENTS:
+    case GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_ATTRIBS:
+    case GL_MAX_TRANSFORM_FEEDBACK_SEPARATE_COMPONENTS:
+    case GL_MAX_UNIFORM_BLOCK_SIZE:
+    case GL_MAX_UNIFORM_BUFFER_BINDINGS:
+    case GL_MAX_VARYING_COMPONENTS:
+    case GL_MAX_VARYING_VECTORS:
+    case GL_MAX_VERTEX_ATTRIBS:
+    case GL_MAX_VERTEX_OUTPUT_COMPONENTS:
+    case GL_MAX_VERTEX_TEXTURE_IMAGE_UNITS:
+    case GL_MAX_VERTEX_UNIFORM_BLOCKS:
+    case GL_MAX_VERTEX_UNIFORM_COMPONENTS:
+    case GL_MAX_VERTEX_UNIFORM_VECTORS:
+    case GL_MAX_VIEWPORT_DIMS:
+    case GL_MIN_PROGRAM_TEXEL_OFFSET:
+    case GL_RENDERER:
+    case GL_SHADING_LANGUAGE_VERSION:
+    case GL_SUBPIXEL_BITS:
+    case GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT:
+    case GL_UNMASKED_RENDERER_WEBGL:
+    case GL_UNMASKED_VENDOR_WEBGL:
+    case GL_VENDOR:
+    case GL_VERSION: return true;
+    default: return false;
+  }
 }
 
+// Cached typed arrays are copied on the way out, so changing one can't change the next answer
+inline Napi::Value copy(Napi::Env env, Napi::Value value) {
+  if (!value.IsTypedArray()) { return value; }
+  auto src  = value.As<Napi::TypedArray>();
+  auto size = src.ByteLength();
+  auto buf  = Napi::ArrayBuffer::New(env, size);
+  std::memcpy(buf.Data(), static_cast<char*>(src.ArrayBuffer().Data()) + src.ByteOffset(), size);
+  if (src.TypedArrayType() == napi_float32_array) {
+    return Napi::Float32Array::New(env, src.ElementLength(), buf, 0);
+  }
+  return Napi::Int32Array::New(env, src.ElementLength(), buf, 0);
+}
+
+}  // namespace
+
 // GL_EXPORT void glGetParameter (GLint pname);
 Napi::Value WebGL2RenderingContext::GetParameter(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
   GLint pname       = args[0];
+
+  // Answer from the state cache if it knows the value
+  bool enabled{};
+  if (state_->IsEnabled(pname, enabled)) { return CPPToNapi(info)(enabled); }
+  GLint values[4]{};
+  switch (state_->GetInteger(pname, values)) {
+    case 1: return CPPToNapi(info)(values[0]);
+    case 4: {
+      auto buf = Napi::ArrayBuffer::New(info.Env(), 4 * sizeof(GLint));
+      std::memcpy(buf.Data(), values, 4 * sizeof(GLint));
+      return Napi::Int32Array::New(info.Env(), 4, buf, 0);
+    }
+    default: break;
+  }
+
+  if (!is_immutable(pname)) { return ReadParameter(info.Env(), pname); }
+
+  // Limits and strings can't change, so only ask the driver for them once
+  auto parameters = parameters_.Value();
+  auto key        = static_cast<uint32_t>(pname);
+  if (!parameters.Has(key)) {
+    auto value = ReadParameter(info.Env(), pname);
+    if (value.IsNull()) { return value; }
+    parameters.Set(key, value);
+  }
+  return copy(info.Env(), parameters.Get(key));
+}
+
+Napi::Value WebGL2RenderingContext::ReadParameter(Napi::Env env, GLint pname) {
   switch (pname) {
     case GL_GPU_DISJOINT:
-    case GL_MAX_CLIENT_WAIT_TIMEOUT_WEBGL: return CPPToNapi(info)(0);
+    case GL_MAX_CLIENT_WAIT_TIMEOUT_WEBGL: return CPPToNapi(env)(0);
 
     case GL_VENDOR:
     case GL_UNMASKED_VENDOR_WEBGL: {
       auto str = GL_EXPORT::glGetString(GL_VENDOR);
-      if (str == NULL) { return info.Env().Null(); }
-      return CPPToNapi(info)(std::string{reinterpret_cast<const GLchar*>(str)});
+      if (str == NULL) { return env.Null(); }
+      return CPPToNapi(env)(std::string{reinterpret_cast<const GLchar*>(str)});
     }
     case GL_RENDERER:
     case GL_UNMASKED_RENDERER_WEBGL: {
       auto str = GL_EXPORT::glGetString(GL_RENDERER);
-      if (str == NULL) { return info.Env().Null(); }
-      return CPPToNapi(info)(std::string{reinterpret_cast<const GLchar*>(str)});
+      if (str == NULL) { return env.Null(); }
+      return CPPToNapi(env)(std::string{reinterpret_cast<const GLchar*>(str)});
     }
 
     case GL_BLEND:
@@ -1035,6 +1263,9 @@ Napi::Value WebGL2RenderingContext::GetParameter(Napi::CallbackInfo const& info)
     case GL_DEPTH_WRITEMASK:
     case GL_DITHER:
     case GL_POLYGON_OFFSET_FILL:
+    case GL_RASTERIZER_DISCARD:
+    case GL_SAMPLE_ALPHA_TO_COVERAGE:
+    case GL_SAMPLE_COVERAGE:
     case GL_SAMPLE_COVERAGE_INVERT:
     case GL_SCISSOR_TEST:
     case GL_STENCIL_TEST:
@@ -1042,13 +1273,13 @@ Napi::Value WebGL2RenderingContext::GetParameter(Napi::CallbackInfo const& info)
     case GL_UNPACK_PREMULTIPLY_ALPHA_WEBGL: {
       GLubyte param{};
       GL_EXPORT::glGetBooleanv(pname, &param);
-      return CPPToNapi(info)(static_cast<bool>(param));
+      return CPPToNapi(env)(static_cast<bool>(param));
     }
 
     case GL_COLOR_WRITEMASK: {
       std::vector<GLboolean> params(4);
       GL_EXPORT::glGetBooleanv(pname, params.data());
-      return CPPToNapi(info)(std::vector<bool>{params.begin(), params.end()});
+      return CPPToNapi(env)(std::vector<bool>{params.begin(), params.end()});
     }
 
     case GL_ARRAY_BUFFER_BINDING:
@@ -1060,7 +1291,7 @@ Napi::Value WebGL2RenderingContext::GetParameter(Napi::CallbackInfo const& info)
     case GL_TEXTURE_BINDING_CUBE_MAP: {
       GLint params{};
       GL_EXPORT::glGetIntegerv(pname, &params);
-      return CPPToNapi(info)(params);
+      return CPPToNapi(env)(params);
     }
 
     case GL_DEPTH_CLEAR_VALUE:
@@ -1070,63 +1301,79 @@ Napi::Value WebGL2RenderingContext::GetParameter(Napi::CallbackInfo const& info)
     case GL_SAMPLE_COVERAGE_VALUE: {
       GLfloat param{};
       GL_EXPORT::glGetFloatv(pname, &param);
-      return CPPToNapi(info)(param);
+      return CPPToNapi(env)(param);
     }
 
     case GL_SHADING_LANGUAGE_VERSION:
     case GL_VERSION:
     case GL_EXTENSIONS: {
       auto str = GL_EXPORT::glGetString(pname);
-      if (str == NULL) { return info.Env().Null(); }
-      return CPPToNapi(info)("WebGL " + std::string{reinterpret_cast<const GLchar*>(str)});
+      if (str == NULL) { return env.Null(); }
+      return CPPToNapi(env)("WebGL " + std::string{reinterpret_cast<const GLchar*>(str)});
     }
 
     case GL_MAX_VIEWPORT_DIMS: {
-      auto buf = Napi::ArrayBuffer::New(info.Env(), 2 * sizeof(GLint));
+      auto buf = Napi::ArrayBuffer::New(env, 2 * sizeof(GLint));
       GL_EXPORT::glGetIntegerv(pname, static_cast<GLint*>(buf.Data()));
-      return Napi::Int32Array::New(info.Env(), 2, buf, 0);
+      return Napi::Int32Array::New(env, 2, buf, 0);
     }
 
     case GL_VIEWPORT:
     case GL_SCISSOR_BOX: {
-      auto buf = Napi::ArrayBuffer::New(info.Env(), 4 * sizeof(GLint));
+      auto buf = Napi::ArrayBuffer::New(env, 4 * sizeof(GLint));
       GL_EXPORT::glGetIntegerv(pname, static_cast<GLint*>(buf.Data()));
-      return Napi::Int32Array::New(info.Env(), 4, buf, 0);
+      return Napi::Int32Array::New(env, 4, buf, 0);
     }
 
     case GL_DEPTH_RANGE:
     case GL_ALIASED_LINE_WIDTH_RANGE:
     case GL_ALIASED_POINT_SIZE_RANGE: {
-      auto buf = Napi::ArrayBuffer::New(info.Env(), 2 * sizeof(GLfloat));
+      auto buf = Napi::ArrayBuffer::New(env, 2 * sizeof(GLfloat));
       GL_EXPORT::glGetFloatv(pname, static_cast<GLfloat*>(buf.Data()));
-      return Napi::Float32Array::New(info.Env(), 2, buf, 0);
+      return Napi::Float32Array::New(env, 2, buf, 0);
     }
 
     case GL_BLEND_COLOR:
     case GL_COLOR_CLEAR_VALUE: {
-      auto buf = Napi::ArrayBuffer::New(info.Env(), 4 * sizeof(GLfloat));
+      auto buf = Napi::ArrayBuffer::New(env, 4 * sizeof(GLfloat));
       GL_EXPORT::glGetFloatv(pname, static_cast<GLfloat*>(buf.Data()));
-      return Napi::Float32Array::New(info.Env(), 4, buf, 0);
+      return Napi::Float32Array::New(env, 4, buf, 0);
     }
 
     default: {
       GLint params{};
       GL_EXPORT::glGetIntegerv(pname, &params);
-      return CPPToNapi(info)(params);
+      return CPPToNapi(env)(params);
     }
   }
 }
 
-// GL_EXPORT const GLubyte * glGetString (GL_EXTENSIONS);
+// GL_EXPORT const GLubyte * glGetStringi (GL_EXTENSIONS, GLuint index);
 Napi::Value WebGL2RenderingContext::GetSupportedExtensions(Napi::CallbackInfo const& info) {
-  CallbackArgs args = info;
-  auto str          = reinterpret_cast<const GLchar*>(GL_EXPORT::glGetString(GL_EXTENSIONS));
-  if (str == NULL) { return info.Env().Null(); }
-  auto iss   = std::istringstream{str};
-  auto begin = std::istream_iterator<std::string>{iss};
-  auto end   = std::istream_iterator<std::string>{};
-  std::vector<std::string> extensions{begin, end};
-  return CPPToNapi(info)(extensions);
+  if (!supported_extensions_.IsEmpty()) { return supported_extensions_.Value(); }
+  // Core profiles only list their extensions one at a time
+  GLint count{};
+  GL_EXPORT::glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  std::vector<std::string> extensions;
+  for (GLint i = 0; i < count; ++i) {
+    auto ext = GL_EXPORT::glGetStringi(GL_EXTENSIONS, i);
+    if (ext != NULL) { extensions.emplace_back(reinterpret_cast<const GLchar*>(ext)); }
+  }
+  if (count == 0) {
+    // GL_EXPORT const GLubyte * glGetString (GL_EXTENSIONS);
+    auto str = reinterpret_cast<const GLchar*>(GL_EXPORT::glGetString(GL_EXTENSIONS));
+    if (str == NULL) { return info.Env().Null(); }
+    auto iss   = std::istringstream{str};
+    auto begin = std::istream_iterator<std::string>{iss};
+    auto end   = std::istream_iterator<std::string>{};
+    extensions.assign(begin, end);
+  }
+  // The list can't change, so build the array once. It's frozen, since every call shares it.
+  auto array  = CPPToNapi(info)(extensions).As<Napi::Object>();
+  auto freeze = info.Env().Global().Get("Object").As<Napi::Object>().Get("freeze");
+  freeze.As<Napi::Function>().Call({array});
+  supported_extensions_ = Napi::Persistent(array);
+  return array;
 }
 
 // GL_EXPORT void glHint (GLenum target, GLenum mode);
@@ -1139,7 +1386,9 @@ Napi::Value WebGL2RenderingContext::Hint(Napi::CallbackInfo const& info) {
 // GL_EXPORT GLboolean glIsEnabled (GLenum cap);
 Napi::Value WebGL2RenderingContext::IsEnabled(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  auto enabled      = GL_EXPORT::glIsEnabled(args[0]);
+  bool cached{};
+  if (state_->IsEnabled(args[0], cached)) { return CPPToNapi(info.Env())(cached); }
+  auto enabled = GL_EXPORT::glIsEnabled(args[0]);
   return CPPToNapi(info.Env())(enabled);
 }
 
@@ -1201,7 +1450,11 @@ Napi::Value WebGL2RenderingContext::Scissor(Napi::CallbackInfo const& info) {
 // GL_EXPORT void glViewport (GLint x, GLint y, GLsizei width, GLsizei height);
 Napi::Value WebGL2RenderingContext::Viewport(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glViewport(args[0], args[1], args[2], args[3]);
+  GLint x           = args[0];
+  GLint y           = args[1];
+  GLsizei width     = args[2];
+  GLsizei height    = args[3];
+  state_->SetViewport(x, y, width, height, [&] { GL_EXPORT::glViewport(x, y, width, height); });
   return info.Env().Undefined();
 }
 
@@ -1227,8 +1480,28 @@ Napi::Value WebGL2RenderingContext::GetFragDataLocation(Napi::CallbackInfo const
   return CPPToNapi(info)(GL_EXPORT::glGetFragDataLocation(args[0], name.data()));
 }
 
+// A shallow copy of the attributes filled in at creation, so callers can't change later answers
 Napi::Value WebGL2RenderingContext::GetContextAttributes(Napi::CallbackInfo const& info) {
-  return this->context_attributes_.Value();
+  auto attrs = this->context_attributes_.Value();
+  auto copy  = Napi::Object::New(info.Env());
+  auto keys  = attrs.GetPropertyNames();
+  for (uint32_t i = 0; i < keys.Length(); ++i) {
+    auto key = keys.Get(i);
+    copy.Set(key, attrs.Get(key));
+  }
+  return copy;
+}
+
+Napi::Value WebGL2RenderingContext::GetStateCacheStats(Napi::CallbackInfo const& info) {
+  auto stats = Napi::Object::New(info.Env());
+  stats.Set("issued", CPPToNapi(info.Env())(state_->stats.issued));
+  stats.Set("elided", CPPToNapi(info.Env())(state_->stats.elided));
+  return stats;
+}
+
+Napi::Value WebGL2RenderingContext::InvalidateStateCache(Napi::CallbackInfo const& info) {
+  state_->Invalidate();
+  return info.Env().Undefined();
 }
 
 Napi::Value WebGL2RenderingContext::GetClearMask_(Napi::CallbackInfo const& info) {
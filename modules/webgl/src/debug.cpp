@@ -0,0 +1,85 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "macros.hpp"
+#include "webgl.hpp"
+
+#include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/cpp_to_napi.hpp>
+
+namespace nv {
+
+namespace {
+
+// The most messages kept between getDebugMessages() calls. Older messages are dropped.
+constexpr size_t max_debug_messages = 1024;
+
+// Templated on the context's (private) DebugLog
+template <typename DebugLog>
+void GLAPIENTRY log_debug_message(GLenum source,
+                                  GLenum type,
+                                  GLuint id,
+                                  GLenum severity,
+                                  GLsizei length,
+                                  const GLchar* message,
+                                  const void* user_param) {
+  auto log = static_cast<DebugLog*>(const_cast<void*>(user_param));
+  std::lock_guard<std::mutex> lock(log->mutex);
+  if (log->messages.size() == max_debug_messages) {
+    log->messages.pop_front();
+    ++log->dropped;
+  }
+  auto text = length < 0 ? std::string(message) : std::string(message, length);
+  log->messages.push_back({source, type, id, severity, std::move(text)});
+}
+
+}  // namespace
+
+// Messages are logged without GL_DEBUG_OUTPUT_SYNCHRONOUS, so the driver isn't serialized to
+// report them. Notifications (buffer placement, shader recompiles, ...) are filtered out in the
+// driver, so they don't crowd errors and warnings out of the log.
+void WebGL2RenderingContext::InstallDebugLog() {
+  debug_log_.reset(new DebugLog);
+  GL_EXPORT::glEnable(GL_DEBUG_OUTPUT);
+  GL_EXPORT::glDebugMessageControl(
+    GL_DONT_CARE, GL_DONT_CARE, GL_DEBUG_SEVERITY_NOTIFICATION, 0, nullptr, GL_FALSE);
+  GL_EXPORT::glDebugMessageCallback(log_debug_message<DebugLog>, debug_log_.get());
+}
+
+Napi::Value WebGL2RenderingContext::GetDebugMessages(Napi::CallbackInfo const& info) {
+  auto env    = info.Env();
+  auto result = Napi::Object::New(env);
+  std::deque<DebugMessage> messages;
+  uint32_t dropped{};
+  if (debug_log_ != nullptr) {
+    std::lock_guard<std::mutex> lock(debug_log_->mutex);
+    messages.swap(debug_log_->messages);
+    std::swap(dropped, debug_log_->dropped);
+  }
+  auto list = Napi::Array::New(env, messages.size());
+  for (size_t i = 0; i < messages.size(); ++i) {
+    auto entry = Napi::Object::New(env);
+    entry.Set("source", CPPToNapi(env)(messages[i].source));
+    entry.Set("type", CPPToNapi(env)(messages[i].type));
+    entry.Set("id", CPPToNapi(env)(messages[i].id));
+    entry.Set("severity", CPPToNapi(env)(messages[i].severity));
+    entry.Set("message", CPPToNapi(env)(messages[i].message));
+    list.Set(i, entry);
+  }
+  result.Set("messages", list);
+  result.Set("dropped", CPPToNapi(env)(dropped));
+  return result;
+}
+
+}  // namespace nv
@@ -46,7 +46,7 @@ Napi::Value WebGL2RenderingContext::CreateFramebuffers(Napi::CallbackInfo const&
   CallbackArgs args = info;
   std::vector<GLuint> framebuffers(args[0].operator size_t());
   GL_EXPORT::glCreateFramebuffers(framebuffers.size(), framebuffers.data());
-  return CPPToNapi(info)(framebuffers);
+  return CPPToNapi(info)(ExternalArray<GLuint>(std::move(framebuffers)));
 }
 
 // GL_EXPORT void glDeleteFramebuffers (GLsizei n, const GLuint* framebuffers);
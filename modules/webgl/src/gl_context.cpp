@@ -0,0 +1,71 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "gl_context.hpp"
+
+#include <dlfcn.h>
+
+namespace nv {
+
+namespace {
+
+// GLX is looked up at runtime, since only GLFW links it
+void* glx_current_context() {
+  using GetCurrentContext = void* (*)();
+  static auto get_current_context =
+    reinterpret_cast<GetCurrentContext>(dlsym(RTLD_DEFAULT, "glXGetCurrentContext"));
+  return get_current_context ? get_current_context() : nullptr;
+}
+
+}  // namespace
+
+GLContext GLContext::Current() {
+  GLContext context{};
+  context.egl_context_ = eglGetCurrentContext();
+  if (context.egl_context_ != EGL_NO_CONTEXT) {
+    context.egl_display_ = eglGetCurrentDisplay();
+    context.egl_draw_    = eglGetCurrentSurface(EGL_DRAW);
+    context.egl_read_    = eglGetCurrentSurface(EGL_READ);
+  } else {
+    context.glx_context_ = glx_current_context();
+  }
+  return context;
+}
+
+ScopedCurrent::ScopedCurrent(GLContext const& context) : previous_(GLContext::Current()) {
+  if (context.id() == nullptr) { return; }
+  if (previous_.id() == context.id()) {
+    current_ = true;
+  } else if (context.egl_context_ != EGL_NO_CONTEXT) {
+    current_ = switched_ = eglMakeCurrent(context.egl_display_,
+                                          context.egl_draw_,
+                                          context.egl_read_,
+                                          context.egl_context_) == EGL_TRUE;
+  }
+}
+
+ScopedCurrent::~ScopedCurrent() {
+  if (!switched_) { return; }
+  if (previous_.egl_context_ != EGL_NO_CONTEXT) {
+    eglMakeCurrent(previous_.egl_display_,
+                   previous_.egl_draw_,
+                   previous_.egl_read_,
+                   previous_.egl_context_);
+  } else {
+    auto display = eglGetCurrentDisplay();
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  }
+}
+
+}  // namespace nv
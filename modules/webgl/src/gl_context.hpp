@@ -0,0 +1,63 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <EGL/egl.h>
+
+namespace nv {
+
+// The GL context current on a thread when it was captured, so timers and finalizers can make the
+// context they belong to current again. Contexts are EGL's (HeadlessContext, GLFW built for EGL)
+// or GLX's (GLFW).
+class GLContext {
+ public:
+  // The context current on this thread
+  static GLContext Current();
+
+  // Identifies the context, or null if no EGL or GLX context was current
+  inline void* id() const { return egl_context_ != EGL_NO_CONTEXT ? egl_context_ : glx_context_; }
+
+ private:
+  friend class ScopedCurrent;
+
+  EGLDisplay egl_display_{EGL_NO_DISPLAY};
+  EGLSurface egl_draw_{EGL_NO_SURFACE};
+  EGLSurface egl_read_{EGL_NO_SURFACE};
+  EGLContext egl_context_{EGL_NO_CONTEXT};
+  void* glx_context_{};
+};
+
+// Makes `context` current until it goes out of scope, then makes the context that was current
+// before current again. An EGL context that's been destroyed can't be made current. A GLX context
+// is only used if it's already current, since making a GLX context whose window is gone current
+// is an X error.
+class ScopedCurrent {
+ public:
+  explicit ScopedCurrent(GLContext const& context);
+  ~ScopedCurrent();
+
+  ScopedCurrent(ScopedCurrent const&) = delete;
+  ScopedCurrent& operator=(ScopedCurrent const&) = delete;
+
+  // Whether `context` is current, so GL calls can be made against it
+  inline explicit operator bool() const { return current_; }
+
+ private:
+  GLContext previous_;
+  bool current_{false};
+  bool switched_{false};
+};
+
+}  // namespace nv
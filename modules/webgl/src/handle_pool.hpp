@@ -0,0 +1,107 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "gl.hpp"
+
+#include <napi.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+namespace nv {
+
+// GL names generated ahead of use, `batch` at a time, so creating an object doesn't call into the
+// driver each time. The context deletes the names left in the pool when it's destroyed.
+class NamePool {
+ public:
+  using Generator = void (*)(GLsizei, GLuint*);
+  using Deleter   = void (*)(GLsizei, GLuint const*);
+
+  explicit NamePool(Generator generate) : generate_(generate) {}
+
+  inline GLuint Take() {
+    if (names_.empty()) { Generate(batch); }
+    auto name = names_.back();
+    names_.pop_back();
+    return name;
+  }
+
+  // `n` names, generating the ones the pool doesn't have in one call
+  inline std::vector<GLuint> Take(size_t n) {
+    if (names_.size() < n) { Generate(n - names_.size()); }
+    std::vector<GLuint> names(names_.end() - n, names_.end());
+    names_.resize(names_.size() - n);
+    std::reverse(names.begin(), names.end());
+    return names;
+  }
+
+  // Hand `name` out again. Only for names whose objects can be reused as they are (e.g. queries).
+  inline void Give(GLuint name) { names_.push_back(name); }
+
+  // Delete the names the pool hasn't handed out. Call with the context current.
+  inline void Free(Deleter remove) {
+    if (!names_.empty()) { remove(names_.size(), names_.data()); }
+    names_.clear();
+  }
+
+ private:
+  static constexpr GLsizei batch = 64;
+
+  // Add `n` names, handed out in the order they were generated
+  inline void Generate(size_t n) {
+    std::vector<GLuint> names(n);
+    generate_(names.size(), names.data());
+    names_.insert(names_.begin(), names.rbegin(), names.rend());
+  }
+
+  Generator generate_;
+  std::vector<GLuint> names_;
+};
+
+// The JS wrappers of recycled objects, pointed at new objects instead of allocating a wrapper per
+// object. Particle systems and per-frame queries churn through thousands of them, and each one
+// would otherwise be garbage.
+//
+// Only the recycle*() calls feed the pool, never delete*(): a recycled wrapper is handed out again
+// by a later create*(), so whatever still holds it (or caches state keyed on it) would silently
+// see the new object. Callers opt in per object, once nothing else holds it.
+template <typename Wrapper>
+class WrapperPool {
+ public:
+  // The most wrappers kept for reuse
+  static constexpr size_t capacity = 1024;
+
+  template <typename Value>
+  inline Napi::Object Wrap(Value value) {
+    if (wrappers_.empty()) { return Wrapper::New(value); }
+    auto object = wrappers_.back().Value();
+    wrappers_.pop_back();
+    Wrapper::Unwrap(object)->Reset(value);
+    return object;
+  }
+
+  // Clear `object`, a Wrapper whose object was just released, and keep it for Wrap()
+  inline void Recycle(Napi::Object const& object) {
+    Wrapper::Unwrap(object)->Reset({});
+    if (wrappers_.size() < capacity) { wrappers_.push_back(Napi::Persistent(object)); }
+  }
+
+ private:
+  std::vector<Napi::ObjectReference> wrappers_;
+};
+
+}  // namespace nv
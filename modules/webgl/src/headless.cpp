@@ -0,0 +1,236 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "headless.hpp"
+
+#include <nv_node/utilities/cpp_to_napi.hpp>
+#include <nv_node/utilities/trace.hpp>
+
+#include <EGL/eglext.h>
+
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#define EGL_THROW(env, code) NAPI_THROW(egl_error(env, code, __FILE__, __LINE__), (e).Undefined())
+
+namespace nv {
+
+namespace {
+
+inline Napi::Error egl_error(Napi::Env const& env,
+                             EGLint code,
+                             const char* file,
+                             const uint32_t line) {
+  std::ostringstream msg;
+  msg << "EGL error 0x" << std::hex << code << std::dec << "\n    at " << file << ":" << line;
+  return Napi::Error::New(env, msg.str());
+}
+
+inline bool has_extension(const char* extensions, const char* name) {
+  if (extensions == nullptr) { return false; }
+  auto len = std::strlen(name);
+  for (auto ext = std::strstr(extensions, name); ext != nullptr; ext = std::strstr(ext + 1, name)) {
+    if ((ext == extensions || ext[-1] == ' ') && (ext[len] == ' ' || ext[len] == '\0')) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename T>
+inline T egl_proc(const char* name) {
+  return reinterpret_cast<T>(eglGetProcAddress(name));
+}
+
+// The display of device `device`, or of the first software device if `software`. Falls back to
+// Mesa's surfaceless platform if the devices can't be enumerated.
+EGLDisplay open_display(int32_t& device, bool& software) {
+  auto client = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+  if (!has_extension(client, "EGL_EXT_platform_base")) { return EGL_NO_DISPLAY; }
+  auto get_platform_display =
+    egl_proc<PFNEGLGETPLATFORMDISPLAYEXTPROC>("eglGetPlatformDisplayEXT");
+
+  if (has_extension(client, "EGL_EXT_device_enumeration") &&
+      has_extension(client, "EGL_EXT_platform_device")) {
+    auto query_devices = egl_proc<PFNEGLQUERYDEVICESEXTPROC>("eglQueryDevicesEXT");
+    auto query_string  = egl_proc<PFNEGLQUERYDEVICESTRINGEXTPROC>("eglQueryDeviceStringEXT");
+    EGLint count{};
+    query_devices(0, nullptr, &count);
+    std::vector<EGLDeviceEXT> devices(count);
+    query_devices(count, devices.data(), &count);
+    for (EGLint i = 0; i < count; ++i) {
+      auto is_software =
+        has_extension(query_string(devices[i], EGL_EXTENSIONS), "EGL_MESA_device_software");
+      if (software ? !is_software : i != device) { continue; }
+      auto display = get_platform_display(EGL_PLATFORM_DEVICE_EXT, devices[i], nullptr);
+      if (display != EGL_NO_DISPLAY) {
+        device   = i;
+        software = is_software;
+        return display;
+      }
+    }
+  }
+
+  if (has_extension(client, "EGL_MESA_platform_surfaceless") && (software || device == 0)) {
+    device = -1;
+    return get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+  }
+  return EGL_NO_DISPLAY;
+}
+
+}  // namespace
+
+ConstructorReference HeadlessContext::constructor;
+
+HeadlessContext::HeadlessContext(Napi::CallbackInfo const& info)
+  : Napi::ObjectWrap<HeadlessContext>(info) {
+  auto opts = info[0].IsObject() ? info[0].As<Napi::Object>() : Napi::Object::New(info.Env());
+  auto int_opt = [&](const char* name, int32_t default_value) {
+    return opts.Get(name).IsNumber() ? opts.Get(name).ToNumber().Int32Value() : default_value;
+  };
+  width_    = int_opt("width", 1);
+  height_   = int_opt("height", 1);
+  device_   = int_opt("device", 0);
+  software_ = opts.Get("software").ToBoolean().Value();
+  if (width_ <= 0 || height_ <= 0 || device_ < 0) { EGL_THROW(info.Env(), EGL_BAD_PARAMETER); }
+
+  display_ = open_display(device_, software_);
+  if (display_ == EGL_NO_DISPLAY) { EGL_THROW(info.Env(), EGL_BAD_DEVICE_EXT); }
+  // Displays are shared by every context on the device, so they're never terminated
+  if (!eglInitialize(display_, nullptr, nullptr) || !eglBindAPI(EGL_OPENGL_API)) {
+    EGL_THROW(info.Env(), eglGetError());
+  }
+
+  EGLint config_attribs[]        = {EGL_SURFACE_TYPE,
+                                    EGL_PBUFFER_BIT,
+                                    EGL_RENDERABLE_TYPE,
+                                    EGL_OPENGL_BIT,
+                                    EGL_RED_SIZE,
+                                    8,
+                                    EGL_GREEN_SIZE,
+                                    8,
+                                    EGL_BLUE_SIZE,
+                                    8,
+                                    EGL_ALPHA_SIZE,
+                                    8,
+                                    EGL_DEPTH_SIZE,
+                                    24,
+                                    EGL_STENCIL_SIZE,
+                                    8,
+                                    EGL_NONE};
+  EGLint const context_attribs[] = {EGL_CONTEXT_MAJOR_VERSION,
+                                    4,
+                                    EGL_CONTEXT_MINOR_VERSION,
+                                    5,
+                                    EGL_CONTEXT_OPENGL_PROFILE_MASK,
+                                    EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+                                    EGL_NONE};
+  EGLint const surface_attribs[] = {EGL_WIDTH, width_, EGL_HEIGHT, height_, EGL_NONE};
+
+  EGLConfig config{};
+  EGLint count{};
+  bool pbuffer = eglChooseConfig(display_, config_attribs, &config, 1, &count) && count > 0;
+  if (!pbuffer) {
+    // Without pbuffers, draw to framebuffer objects in a surfaceless context
+    config_attribs[1] = 0;
+    if (!has_extension(eglQueryString(display_, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context") ||
+        !eglChooseConfig(display_, config_attribs, &config, 1, &count) || count == 0) {
+      EGL_THROW(info.Env(), EGL_BAD_CONFIG);
+    }
+  }
+
+  context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT, context_attribs);
+  if (context_ == EGL_NO_CONTEXT) { EGL_THROW(info.Env(), eglGetError()); }
+  if (pbuffer) {
+    surface_ = eglCreatePbufferSurface(display_, config, surface_attribs);
+    if (surface_ == EGL_NO_SURFACE) {
+      auto code = eglGetError();
+      destroy();
+      EGL_THROW(info.Env(), code);
+    }
+  }
+  if (!eglMakeCurrent(display_, surface_, surface_, context_)) {
+    auto code = eglGetError();
+    destroy();
+    EGL_THROW(info.Env(), code);
+  }
+}
+
+HeadlessContext::~HeadlessContext() { destroy(); }
+
+Napi::Object HeadlessContext::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function ctor = DefineClass(
+    env,
+    "HeadlessContext",
+    {
+      InstanceAccessor("width", &HeadlessContext::GetWidth, nullptr, napi_enumerable),
+      InstanceAccessor("height", &HeadlessContext::GetHeight, nullptr, napi_enumerable),
+      InstanceAccessor("device", &HeadlessContext::GetDevice, nullptr, napi_enumerable),
+      InstanceAccessor("software", &HeadlessContext::GetSoftware, nullptr, napi_enumerable),
+      trace::InstanceMethod(env, "HeadlessContext", "makeCurrent", &HeadlessContext::MakeCurrent),
+      trace::InstanceMethod(env, "HeadlessContext", "isCurrent", &HeadlessContext::IsCurrent),
+      trace::InstanceMethod(env, "HeadlessContext", "destroy", &HeadlessContext::Destroy),
+    });
+  HeadlessContext::constructor = Napi::Persistent(ctor);
+  exports.Set("HeadlessContext", ctor);
+  return exports;
+};
+
+void HeadlessContext::destroy() {
+  if (context_ != EGL_NO_CONTEXT && eglGetCurrentContext() == context_) {
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+  }
+  if (surface_ != EGL_NO_SURFACE) { eglDestroySurface(display_, surface_); }
+  if (context_ != EGL_NO_CONTEXT) { eglDestroyContext(display_, context_); }
+  surface_ = EGL_NO_SURFACE;
+  context_ = EGL_NO_CONTEXT;
+}
+
+Napi::Value HeadlessContext::MakeCurrent(Napi::CallbackInfo const& info) {
+  if (context_ == EGL_NO_CONTEXT) { EGL_THROW(info.Env(), EGL_BAD_CONTEXT); }
+  if (eglGetCurrentContext() != context_ &&
+      !eglMakeCurrent(display_, surface_, surface_, context_)) {
+    EGL_THROW(info.Env(), eglGetError());
+  }
+  return info.Env().Undefined();
+}
+
+Napi::Value HeadlessContext::IsCurrent(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(context_ != EGL_NO_CONTEXT && eglGetCurrentContext() == context_);
+}
+
+// Destroy the context and its pbuffer. Releases the context first if it's current.
+Napi::Value HeadlessContext::Destroy(Napi::CallbackInfo const& info) {
+  destroy();
+  return info.Env().Undefined();
+}
+
+Napi::Value HeadlessContext::GetWidth(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(width_);
+}
+
+Napi::Value HeadlessContext::GetHeight(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(height_);
+}
+
+Napi::Value HeadlessContext::GetDevice(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(device_);
+}
+
+Napi::Value HeadlessContext::GetSoftware(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(software_);
+}
+
+}  // namespace nv
@@ -0,0 +1,66 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "gl.hpp"
+
+#include <nv_node/utilities/args.hpp>
+
+#include <EGL/egl.h>
+#include <napi.h>
+
+namespace nv {
+
+// An OpenGL 4.5 core context created through EGL, without a window system. It draws to a pbuffer
+// of `width` x `height`, or to no default framebuffer at all if the device has no pbuffer configs.
+//
+// new HeadlessContext({width = 1, height = 1, device = 0, software = false})
+//
+// `device` indexes the EGL devices, and `software` picks the first software (llvmpipe) device
+// instead. The context is current once constructed. Every context is separate, so a process can
+// have as many as it likes, and must makeCurrent() the one it's about to draw with.
+class HeadlessContext : public Napi::ObjectWrap<HeadlessContext> {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  HeadlessContext(Napi::CallbackInfo const& info);
+  ~HeadlessContext();
+
+ private:
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
+
+  Napi::Value MakeCurrent(Napi::CallbackInfo const& info);
+  Napi::Value IsCurrent(Napi::CallbackInfo const& info);
+  Napi::Value Destroy(Napi::CallbackInfo const& info);
+  Napi::Value GetWidth(Napi::CallbackInfo const& info);
+  Napi::Value GetHeight(Napi::CallbackInfo const& info);
+  Napi::Value GetDevice(Napi::CallbackInfo const& info);
+  Napi::Value GetSoftware(Napi::CallbackInfo const& info);
+
+  void destroy();
+
+  EGLDisplay display_{EGL_NO_DISPLAY};
+  EGLSurface surface_{EGL_NO_SURFACE};
+  EGLContext context_{EGL_NO_CONTEXT};
+  int32_t width_{};
+  int32_t height_{};
+  // The index of the EGL device, or -1 for Mesa's surfaceless platform
+  int32_t device_{-1};
+  bool software_{};
+};
+
+}  // namespace nv
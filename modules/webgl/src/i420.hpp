@@ -0,0 +1,80 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nv {
+
+// RGBA8 to I420 (planar YUV 4:2:0) with the BT.601 limited-range coefficients that video encoders
+// expect. The loops are branch-free fixed-point arithmetic on restrict pointers, so the compiler
+// vectorizes them. Runs on CPU threads, and doesn't touch GL.
+
+namespace detail {
+
+inline void i420_luma_row(uint8_t const* __restrict rgba, int32_t width, uint8_t* __restrict y) {
+  for (int32_t x = 0; x < width; ++x) {
+    int32_t r = rgba[4 * x + 0];
+    int32_t g = rgba[4 * x + 1];
+    int32_t b = rgba[4 * x + 2];
+    y[x]      = static_cast<uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+  }
+}
+
+// One row of U and V from the average of each 2x2 block of the rows `top` and `bottom`
+inline void i420_chroma_row(uint8_t const* __restrict top,
+                            uint8_t const* __restrict bottom,
+                            int32_t width,
+                            uint8_t* __restrict u,
+                            uint8_t* __restrict v) {
+  for (int32_t x = 0; x < width / 2; ++x) {
+    int32_t r = (top[8 * x + 0] + top[8 * x + 4] + bottom[8 * x + 0] + bottom[8 * x + 4] + 2) >> 2;
+    int32_t g = (top[8 * x + 1] + top[8 * x + 5] + bottom[8 * x + 1] + bottom[8 * x + 5] + 2) >> 2;
+    int32_t b = (top[8 * x + 2] + top[8 * x + 6] + bottom[8 * x + 2] + bottom[8 * x + 6] + 2) >> 2;
+    u[x]      = static_cast<uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+    v[x]      = static_cast<uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+  }
+}
+
+}  // namespace detail
+
+// The size of a `width` x `height` I420 frame: a full-size Y plane, then quarter-size U and V
+inline size_t i420_size(int32_t width, int32_t height) {
+  return static_cast<size_t>(width) * height * 3 / 2;
+}
+
+// Convert tightly packed `width` x `height` RGBA pixels into `i420`, which holds i420_size() bytes.
+// `width` and `height` must be even. `flip_y` reads the rows bottom-up, as glReadPixels() writes
+// them.
+inline void rgba_to_i420(
+  uint8_t const* rgba, int32_t width, int32_t height, bool flip_y, uint8_t* i420) {
+  auto const stride = static_cast<size_t>(width) * 4;
+  auto const chroma = static_cast<size_t>(width / 2);
+  auto y_plane      = i420;
+  auto u_plane      = y_plane + static_cast<size_t>(width) * height;
+  auto v_plane      = u_plane + chroma * (height / 2);
+  auto row          = [&](int32_t y) { return rgba + (flip_y ? height - 1 - y : y) * stride; };
+  for (int32_t y = 0; y < height; y += 2) {
+    auto top    = row(y);
+    auto bottom = row(y + 1);
+    detail::i420_luma_row(top, width, y_plane + y * static_cast<size_t>(width));
+    detail::i420_luma_row(bottom, width, y_plane + (y + 1) * static_cast<size_t>(width));
+    detail::i420_chroma_row(
+      top, bottom, width, u_plane + (y / 2) * chroma, v_plane + (y / 2) * chroma);
+  }
+}
+
+}  // namespace nv
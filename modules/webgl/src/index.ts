@@ -13,3 +13,6 @@
 // limitations under the License.
 
 export * from './webgl';
+export * from './recording';
+export * from './capture';
+export * from './texture-upload';
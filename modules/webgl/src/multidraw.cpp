@@ -0,0 +1,143 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "macros.hpp"
+#include "webgl.hpp"
+
+#include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/cpp_to_napi.hpp>
+
+#include <algorithm>
+
+namespace nv {
+
+namespace {
+
+// The number of draws: `info[index]` if passed, else the length of the shortest list. Throws if
+// it's more than the lists hold.
+inline GLsizei draw_count(Napi::CallbackInfo const& info,
+                          size_t index,
+                          std::initializer_list<size_t> list_sizes) {
+  auto shortest = std::min(list_sizes);
+  if (!info[index].IsNumber()) { return shortest; }
+  auto count = info[index].ToNumber().Int64Value();
+  if (count < 0 || static_cast<size_t>(count) > shortest) {
+    GLEW_THROW(info.Env(), GL_INVALID_VALUE);
+  }
+  return count;
+}
+
+// The indirect buffer offset, for glDraw*Indirect()'s `indirect` pointer
+inline const void* indirect_offset(NapiToCPP const& arg) {
+  return reinterpret_cast<const void*>(static_cast<GLintptr>(arg.operator int64_t()));
+}
+
+}  // namespace
+
+// GL_EXPORT void glMultiDrawArrays (GLenum mode, const GLint* first, const GLsizei *count, GLsizei
+// drawcount);
+Napi::Value WebGL2RenderingContext::MultiDrawArrays(Napi::CallbackInfo const& info) {
+  CallbackArgs args    = info;
+  GLenum mode          = args[0];
+  Span<GLint> firsts   = args[1];
+  Span<GLsizei> counts = args[2];
+  GLsizei drawcount    = draw_count(info, 3, {firsts.size(), counts.size()});
+  GL_EXPORT::glMultiDrawArrays(mode, firsts.data(), counts.data(), drawcount);
+  return info.Env().Undefined();
+}
+
+// GL_EXPORT void glMultiDrawElements (GLenum mode, const GLsizei* count, GLenum type, const void
+// *const* indices, GLsizei drawcount);
+Napi::Value WebGL2RenderingContext::MultiDrawElements(Napi::CallbackInfo const& info) {
+  CallbackArgs args    = info;
+  GLenum mode          = args[0];
+  Span<GLsizei> counts = args[1];
+  GLenum type          = args[2];
+  Span<GLint> offsets  = args[3];
+  GLsizei drawcount    = draw_count(info, 4, {counts.size(), offsets.size()});
+  // The offsets are byte offsets into the element array buffer
+  std::vector<const void*> indices(drawcount);
+  std::transform(offsets.data(), offsets.data() + drawcount, indices.begin(), [](GLint offset) {
+    return reinterpret_cast<const void*>(static_cast<GLintptr>(offset));
+  });
+  GL_EXPORT::glMultiDrawElements(mode, counts.data(), type, indices.data(), drawcount);
+  return info.Env().Undefined();
+}
+
+// GL has no multi-draw of instanced draws outside of indirect buffers, but looping here still
+// saves a call into native code per draw.
+Napi::Value WebGL2RenderingContext::MultiDrawArraysInstanced(Napi::CallbackInfo const& info) {
+  CallbackArgs args             = info;
+  GLenum mode                   = args[0];
+  Span<GLint> firsts            = args[1];
+  Span<GLsizei> counts          = args[2];
+  Span<GLsizei> instance_counts = args[3];
+
+  GLsizei drawcount = draw_count(info, 4, {firsts.size(), counts.size(), instance_counts.size()});
+  for (GLsizei i = 0; i < drawcount; ++i) {
+    GL_EXPORT::glDrawArraysInstanced(mode, firsts[i], counts[i], instance_counts[i]);
+  }
+  return info.Env().Undefined();
+}
+
+Napi::Value WebGL2RenderingContext::MultiDrawElementsInstanced(Napi::CallbackInfo const& info) {
+  CallbackArgs args             = info;
+  GLenum mode                   = args[0];
+  Span<GLsizei> counts          = args[1];
+  GLenum type                   = args[2];
+  Span<GLint> offsets           = args[3];
+  Span<GLsizei> instance_counts = args[4];
+
+  GLsizei drawcount = draw_count(info, 5, {counts.size(), offsets.size(), instance_counts.size()});
+  for (GLsizei i = 0; i < drawcount; ++i) {
+    auto indices = reinterpret_cast<const void*>(static_cast<GLintptr>(offsets[i]));
+    GL_EXPORT::glDrawElementsInstanced(mode, counts[i], type, indices, instance_counts[i]);
+  }
+  return info.Env().Undefined();
+}
+
+// GL_EXPORT void glDrawArraysIndirect (GLenum mode, const void *indirect);
+Napi::Value WebGL2RenderingContext::DrawArraysIndirect(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  GL_EXPORT::glDrawArraysIndirect(args[0], indirect_offset(args[1]));
+  return info.Env().Undefined();
+}
+
+// GL_EXPORT void glDrawElementsIndirect (GLenum mode, GLenum type, const void *indirect);
+Napi::Value WebGL2RenderingContext::DrawElementsIndirect(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  GL_EXPORT::glDrawElementsIndirect(args[0], args[1], indirect_offset(args[2]));
+  return info.Env().Undefined();
+}
+
+// GL_EXPORT void glMultiDrawArraysIndirect (GLenum mode, const void *indirect, GLsizei primcount,
+// GLsizei stride);
+Napi::Value WebGL2RenderingContext::MultiDrawArraysIndirect(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  GLsizei stride    = info[3].IsNumber() ? args[3].operator int32_t() : 0;
+  GL_EXPORT::glMultiDrawArraysIndirect(args[0], indirect_offset(args[1]), args[2], stride);
+  return info.Env().Undefined();
+}
+
+// GL_EXPORT void glMultiDrawElementsIndirect (GLenum mode, GLenum type, const void *indirect,
+// GLsizei primcount, GLsizei stride);
+Napi::Value WebGL2RenderingContext::MultiDrawElementsIndirect(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  GLsizei stride    = info[4].IsNumber() ? args[4].operator int32_t() : 0;
+  GL_EXPORT::glMultiDrawElementsIndirect(
+    args[0], args[1], indirect_offset(args[2]), args[3], stride);
+  return info.Env().Undefined();
+}
+
+}  // namespace nv
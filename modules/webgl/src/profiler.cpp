@@ -0,0 +1,248 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "macros.hpp"
+#include "webgl.hpp"
+
+#include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/cpp_to_napi.hpp>
+#include <nv_node/utilities/trace.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace nv {
+
+namespace {
+
+// The number of queries generated at once when the pool runs out
+constexpr GLsizei query_batch = 32;
+
+// The name of the section that spans each frame
+constexpr const char* frame_section = "frame";
+
+// The nearest-rank percentile `p` of `sorted`
+inline double percentile(std::vector<double> const& sorted, double p) {
+  auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+  return sorted[std::max<size_t>(rank, 1) - 1];
+}
+
+}  // namespace
+
+ConstructorReference FrameProfiler::constructor;
+
+FrameProfiler::FrameProfiler(Napi::CallbackInfo const& info)
+  : Napi::ObjectWrap<FrameProfiler>(info) {
+  CallbackArgs args = info;
+  if (!info[0].IsObject()) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  // Throws unless it's a context
+  gl_context_ = WebGL2RenderingContext::Unwrap(info[0].As<Napi::Object>())->gl_context();
+  window_ = info[1].IsNumber() ? args[1].operator uint32_t() : 120;
+  if (window_ == 0) { GLEW_THROW(info.Env(), GL_INVALID_VALUE); }
+};
+
+FrameProfiler::~FrameProfiler() { Free(); }
+
+Napi::Object FrameProfiler::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function ctor = DefineClass(
+    env,
+    "FrameProfiler",
+    {
+      InstanceAccessor("window", &FrameProfiler::GetWindow, nullptr, napi_enumerable),
+      InstanceAccessor("pending", &FrameProfiler::GetPending, nullptr, napi_enumerable),
+      trace::InstanceMethod(env, "FrameProfiler", "beginFrame", &FrameProfiler::BeginFrame),
+      trace::InstanceMethod(env, "FrameProfiler", "endFrame", &FrameProfiler::EndFrame),
+      trace::InstanceMethod(env, "FrameProfiler", "begin", &FrameProfiler::Begin),
+      trace::InstanceMethod(env, "FrameProfiler", "end", &FrameProfiler::End),
+      trace::InstanceMethod(env, "FrameProfiler", "collect", &FrameProfiler::Collect),
+      trace::InstanceMethod(env, "FrameProfiler", "stats", &FrameProfiler::Stats),
+      trace::InstanceMethod(env, "FrameProfiler", "reset", &FrameProfiler::Reset),
+      trace::InstanceMethod(env, "FrameProfiler", "destroy", &FrameProfiler::Destroy),
+    });
+  FrameProfiler::constructor = Napi::Persistent(ctor);
+  exports.Set("FrameProfiler", ctor);
+  return exports;
+};
+
+// A query from the pool, generating more if it's empty
+GLuint FrameProfiler::query() {
+  if (pool_.empty()) {
+    pool_.resize(query_batch);
+    GL_EXPORT::glGenQueries(query_batch, pool_.data());
+  }
+  auto query = pool_.back();
+  pool_.pop_back();
+  return query;
+}
+
+// Read the timestamps of the pending frames the GPU has finished, oldest first, and add their
+// sections' times to the samples. Stops at the first frame that isn't finished, unless `wait`.
+// Returns the number of frames read.
+size_t FrameProfiler::collect(bool wait) {
+  size_t collected{0};
+  while (!pending_.empty()) {
+    auto& sections = pending_.front();
+    if (!wait) {
+      GLuint available{GL_TRUE};
+      for (auto it = sections.begin(); available && it != sections.end(); ++it) {
+        GL_EXPORT::glGetQueryObjectuiv(it->end, GL_QUERY_RESULT_AVAILABLE, &available);
+      }
+      if (!available) { break; }
+    }
+    // A section begun more than once in a frame counts the sum of its times
+    std::map<std::string, double> times;
+    for (auto const& section : sections) {
+      GLuint64 begin{}, end{};
+      GL_EXPORT::glGetQueryObjectui64v(section.begin, GL_QUERY_RESULT, &begin);
+      GL_EXPORT::glGetQueryObjectui64v(section.end, GL_QUERY_RESULT, &end);
+      times[section.name] += (end > begin ? end - begin : 0) / 1e6;
+      pool_.push_back(section.begin);
+      pool_.push_back(section.end);
+    }
+    for (auto const& time : times) {
+      auto& samples = samples_[time.first];
+      if (samples.times.size() < window_) {
+        samples.times.push_back(time.second);
+      } else {
+        samples.times[samples.next] = time.second;
+      }
+      samples.next = (samples.next + 1) % window_;
+    }
+    pending_.pop_front();
+    ++collected;
+  }
+  return collected;
+}
+
+// Start a frame. Its time is reported as the "frame" section.
+Napi::Value FrameProfiler::BeginFrame(Napi::CallbackInfo const& info) {
+  if (destroyed_ || in_frame_) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  in_frame_ = true;
+  frame_.push_back({frame_section, query(), 0});
+  GL_EXPORT::glQueryCounter(frame_.back().begin, GL_TIMESTAMP);
+  return info.Env().Undefined();
+}
+
+// End the frame, and read the frames the GPU has finished since the last call. Every section begun
+// in the frame must have ended.
+Napi::Value FrameProfiler::EndFrame(Napi::CallbackInfo const& info) {
+  if (destroyed_ || !in_frame_ || !open_.empty()) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  in_frame_ = false;
+  frame_.front().end = query();
+  GL_EXPORT::glQueryCounter(frame_.front().end, GL_TIMESTAMP);
+  pending_.push_back(std::move(frame_));
+  frame_.clear();
+  collect(false);
+  return info.Env().Undefined();
+}
+
+// Start the section `name`. Sections can nest, and the same name can be timed more than once a
+// frame.
+Napi::Value FrameProfiler::Begin(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  std::string name  = args[0];
+  if (destroyed_ || !in_frame_) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  open_.push_back(frame_.size());
+  frame_.push_back({name, query(), 0});
+  GL_EXPORT::glQueryCounter(frame_.back().begin, GL_TIMESTAMP);
+  return info.Env().Undefined();
+}
+
+// End the section begun last
+Napi::Value FrameProfiler::End(Napi::CallbackInfo const& info) {
+  if (destroyed_ || open_.empty()) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  auto& section = frame_[open_.back()];
+  open_.pop_back();
+  section.end = query();
+  GL_EXPORT::glQueryCounter(section.end, GL_TIMESTAMP);
+  return info.Env().Undefined();
+}
+
+// collect(wait = false): Read the frames the GPU has finished, or wait for all the pending frames
+// if `wait`. Returns the number of frames read.
+Napi::Value FrameProfiler::Collect(Napi::CallbackInfo const& info) {
+  if (destroyed_) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  auto collected = collect(info[0].ToBoolean().Value());
+  return CPPToNapi(info)(static_cast<uint32_t>(collected));
+}
+
+// {[section]: {count, mean, min, max, p50, p90, p99}}, over the last `window` frames that were
+// read, in ms
+Napi::Value FrameProfiler::Stats(Napi::CallbackInfo const& info) {
+  auto env   = info.Env();
+  auto stats = Napi::Object::New(env);
+  for (auto const& entry : samples_) {
+    auto sorted = entry.second.times;
+    std::sort(sorted.begin(), sorted.end());
+    double sum{0};
+    for (auto time : sorted) { sum += time; }
+    auto section = Napi::Object::New(env);
+    section.Set("count", CPPToNapi(env)(static_cast<uint32_t>(sorted.size())));
+    section.Set("mean", CPPToNapi(env)(sum / sorted.size()));
+    section.Set("min", CPPToNapi(env)(sorted.front()));
+    section.Set("max", CPPToNapi(env)(sorted.back()));
+    section.Set("p50", CPPToNapi(env)(percentile(sorted, 0.50)));
+    section.Set("p90", CPPToNapi(env)(percentile(sorted, 0.90)));
+    section.Set("p99", CPPToNapi(env)(percentile(sorted, 0.99)));
+    stats.Set(entry.first, section);
+  }
+  return stats;
+}
+
+// Forget the samples read so far. Pending frames are still read.
+Napi::Value FrameProfiler::Reset(Napi::CallbackInfo const& info) {
+  samples_.clear();
+  return info.Env().Undefined();
+}
+
+// Delete the queries. Frames that are pending or being recorded are dropped.
+Napi::Value FrameProfiler::Destroy(Napi::CallbackInfo const& info) {
+  Free();
+  return info.Env().Undefined();
+}
+
+// Delete every query, pooled or in use, against the context the profiler was created for. If that
+// context is gone, so are they.
+void FrameProfiler::Free() {
+  if (destroyed_) { return; }
+  for (auto const& sections : pending_) {
+    for (auto const& section : sections) {
+      pool_.push_back(section.begin);
+      pool_.push_back(section.end);
+    }
+  }
+  for (auto const& section : frame_) {
+    pool_.push_back(section.begin);
+    if (section.end != 0) { pool_.push_back(section.end); }
+  }
+  ScopedCurrent current(gl_context_);
+  if (current && !pool_.empty()) { GL_EXPORT::glDeleteQueries(pool_.size(), pool_.data()); }
+  pool_.clear();
+  pending_.clear();
+  frame_.clear();
+  open_.clear();
+  in_frame_  = false;
+  destroyed_ = true;
+}
+
+Napi::Value FrameProfiler::GetWindow(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(window_);
+}
+
+// The number of frames ended but not yet read
+Napi::Value FrameProfiler::GetPending(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(static_cast<uint32_t>(pending_.size()));
+}
+
+}  // namespace nv
@@ -18,17 +18,44 @@
 #include <nv_node/utilities/args.hpp>
 #include <nv_node/utilities/cpp_to_napi.hpp>
 
+#include <algorithm>
+
 namespace nv {
 
+namespace {
+
+inline std::vector<GLuint> attached_shaders(GLuint program) {
+  GLint count{};
+  GL_EXPORT::glGetProgramiv(program, GL_ATTACHED_SHADERS, &count);
+  std::vector<GLuint> shaders(std::max(count, 0));
+  if (count > 0) { GL_EXPORT::glGetAttachedShaders(program, count, &count, shaders.data()); }
+  shaders.resize(count);
+  return shaders;
+}
+
+}  // namespace
+
 // GL_EXPORT GLuint glCreateProgram (void);
 Napi::Value WebGL2RenderingContext::CreateProgram(Napi::CallbackInfo const& info) {
-  return WebGLProgram::New(GL_EXPORT::glCreateProgram());
+  auto program = GL_EXPORT::glCreateProgram();
+  link_inputs_.erase(program);
+  return WebGLProgram::New(program);
 }
 
 // GL_EXPORT void glDeleteProgram (GLuint program);
 Napi::Value WebGL2RenderingContext::DeleteProgram(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glDeleteProgram(args[0]);
+  GLuint program    = args[0];
+  GL_EXPORT::glDeleteProgram(program);
+  link_inputs_.erase(program);
+  for (auto it = uniform_layouts_.begin(); it != uniform_layouts_.end();) {
+    if (it->second.program != program) {
+      ++it;
+    } else {
+      ReleaseUniformLayout(it->second);
+      it = uniform_layouts_.erase(it);
+    }
+  }
   return info.Env().Undefined();
 }
 
@@ -85,14 +112,64 @@ Napi::Value WebGL2RenderingContext::IsProgram(Napi::CallbackInfo const& info) {
 // GL_EXPORT void glLinkProgram (GLuint program);
 Napi::Value WebGL2RenderingContext::LinkProgram(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glLinkProgram(args[0]);
+  GLuint program    = args[0];
+  if (!program_cache_) {
+    GL_EXPORT::glLinkProgram(program);
+    return info.Env().Undefined();
+  }
+
+  // The key covers the shaders' types and sources (in any order), the attribute bindings, and the
+  // transform feedback varyings. It's seeded with the driver, so an update misses.
+  auto shaders = attached_shaders(program);
+  std::vector<uint64_t> shader_keys(shaders.size());
+  std::transform(shaders.begin(), shaders.end(), shader_keys.begin(), [&](GLuint shader) {
+    return ShaderKey(shader);
+  });
+  std::vector<uint64_t> sorted_keys{shader_keys};
+  std::sort(sorted_keys.begin(), sorted_keys.end());
+  auto key = program_cache_->Key();
+  for (auto shader_key : sorted_keys) { key = ProgramCache::Hash(key, std::to_string(shader_key)); }
+  auto& inputs = link_inputs_[program];
+  for (auto const& attrib : inputs.attribs) {
+    key = ProgramCache::Hash(key, attrib.first + "=" + std::to_string(attrib.second));
+  }
+  key = ProgramCache::Hash(key, inputs.varyings);
+
+  if (program_cache_->Load(key, program)) { return info.Env().Undefined(); }
+
+  ++program_cache_->stats.misses;
+  for (auto shader : shaders) { CompileDeferred(shader); }
+  GL_EXPORT::glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+  GL_EXPORT::glLinkProgram(program);
+  GLint linked{};
+  GL_EXPORT::glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  if (linked != GL_TRUE) { return info.Env().Undefined(); }
+
+  // Shaders that compiled without a log can skip compiling next time. See CompileShader().
+  for (size_t i = 0; program_cache_->DeferCompile() && i < shaders.size(); ++i) {
+    GLint compiled{}, log_length{};
+    GL_EXPORT::glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &compiled);
+    GL_EXPORT::glGetShaderiv(shaders[i], GL_INFO_LOG_LENGTH, &log_length);
+    if (compiled == GL_TRUE && log_length <= 1) { program_cache_->MarkCompiled(shader_keys[i]); }
+  }
+  program_cache_->Store(key, program);
   return info.Env().Undefined();
 }
 
+Napi::Value WebGL2RenderingContext::GetProgramCacheStats(Napi::CallbackInfo const& info) {
+  if (!program_cache_) { return info.Env().Null(); }
+  auto stats = Napi::Object::New(info.Env());
+  stats.Set("hits", CPPToNapi(info.Env())(program_cache_->stats.hits));
+  stats.Set("misses", CPPToNapi(info.Env())(program_cache_->stats.misses));
+  stats.Set("directory", CPPToNapi(info.Env())(program_cache_->Directory()));
+  return stats;
+}
+
 // GL_EXPORT void glUseProgram (GLuint program);
 Napi::Value WebGL2RenderingContext::UseProgram(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glUseProgram(args[0]);
+  GLuint program    = args[0];
+  state_->SetProgram(program, [&] { GL_EXPORT::glUseProgram(program); });
   return info.Env().Undefined();
 }
 
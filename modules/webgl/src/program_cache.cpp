@@ -0,0 +1,186 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "program_cache.hpp"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+namespace nv {
+
+namespace {
+
+// Written at the start of each binary file, before the binary's format
+constexpr char magic[4] = {'N', 'V', 'P', 'B'};
+
+inline std::string gl_string(GLenum name) {
+  auto str = GL_EXPORT::glGetString(name);
+  return str == nullptr ? "" : reinterpret_cast<const char*>(str);
+}
+
+// mkdir -p
+inline void make_directories(std::string const& path) {
+  for (size_t i = 1; i <= path.size(); ++i) {
+    if (i == path.size() || path[i] == '/') { ::mkdir(path.substr(0, i).c_str(), 0755); }
+  }
+}
+
+inline bool ends_with(std::string const& str, std::string const& suffix) {
+  return str.size() >= suffix.size() &&
+         str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+}  // namespace
+
+ProgramCache::ProgramCache(std::string directory, size_t max_bytes, bool defer_compile)
+  : directory_(std::move(directory)),
+    max_bytes_(max_bytes),
+    defer_compile_(defer_compile),
+    driver_(0xcbf29ce484222325ull) {
+  for (auto name : {GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION}) {
+    driver_ = Hash(driver_, gl_string(name));
+  }
+  make_directories(directory_);
+}
+
+std::string ProgramCache::path(uint64_t key, const char* extension) const {
+  char name[32];
+  std::snprintf(name, sizeof(name), "/%016llx.%s", static_cast<unsigned long long>(key), extension);
+  return directory_ + name;
+}
+
+std::string ProgramCache::temp_path(std::string const& file) {
+  static std::atomic<uint64_t> count{0};
+  return file + "." + std::to_string(::getpid()) + "." + std::to_string(++count) + ".tmp";
+}
+
+bool ProgramCache::Load(uint64_t key, GLuint program) {
+  auto file = path(key, "bin");
+  std::ifstream in(file, std::ios::binary);
+  if (!in) { return false; }
+
+  char header[sizeof(magic)];
+  GLenum format{};
+  in.read(header, sizeof(header));
+  in.read(reinterpret_cast<char*>(&format), sizeof(format));
+  std::vector<char> binary{std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+  in.close();
+
+  GLint linked{GL_FALSE};
+  if (std::memcmp(header, magic, sizeof(magic)) == 0 && !binary.empty()) {
+    GL_EXPORT::glProgramBinary(program, format, binary.data(), binary.size());
+    GL_EXPORT::glGetProgramiv(program, GL_LINK_STATUS, &linked);
+  }
+  if (linked != GL_TRUE) {
+    // Written by a driver that has since changed, or damaged. Compile and link instead.
+    GL_EXPORT::glGetError();
+    ::unlink(file.c_str());
+    return false;
+  }
+  // Mark it recently used
+  ::utimes(file.c_str(), nullptr);
+  ++stats.hits;
+  return true;
+}
+
+void ProgramCache::Store(uint64_t key, GLuint program) {
+  GLint length{};
+  GL_EXPORT::glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+  if (length <= 0) { return; }
+  std::vector<char> binary(length);
+  GLenum format{};
+  GL_EXPORT::glGetProgramBinary(program, length, &length, &format, binary.data());
+  if (length <= 0) { return; }
+
+  // Write to a temporary file and rename it into place, so concurrent processes never read a
+  // partial binary
+  auto file = path(key, "bin");
+  auto temp = temp_path(file);
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    out.write(magic, sizeof(magic));
+    out.write(reinterpret_cast<const char*>(&format), sizeof(format));
+    out.write(binary.data(), length);
+    if (!out) {
+      ::unlink(temp.c_str());
+      return;
+    }
+  }
+  if (::rename(temp.c_str(), file.c_str()) != 0) { ::unlink(temp.c_str()); }
+  evict();
+}
+
+bool ProgramCache::Compiled(uint64_t key) {
+  // Mark it recently used, if it's there
+  return ::utimes(path(key, "shader").c_str(), nullptr) == 0;
+}
+
+// The marker holds its key, so it counts towards `max_bytes`
+void ProgramCache::MarkCompiled(uint64_t key) {
+  auto file = path(key, "shader");
+  auto temp = temp_path(file);
+  {
+    std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    if (!out) {
+      ::unlink(temp.c_str());
+      return;
+    }
+  }
+  if (::rename(temp.c_str(), file.c_str()) != 0) { ::unlink(temp.c_str()); }
+}
+
+void ProgramCache::evict() {
+  struct Entry {
+    std::string path;
+    size_t size;
+    timespec used;
+  };
+  std::vector<Entry> entries;
+  size_t total{0};
+  if (auto dir = ::opendir(directory_.c_str())) {
+    while (auto entry = ::readdir(dir)) {
+      std::string name = entry->d_name;
+      if (!ends_with(name, ".bin") && !ends_with(name, ".shader")) { continue; }
+      struct stat st;
+      auto file = directory_ + "/" + name;
+      if (::stat(file.c_str(), &st) != 0) { continue; }
+      entries.push_back({file, static_cast<size_t>(st.st_size), st.st_mtim});
+      total += st.st_size;
+    }
+    ::closedir(dir);
+  }
+  if (total <= max_bytes_) { return; }
+  std::sort(entries.begin(), entries.end(), [](Entry const& a, Entry const& b) {
+    return a.used.tv_sec != b.used.tv_sec ? a.used.tv_sec < b.used.tv_sec
+                                          : a.used.tv_nsec < b.used.tv_nsec;
+  });
+  for (auto const& entry : entries) {
+    if (total <= max_bytes_) { break; }
+    if (::unlink(entry.path.c_str()) == 0) { total -= entry.size; }
+  }
+}
+
+}  // namespace nv
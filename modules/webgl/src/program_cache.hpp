@@ -0,0 +1,84 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "gl.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace nv {
+
+// Linked program binaries on disk, so programs linked once needn't be compiled and linked again in
+// later runs. Entries are keyed by a hash of everything that goes into the link (see Key()), and
+// the least recently used are evicted once the directory grows past `max_bytes`.
+//
+// With `defer_compile`, the cache also remembers which shader sources compiled, so their
+// compilation can be deferred until a link that misses actually needs it. See shader.cpp and
+// program.cpp. These markers are evicted with the binaries.
+class ProgramCache {
+ public:
+  struct Stats {
+    uint64_t hits{0};    // links answered from a binary
+    uint64_t misses{0};  // links that compiled and linked
+  };
+
+  // Call with the context current. `directory` is created if it doesn't exist.
+  ProgramCache(std::string directory, size_t max_bytes, bool defer_compile);
+
+  // A key seeded with the driver's identity, so binaries from another driver are never tried
+  inline uint64_t Key() const { return driver_; }
+
+  // Fold `data` into `key` (64-bit FNV-1a)
+  static inline uint64_t Hash(uint64_t key, std::string const& data) {
+    for (unsigned char c : data) { key = (key ^ c) * 0x100000001b3ull; }
+    // Separate consecutive fields, so ("ab", "c") and ("a", "bc") hash differently
+    return (key ^ 0xff) * 0x100000001b3ull;
+  }
+
+  // Load the binary for `key` into `program`. Returns whether `program` is now linked. A binary
+  // the driver rejects is deleted.
+  bool Load(uint64_t key, GLuint program);
+
+  // Save the binary of `program`, which must be linked, as `key`. Evicts the least recently used
+  // entries if that puts the directory over its limit.
+  void Store(uint64_t key, GLuint program);
+
+  // Whether a shader with source key `key` has compiled before, and record that it has. Records
+  // are evicted by the next Store().
+  bool Compiled(uint64_t key);
+  void MarkCompiled(uint64_t key);
+
+  inline std::string const& Directory() const { return directory_; }
+
+  // Whether shaders that have compiled before are only compiled if a link misses
+  inline bool DeferCompile() const { return defer_compile_; }
+
+  Stats stats{};
+
+ private:
+  std::string path(uint64_t key, const char* extension) const;
+  // A name to write `file` as before renaming it into place, unique across processes and stores
+  static std::string temp_path(std::string const& file);
+  void evict();
+
+  std::string directory_;
+  size_t max_bytes_;
+  bool defer_compile_;
+  uint64_t driver_;
+};
+
+}  // namespace nv
@@ -28,19 +28,17 @@ Napi::Value WebGL2RenderingContext::BeginQuery(Napi::CallbackInfo const& info) {
 }
 
 // GL_EXPORT void glGenQueries (GLsizei n, GLuint* ids);
+// Names come from a pool filled in batches, and wrappers from recycled queries when there are any
 Napi::Value WebGL2RenderingContext::CreateQuery(Napi::CallbackInfo const& info) {
-  CallbackArgs args = info;
-  GLuint query{};
-  GL_EXPORT::glGenQueries(1, &query);
-  return WebGLQuery::New(query);
+  return query_wrappers_.Wrap(query_names_.Take());
 }
 
 // GL_EXPORT void glGenQueries (GLsizei n, GLuint* ids);
+// Returns the names, without wrappers
 Napi::Value WebGL2RenderingContext::CreateQueries(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  std::vector<GLuint> queries(static_cast<size_t>(args[0]));
-  GL_EXPORT::glGenQueries(queries.size(), queries.data());
-  return CPPToNapi(info)(queries);
+  auto queries      = query_names_.Take(args[0].operator size_t());
+  return CPPToNapi(info)(ExternalArray<GLuint>(std::move(queries)));
 }
 
 // GL_EXPORT void glDeleteQueries (GLsizei n, const GLuint* ids);
@@ -52,6 +50,7 @@ Napi::Value WebGL2RenderingContext::DeleteQuery(Napi::CallbackInfo const& info)
 }
 
 // GL_EXPORT void glDeleteQueries (GLsizei n, const GLuint* ids);
+// Takes names or WebGLQuerys
 Napi::Value WebGL2RenderingContext::DeleteQueries(Napi::CallbackInfo const& info) {
   CallbackArgs args           = info;
   std::vector<GLuint> queries = args[0];
@@ -59,6 +58,20 @@ Napi::Value WebGL2RenderingContext::DeleteQueries(Napi::CallbackInfo const& info
   return info.Env().Undefined();
 }
 
+// Keeps the query object and its name for createQuery() to hand out again, and its WebGLQuery
+Napi::Value WebGL2RenderingContext::RecycleQuery(Napi::CallbackInfo const& info) {
+  if (!WebGLQuery::IsInstance(info[0])) {
+    NAPI_THROW(Napi::TypeError::New(info.Env(), "Expected a WebGLQuery"));
+  }
+  auto wrapper = info[0].As<Napi::Object>();
+  GLuint query = *WebGLQuery::Unwrap(wrapper);
+  // Already deleted or recycled
+  if (query == 0) { return info.Env().Undefined(); }
+  query_names_.Give(query);
+  query_wrappers_.Recycle(wrapper);
+  return info.Env().Undefined();
+}
+
 // GL_EXPORT void glEndQuery (GLenum target);
 Napi::Value WebGL2RenderingContext::EndQuery(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
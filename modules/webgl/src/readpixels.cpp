@@ -0,0 +1,202 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "macros.hpp"
+#include "webgl.hpp"
+
+#include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/cpp_to_napi.hpp>
+
+#include <cstring>
+#include <string>
+
+namespace nv {
+
+namespace {
+
+inline GLsizeiptr components(GLenum format) {
+  switch (format) {
+    case GL_RED:
+    case GL_RED_INTEGER:
+    case GL_ALPHA:
+    case GL_LUMINANCE:
+    case GL_DEPTH_COMPONENT:
+    case GL_STENCIL_INDEX: return 1;
+    case GL_RG:
+    case GL_RG_INTEGER:
+    case GL_LUMINANCE_ALPHA:
+    case GL_DEPTH_STENCIL: return 2;
+    case GL_RGB:
+    case GL_RGB_INTEGER: return 3;
+    default: return 4;
+  }
+}
+
+// The size of a pixel of `format` and `type`, in bytes
+inline GLsizeiptr pixel_size(GLenum format, GLenum type) {
+  switch (type) {
+    case GL_UNSIGNED_BYTE_3_3_2:
+    case GL_UNSIGNED_BYTE_2_3_3_REV: return 1;
+    case GL_UNSIGNED_SHORT_5_6_5:
+    case GL_UNSIGNED_SHORT_5_6_5_REV:
+    case GL_UNSIGNED_SHORT_4_4_4_4:
+    case GL_UNSIGNED_SHORT_4_4_4_4_REV:
+    case GL_UNSIGNED_SHORT_5_5_5_1:
+    case GL_UNSIGNED_SHORT_1_5_5_5_REV: return 2;
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV:
+    case GL_UNSIGNED_INT_5_9_9_9_REV:
+    case GL_UNSIGNED_INT_24_8: return 4;
+    case GL_FLOAT_32_UNSIGNED_INT_24_8_REV: return 8;
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE: return components(format);
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT: return components(format) * 2;
+    default: return components(format) * 4;
+  }
+}
+
+// The size of the pixels glReadPixels() writes: the rows and pixels the PACK_SKIP_ROWS and
+// PACK_SKIP_PIXELS skip over, then each row PACK_ROW_LENGTH (or `width`) pixels long, padded out
+// to the PACK_ALIGNMENT, except the last.
+inline GLsizeiptr read_size(GLsizei width, GLsizei height, GLenum format, GLenum type) {
+  if (width == 0 || height == 0) { return 0; }
+  GLint alignment{4}, row_length{}, skip_pixels{}, skip_rows{};
+  GL_EXPORT::glGetIntegerv(GL_PACK_ALIGNMENT, &alignment);
+  GL_EXPORT::glGetIntegerv(GL_PACK_ROW_LENGTH, &row_length);
+  GL_EXPORT::glGetIntegerv(GL_PACK_SKIP_PIXELS, &skip_pixels);
+  GL_EXPORT::glGetIntegerv(GL_PACK_SKIP_ROWS, &skip_rows);
+  auto size   = pixel_size(format, type);
+  auto row    = (row_length > 0 ? row_length : width) * size;
+  auto stride = (row + alignment - 1) / alignment * alignment;
+  return stride * (skip_rows + height - 1) + (skip_pixels + width) * size;
+}
+
+// The most reads readPixelsAsync() has in flight at once
+constexpr size_t max_pixel_pack_slots{16};
+
+}  // namespace
+
+// Start reading the pixels into a pixel pack buffer from the ring, and fence the read. Returns the
+// slot to poll with _pollPixels() and collect with _takePixels().
+Napi::Value WebGL2RenderingContext::ReadPixelsToBuffer_(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  GLint x           = args[0];
+  GLint y           = args[1];
+  GLsizei width     = args[2];
+  GLsizei height    = args[3];
+  GLenum format     = args[4];
+  GLenum type       = args[5];
+
+  if (width < 0 || height < 0) { GLEW_THROW(info.Env(), GL_INVALID_VALUE); }
+
+  size_t index = 0;
+  while (index < pixel_pack_ring_.size() && pixel_pack_ring_[index].busy) { ++index; }
+  if (index == max_pixel_pack_slots) {
+    NAPI_THROW(Napi::Error::New(
+      info.Env(),
+      "readPixelsAsync: " + std::to_string(max_pixel_pack_slots) + " reads already in flight"));
+  }
+  if (index == pixel_pack_ring_.size()) { pixel_pack_ring_.emplace_back(); }
+  auto& slot = pixel_pack_ring_[index];
+
+  slot.size = read_size(width, height, format, type);
+  if (slot.buffer == 0) { GL_EXPORT::glCreateBuffers(1, &slot.buffer); }
+  if (slot.capacity < slot.size) {
+    GL_EXPORT::glNamedBufferData(slot.buffer, slot.size, nullptr, GL_STREAM_READ);
+    slot.capacity = slot.size;
+  }
+
+  // Leave the PIXEL_PACK_BUFFER binding (and the state cache's idea of it) as we found it
+  GLint bound{};
+  GL_EXPORT::glGetIntegerv(GL_PIXEL_PACK_BUFFER_BINDING, &bound);
+  GL_EXPORT::glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+  GL_EXPORT::glReadPixels(x, y, width, height, format, type, nullptr);
+  GL_EXPORT::glBindBuffer(GL_PIXEL_PACK_BUFFER, bound);
+
+  slot.fence = GL_EXPORT::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  slot.busy  = true;
+  return CPPToNapi(info)(static_cast<uint32_t>(index));
+}
+
+// Whether the read in `slot` is done. Never waits. Called from a timer, so it makes this context
+// current for the check.
+Napi::Value WebGL2RenderingContext::PollPixels_(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  uint32_t index    = args[0];
+  if (index >= pixel_pack_ring_.size() || !pixel_pack_ring_[index].busy) {
+    GLEW_THROW(info.Env(), GL_INVALID_VALUE);
+  }
+  ScopedCurrent current(gl_context_);
+  if (!current) { NAPI_THROW(Napi::Error::New(info.Env(), "The GL context was destroyed")); }
+  auto& slot  = pixel_pack_ring_[index];
+  auto status = GL_EXPORT::glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+  if (status == GL_WAIT_FAILED) { GLEW_THROW(info.Env(), GL_EXPORT::glGetError()); }
+  return CPPToNapi(info)(status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED);
+}
+
+// Copy the pixels out of `slot` into a new ArrayBuffer, and return the slot to the ring
+Napi::Value WebGL2RenderingContext::TakePixels_(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  uint32_t index    = args[0];
+  if (index >= pixel_pack_ring_.size() || !pixel_pack_ring_[index].busy) {
+    GLEW_THROW(info.Env(), GL_INVALID_VALUE);
+  }
+  ScopedCurrent current(gl_context_);
+  if (!current) { NAPI_THROW(Napi::Error::New(info.Env(), "The GL context was destroyed")); }
+  auto& slot = pixel_pack_ring_[index];
+  GL_EXPORT::glDeleteSync(slot.fence);
+  slot.fence = nullptr;
+  slot.busy  = false;
+
+  auto pixels = Napi::ArrayBuffer::New(info.Env(), slot.size);
+  if (slot.size > 0) {
+    auto data = GL_EXPORT::glMapNamedBufferRange(slot.buffer, 0, slot.size, GL_MAP_READ_BIT);
+    if (data == nullptr) { GLEW_THROW(info.Env(), GL_EXPORT::glGetError()); }
+    std::memcpy(pixels.Data(), data, slot.size);
+    GL_EXPORT::glUnmapNamedBuffer(slot.buffer);
+  }
+  return pixels;
+}
+
+// Return `slot` to the ring without taking its pixels, after polling it failed. Does nothing if
+// it's already been returned.
+Napi::Value WebGL2RenderingContext::ReleasePixels_(Napi::CallbackInfo const& info) {
+  CallbackArgs args = info;
+  uint32_t index    = args[0];
+  if (index < pixel_pack_ring_.size() && pixel_pack_ring_[index].busy) {
+    auto& slot = pixel_pack_ring_[index];
+    ScopedCurrent current(gl_context_);
+    if (current) { GL_EXPORT::glDeleteSync(slot.fence); }
+    slot.fence = nullptr;
+    slot.busy  = false;
+  }
+  return info.Env().Undefined();
+}
+
+// Delete the ring's buffers and fences, if the GL context is still around to delete them from
+void WebGL2RenderingContext::FreePixelPackRing() {
+  if (pixel_pack_ring_.empty()) { return; }
+  ScopedCurrent current(gl_context_);
+  if (current) {
+    for (auto& slot : pixel_pack_ring_) {
+      if (slot.fence != nullptr) { GL_EXPORT::glDeleteSync(slot.fence); }
+      if (slot.buffer != 0) { GL_EXPORT::glDeleteBuffers(1, &slot.buffer); }
+    }
+  }
+  pixel_pack_ring_.clear();
+}
+
+}  // namespace nv
@@ -0,0 +1,239 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {CommandEncoder, NativeCommands} from '@nvidia/rapids-core';
+
+import gl from './addon';
+
+// How each recorded method's arguments are encoded. One letter per argument:
+//   n: a number or boolean
+//   o: a WebGL object, as its GL name (0 for null)
+//   l: a WebGLUniformLocation (-1 for null, which GL ignores)
+//   v: an array of numbers, inlined. Always last. Takes optional (srcOffset, srcLength) after it
+//   c: not an argument; the context's handle, for commands that update the context's own state
+const encodings: Record<string, string> = {
+  activeTexture: 'n',
+  bindBuffer: 'cno',
+  bindBufferBase: 'cnno',
+  bindBufferRange: 'cnnonn',
+  bindFramebuffer: 'no',
+  bindRenderbuffer: 'no',
+  bindSampler: 'no',
+  bindTexture: 'no',
+  bindVertexArray: 'co',
+  blendColor: 'nnnn',
+  blendEquation: 'n',
+  blendEquationSeparate: 'nn',
+  blendFunc: 'cnn',
+  blendFuncSeparate: 'cnnnn',
+  clear: 'cn',
+  clearColor: 'nnnn',
+  clearDepth: 'n',
+  clearStencil: 'n',
+  colorMask: 'nnnn',
+  cullFace: 'n',
+  depthFunc: 'n',
+  depthMask: 'n',
+  depthRange: 'nn',
+  disable: 'cn',
+  disableVertexAttribArray: 'n',
+  drawArrays: 'nnn',
+  drawArraysInstanced: 'nnnn',
+  drawBuffers: 'v',
+  drawElements: 'nnnn',
+  drawElementsInstanced: 'nnnnn',
+  drawRangeElements: 'nnnnnn',
+  enable: 'cn',
+  enableVertexAttribArray: 'n',
+  frontFace: 'n',
+  lineWidth: 'n',
+  polygonOffset: 'nn',
+  sampleCoverage: 'nn',
+  scissor: 'nnnn',
+  stencilFunc: 'nnn',
+  stencilFuncSeparate: 'nnnn',
+  stencilMask: 'n',
+  stencilMaskSeparate: 'nn',
+  stencilOp: 'nnn',
+  stencilOpSeparate: 'nnnn',
+  uniform1f: 'ln',
+  uniform2f: 'lnn',
+  uniform3f: 'lnnn',
+  uniform4f: 'lnnnn',
+  uniform1i: 'ln',
+  uniform2i: 'lnn',
+  uniform3i: 'lnnn',
+  uniform4i: 'lnnnn',
+  uniform1ui: 'ln',
+  uniform2ui: 'lnn',
+  uniform3ui: 'lnnn',
+  uniform4ui: 'lnnnn',
+  uniform1fv: 'lv',
+  uniform2fv: 'lv',
+  uniform3fv: 'lv',
+  uniform4fv: 'lv',
+  uniform1iv: 'lv',
+  uniform2iv: 'lv',
+  uniform3iv: 'lv',
+  uniform4iv: 'lv',
+  uniformMatrix2fv: 'lnv',
+  uniformMatrix3fv: 'lnv',
+  uniformMatrix4fv: 'lnv',
+  useProgram: 'co',
+  vertexAttrib1f: 'nn',
+  vertexAttrib2f: 'nnn',
+  vertexAttrib3f: 'nnnn',
+  vertexAttrib4f: 'nnnnn',
+  vertexAttribDivisor: 'nn',
+  vertexAttribIPointer: 'nnnnn',
+  vertexAttribPointer: 'nnnnnn',
+  viewport: 'cnnnn',
+};
+
+export interface RecordingOptions {
+  /** Initial size of the command buffer, in 8-byte slots. It grows as needed. */
+  capacity?: number;
+  /** Submit automatically once this many bytes of commands are recorded. */
+  maxBytes?: number;
+}
+
+export interface RecordingWebGL2RenderingContext extends WebGL2RenderingContext {
+  /** The immediate-mode context the recorded calls run on */
+  readonly context: WebGL2RenderingContext;
+  /** Run every recorded call in one native call. */
+  submit(): void;
+}
+
+/**
+ * Wrap `context` in a context that records the common state, uniform and draw calls into a
+ * command buffer instead of making one native call each, and runs them all in one native call
+ * on `submit()`. Use it like the context it wraps, and call `submit()` at the end of each frame.
+ *
+ * Calls that return a value or take data (`getParameter`, `bufferData`, `texImage2D`, ...) aren't
+ * recorded. They submit the recorded calls first, then run immediately, so GL always sees the
+ * calls in the order they were made.
+ *
+ * Recorded calls don't throw until they're submitted. If the context's `errorChecks` is
+ * `strict`, `submit()` also throws if any of them left a GL error.
+ */
+export function createRecordingContext(context: WebGL2RenderingContext,
+                                       options: RecordingOptions = {}) {
+  const {capacity = 1 << 14, maxBytes = 1 << 20} = options;
+
+  const encoder  = new CommandEncoder(<NativeCommands>gl.commands, capacity, 0);
+  const recorder = Object.create(context);
+  const handle   = encoder.handle(context);
+  const names    = new WeakMap<any, number>();
+  const args     = <number[]>[];
+
+  // WebGL objects' GL names never change unless they're recycled, so read each one's `ptr` once
+  const nameOf = (object: any) => {
+    let name = names.get(object);
+    if (name === undefined) { names.set(object, name = object.ptr); }
+    return name!;
+  };
+
+  // `strict` contexts check every native call, so check the one that runs the recorded calls too
+  const strict = (<any>context.getContextAttributes())?.errorChecks === 'strict';
+  const submit = () => {
+    encoder.submit();
+    if (strict) {
+      const error = context.getError();
+      if (error !== context.NO_ERROR) { throw new Error(`${error} from a recorded call`); }
+    }
+  };
+
+  const record = (op: number, encoding: string) => function(...params: any[]) {
+    let n = 0;
+    for (let i = 0, j = 0; i < encoding.length; ++i) {
+      switch (encoding[i]) {
+        case 'c': args[n++] = handle; break;
+        case 'n': args[n++] = +params[j++] || 0; break;
+        case 'o': {
+          const object = params[j++];
+          args[n++]    = object ? nameOf(object) : 0;
+          break;
+        }
+        case 'l': {
+          const location = params[j++];
+          args[n++]      = location ? nameOf(location) : -1;
+          break;
+        }
+        case 'v': {
+          const values = params[j];
+          const offset = params[j + 1] || 0;
+          const length = params[j + 2] === undefined ? values.length - offset : params[j + 2];
+          for (let k = 0; k < length; ++k) { args[n++] = +values[offset + k]; }
+          break;
+        }
+      }
+    }
+    encoder.pushArgs(op, args, n);
+    if (encoder.byteLength >= maxBytes) { submit(); }
+  };
+
+  const immediate = (key: string) => function(...params: any[]) {
+    submit();
+    return (<any>context)[key](...params);
+  };
+
+  // Shadow every method and accessor of the context, down to (but not including) Object's
+  for (const proto of prototypesOf(context)) {
+    for (const key of Object.getOwnPropertyNames(proto)) {
+      if (key === 'constructor' || Object.prototype.hasOwnProperty.call(recorder, key)) {
+        continue;
+      }
+      const desc = Object.getOwnPropertyDescriptor(proto, key)!;
+      if (desc.get || desc.set) {
+        Object.defineProperty(recorder, key, {
+          configurable: true,
+          get() {
+            submit();
+            return (<any>context)[key];
+          },
+          set(value: any) {
+            submit();
+            (<any>context)[key] = value;
+          },
+        });
+      } else if (typeof desc.value === 'function') {
+        const op      = encoder.ops[key];
+        recorder[key] = op !== undefined && key in encodings ? record(op, encodings[key])
+                                                             : immediate(key);
+      }
+    }
+  }
+
+  // A recycled object is handed out again with another name, so forget the one read from it
+  for (const key of ['recycleBuffer', 'recycleQuery', 'recycleSync']) {
+    const recycle = recorder[key];
+    recorder[key] = (object: any) => {
+      names.delete(object);
+      return recycle(object);
+    };
+  }
+
+  recorder.context = context;
+  recorder.submit  = submit;
+  return <RecordingWebGL2RenderingContext>recorder;
+}
+
+function prototypesOf(object: any) {
+  const protos = [];
+  for (let proto = Object.getPrototypeOf(object); proto && proto !== Object.prototype;) {
+    protos.push(proto);
+    proto = Object.getPrototypeOf(proto);
+  }
+  return protos;
+}
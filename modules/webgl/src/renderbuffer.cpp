@@ -33,7 +33,7 @@ Napi::Value WebGL2RenderingContext::CreateRenderbuffers(Napi::CallbackInfo const
   CallbackArgs args = info;
   std::vector<GLuint> renderbuffers(args[0].operator size_t());
   GL_EXPORT::glCreateRenderbuffers(renderbuffers.size(), renderbuffers.data());
-  return CPPToNapi(info)(renderbuffers);
+  return CPPToNapi(info)(ExternalArray<GLuint>(std::move(renderbuffers)));
 }
 
 // GL_EXPORT void glBindRenderbuffer (GLenum target, GLuint renderbuffer);
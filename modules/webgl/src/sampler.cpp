@@ -41,7 +41,7 @@ Napi::Value WebGL2RenderingContext::CreateSamplers(Napi::CallbackInfo const& inf
   CallbackArgs args = info;
   std::vector<GLuint> samplers(static_cast<size_t>(args[0]));
   GL_EXPORT::glCreateSamplers(samplers.size(), samplers.data());
-  return CPPToNapi(info)(samplers);
+  return CPPToNapi(info)(ExternalArray<GLuint>(std::move(samplers)));
 }
 
 // GL_EXPORT void glDeleteSamplers (GLsizei count, const GLuint * samplers);
@@ -20,6 +20,21 @@
 
 namespace nv {
 
+uint64_t WebGL2RenderingContext::ShaderKey(GLuint shader) {
+  GLint type{}, length{};
+  GL_EXPORT::glGetShaderiv(shader, GL_SHADER_TYPE, &type);
+  GL_EXPORT::glGetShaderiv(shader, GL_SHADER_SOURCE_LENGTH, &length);
+  std::string source(std::max(length, 1), '\0');
+  if (length > 0) { GL_EXPORT::glGetShaderSource(shader, length, &length, &source[0]); }
+  source.resize(std::max(length, 0));
+  auto key = ProgramCache::Hash(program_cache_->Key(), std::to_string(type));
+  return ProgramCache::Hash(key, source);
+}
+
+void WebGL2RenderingContext::CompileDeferred(GLuint shader) {
+  if (deferred_shaders_.erase(shader) > 0) { GL_EXPORT::glCompileShader(shader); }
+}
+
 // GL_EXPORT void glAttachShader (GLuint program, GLuint shader);
 Napi::Value WebGL2RenderingContext::AttachShader(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
@@ -30,7 +45,17 @@ Napi::Value WebGL2RenderingContext::AttachShader(Napi::CallbackInfo const& info)
 // GL_EXPORT void glCompileShader (GLuint shader);
 Napi::Value WebGL2RenderingContext::CompileShader(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  GL_EXPORT::glCompileShader(args[0]);
+  GLuint shader     = args[0];
+  // With `deferCompile`, a source that has compiled cleanly before is compiled only if a link
+  // misses the program cache, since a hit doesn't need it. Until then it reports COMPILE_STATUS
+  // true and no info log.
+  if (program_cache_ && program_cache_->DeferCompile() &&
+      program_cache_->Compiled(ShaderKey(shader))) {
+    deferred_shaders_.insert(shader);
+  } else {
+    deferred_shaders_.erase(shader);
+    GL_EXPORT::glCompileShader(shader);
+  }
   return info.Env().Undefined();
 }
 
@@ -38,6 +63,7 @@ Napi::Value WebGL2RenderingContext::CompileShader(Napi::CallbackInfo const& info
 Napi::Value WebGL2RenderingContext::CreateShader(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
   auto shader       = GL_EXPORT::glCreateShader(args[0]);
+  deferred_shaders_.erase(shader);
   return WebGLShader::New(shader);
 }
 
@@ -82,6 +108,7 @@ Napi::Value WebGL2RenderingContext::GetShaderInfoLog(Napi::CallbackInfo const& i
   CallbackArgs args = info;
   GLuint shader     = args[0];
   GLint max_length{0};
+  if (deferred_shaders_.count(shader)) { return info.Env().Null(); }
   GL_EXPORT::glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &max_length);
   if (max_length > 0) {
     GLint length{};
@@ -100,6 +127,9 @@ Napi::Value WebGL2RenderingContext::GetShaderParameter(Napi::CallbackInfo const&
   // GLint param{};
   // GL_EXPORT::glGetShaderiv(shader, pname, &param);
   // return CPPToNapi(info)(param);
+  if (pname == GL_COMPILE_STATUS && deferred_shaders_.count(shader)) {
+    return CPPToNapi(info)(GLint{GL_TRUE});
+  }
   switch (pname) {
     case GL_DELETE_STATUS:
     case GL_COMPILE_STATUS: {
@@ -149,6 +179,7 @@ Napi::Value WebGL2RenderingContext::GetTranslatedShaderSource(Napi::CallbackInfo
   if (GLEW_ANGLE_translated_shader_source) {
     GLuint shader = args[0];
     GLint max_length{};
+    CompileDeferred(shader);
     GL_EXPORT::glGetShaderiv(shader, GL_TRANSLATED_SHADER_SOURCE_LENGTH_ANGLE, &max_length);
     if (max_length > 0) {
       GLint length{};
@@ -176,6 +207,8 @@ Napi::Value WebGL2RenderingContext::ShaderSource(Napi::CallbackInfo const& info)
   std::vector<GLint> source_lengths(sources.size());
   std::vector<const GLchar*> source_ptrs(sources.size());
   auto idx = -1;
+  // Compile the old source before replacing it, as GL would have
+  CompileDeferred(shader);
   std::for_each(sources.begin(), sources.end(), [&](std::string const& src) mutable {
     source_ptrs[++idx]  = src.data();
     source_lengths[idx] = src.size();
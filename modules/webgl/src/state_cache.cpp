@@ -0,0 +1,47 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "state_cache.hpp"
+#include "gl_context.hpp"
+
+#include <iterator>
+#include <mutex>
+
+namespace nv {
+
+std::shared_ptr<GLStateCache> GLStateCache::ForCurrent(bool enabled) {
+  // Contexts can be wrapped from worker threads, so the caches are shared across them
+  static std::mutex mutex;
+  static std::unordered_map<void*, std::weak_ptr<GLStateCache>> caches;
+
+  auto context = GLContext::Current().id();
+  std::shared_ptr<GLStateCache> cache{};
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    // Drop the caches of contexts that are no longer wrapped
+    for (auto it = caches.begin(); it != caches.end();) {
+      it = it->second.expired() ? caches.erase(it) : std::next(it);
+    }
+    if (context != nullptr) { cache = caches[context].lock(); }
+    if (!cache) {
+      cache = std::make_shared<GLStateCache>();
+      if (context != nullptr) { caches[context] = cache; }
+    }
+  }
+  cache->Invalidate();
+  cache->enabled = cache->enabled && enabled;
+  return cache;
+}
+
+}  // namespace nv
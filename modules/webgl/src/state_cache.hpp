@@ -0,0 +1,261 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include "gl.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace nv {
+
+// A shadow copy of the GL state that luma.gl re-sets most often: the current program, buffer and
+// vertex array bindings, capabilities, blend functions, and the viewport. Calls that wouldn't
+// change it skip the driver, and getParameter() answers from it.
+//
+// Everything starts out unknown, and is learned from the calls that set it. Every
+// WebGL2RenderingContext wrapping the same GL context shares one cache (see ForCurrent()).
+// Code that changes this state without going through a context (other libraries sharing the GL
+// context, raw GL from another addon) must call Invalidate() afterwards.
+class GLStateCache {
+ public:
+  struct Stats {
+    uint64_t issued{0};  // calls that went to the driver
+    uint64_t elided{0};  // calls skipped because the state already matched
+  };
+
+  // The cache of the GL context current on this thread, created on first use. Wrapping a context
+  // again forgets what its cache knew, since the context may be new at the same address. Turning
+  // the cache off for one wrapper turns it off for them all.
+  static std::shared_ptr<GLStateCache> ForCurrent(bool enabled);
+
+  // Each Set*() makes `call` unless the state already matches, and records the new state. With
+  // `check_errors`, only once glGetError() says the call succeeded: a failed call leaves the state
+  // unknown, and its error for TakeError(). Without, a failed call is recorded as if it succeeded
+  // until TakeError() sees an error and forgets everything.
+
+  template <typename Call>
+  inline void SetProgram(GLuint program, Call&& call) {
+    set(program_, program, call);
+  }
+
+  template <typename Call>
+  inline void SetBuffer(GLenum target, GLuint buffer, Call&& call) {
+    set(buffers_[target], buffer, call);
+  }
+
+  template <typename Call>
+  inline void SetVertexArray(GLuint vertex_array, Call&& call) {
+    if (enabled && vertex_array_.known && vertex_array_.value == vertex_array) {
+      ++stats.elided;
+      return;
+    }
+    // The element array buffer binding is part of the vertex array's state
+    buffers_.erase(GL_ELEMENT_ARRAY_BUFFER);
+    set(vertex_array_, vertex_array, call);
+  }
+
+  template <typename Call>
+  inline void SetCapability(GLenum cap, bool value, Call&& call) {
+    if (is_capability(cap)) {
+      set(capabilities_[cap], value, call);
+    } else {
+      ++stats.issued;
+      call();
+    }
+  }
+
+  template <typename Call>
+  inline void SetBlendFunc(
+    GLenum src_rgb, GLenum dst_rgb, GLenum src_alpha, GLenum dst_alpha, Call&& call) {
+    set(blend_func_, {src_rgb, dst_rgb, src_alpha, dst_alpha}, call);
+  }
+
+  template <typename Call>
+  inline void SetViewport(GLint x, GLint y, GLsizei width, GLsizei height, Call&& call) {
+    set(viewport_, {x, y, width, height}, call);
+  }
+
+  // The error a Set*() took from glGetError() to check its call, else glGetError()'s. getError()
+  // answers from this, so checking a call doesn't hide its error from the caller.
+  inline GLenum TakeError() {
+    auto code = error_;
+    error_    = GL_NO_ERROR;
+    if (code != GL_NO_ERROR) { return code; }
+    code = GL_EXPORT::glGetError();
+    // Any unchecked call since the last glGetError() may be the one that failed
+    if (code != GL_NO_ERROR && !check_errors) { Invalidate(); }
+    return code;
+  }
+
+  // Forget `target`'s binding. bindBufferBase() and bindBufferRange() change it as a side effect.
+  inline void ForgetBuffer(GLenum target) { buffers_.erase(target); }
+
+  // Deleting a bound buffer or vertex array unbinds it
+  inline void DeletedBuffer(GLuint buffer) {
+    for (auto& binding : buffers_) {
+      if (binding.second.known && binding.second.value == buffer) { binding.second.value = 0; }
+    }
+  }
+
+  inline void DeletedVertexArray(GLuint vertex_array) {
+    if (vertex_array_.known && vertex_array_.value == vertex_array) {
+      vertex_array_.value = 0;
+      buffers_.erase(GL_ELEMENT_ARRAY_BUFFER);
+    }
+  }
+
+  // Forget everything
+  inline void Invalidate() {
+    program_.known      = false;
+    vertex_array_.known = false;
+    blend_func_.known   = false;
+    viewport_.known     = false;
+    buffers_.clear();
+    capabilities_.clear();
+  }
+
+  // The integer state `pname` in `values`, if known. Returns the number of values, or 0.
+  inline size_t GetInteger(GLenum pname, GLint* values) const {
+    if (!enabled) { return 0; }
+    switch (pname) {
+      case GL_CURRENT_PROGRAM: return get(program_, values);
+      case GL_VERTEX_ARRAY_BINDING: return get(vertex_array_, values);
+      case GL_VIEWPORT: return get(viewport_, values);
+      case GL_BLEND_SRC_RGB: return get(blend_func_, 0, values);
+      case GL_BLEND_DST_RGB: return get(blend_func_, 1, values);
+      case GL_BLEND_SRC_ALPHA: return get(blend_func_, 2, values);
+      case GL_BLEND_DST_ALPHA: return get(blend_func_, 3, values);
+      default: break;
+    }
+    auto target = binding_target(pname);
+    auto buffer = target != GL_NONE ? buffers_.find(target) : buffers_.end();
+    return buffer != buffers_.end() ? get(buffer->second, values) : 0;
+  }
+
+  // Whether `cap` is enabled, if known
+  inline bool IsEnabled(GLenum cap, bool& value) const {
+    if (!enabled) { return false; }
+    auto it = capabilities_.find(cap);
+    if (it == capabilities_.end() || !it->second.known) { return false; }
+    value = it->second.value;
+    return true;
+  }
+
+  // When false, every call goes to the driver and queries aren't answered from the cache
+  bool enabled{true};
+  // Whether each call that goes to the driver is checked with glGetError() before it's recorded.
+  // That synchronizes with the driver, so it's only on for contexts with `errorChecks` debug or
+  // strict (for them all, once any context of the GL context asks for it).
+  bool check_errors{false};
+  Stats stats{};
+
+ private:
+  template <typename T>
+  struct Known {
+    T value{};
+    bool known{false};
+  };
+
+  // Calls are only checked for errors while the cache is on, since nothing reads it otherwise
+  template <typename T, typename Call>
+  inline void set(Known<T>& state, T const& value, Call& call) {
+    if (enabled && state.known && state.value == value) {
+      ++stats.elided;
+      return;
+    }
+    ++stats.issued;
+    state.known = false;
+    call();
+    if (!enabled) { return; }
+    if (!check_errors) {
+      state.value = value;
+      state.known = true;
+      return;
+    }
+    auto code = GL_EXPORT::glGetError();
+    if (code == GL_NO_ERROR) {
+      state.value = value;
+      state.known = true;
+    } else if (error_ == GL_NO_ERROR) {
+      error_ = code;
+    }
+  }
+
+  template <typename T>
+  static inline size_t get(Known<T> const& state, GLint* values) {
+    if (!state.known) { return 0; }
+    values[0] = static_cast<GLint>(state.value);
+    return 1;
+  }
+
+  template <typename T, size_t N>
+  static inline size_t get(Known<std::array<T, N>> const& state, GLint* values) {
+    if (!state.known) { return 0; }
+    for (size_t i = 0; i < N; ++i) { values[i] = static_cast<GLint>(state.value[i]); }
+    return N;
+  }
+
+  template <typename T, size_t N>
+  static inline size_t get(Known<std::array<T, N>> const& state, size_t i, GLint* values) {
+    if (!state.known) { return 0; }
+    values[0] = static_cast<GLint>(state.value[i]);
+    return 1;
+  }
+
+  // Only cache the capabilities WebGL2 has, so an invalid enable() can't poison a later query
+  static inline bool is_capability(GLenum cap) {
+    switch (cap) {
+      case GL_BLEND:
+      case GL_CULL_FACE:
+      case GL_DEPTH_TEST:
+      case GL_DITHER:
+      case GL_POLYGON_OFFSET_FILL:
+      case GL_RASTERIZER_DISCARD:
+      case GL_SAMPLE_ALPHA_TO_COVERAGE:
+      case GL_SAMPLE_COVERAGE:
+      case GL_SCISSOR_TEST:
+      case GL_STENCIL_TEST: return true;
+      default: return false;
+    }
+  }
+
+  static inline GLenum binding_target(GLenum pname) {
+    switch (pname) {
+      case GL_ARRAY_BUFFER_BINDING: return GL_ARRAY_BUFFER;
+      case GL_ELEMENT_ARRAY_BUFFER_BINDING: return GL_ELEMENT_ARRAY_BUFFER;
+      case GL_COPY_READ_BUFFER_BINDING: return GL_COPY_READ_BUFFER;
+      case GL_COPY_WRITE_BUFFER_BINDING: return GL_COPY_WRITE_BUFFER;
+      case GL_PIXEL_PACK_BUFFER_BINDING: return GL_PIXEL_PACK_BUFFER;
+      case GL_PIXEL_UNPACK_BUFFER_BINDING: return GL_PIXEL_UNPACK_BUFFER;
+      case GL_TRANSFORM_FEEDBACK_BUFFER_BINDING: return GL_TRANSFORM_FEEDBACK_BUFFER;
+      case GL_UNIFORM_BUFFER_BINDING: return GL_UNIFORM_BUFFER;
+      default: return GL_NONE;
+    }
+  }
+
+  Known<GLuint> program_;
+  Known<GLuint> vertex_array_;
+  Known<std::array<GLenum, 4>> blend_func_;
+  Known<std::array<GLint, 4>> viewport_;
+  std::unordered_map<GLenum, Known<GLuint>> buffers_;
+  std::unordered_map<GLenum, Known<bool>> capabilities_;
+  GLenum error_{GL_NO_ERROR};
+};
+
+}  // namespace nv
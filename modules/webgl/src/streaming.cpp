@@ -0,0 +1,197 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "macros.hpp"
+#include "webgl.hpp"
+
+#include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/cpp_to_napi.hpp>
+#include <nv_node/utilities/trace.hpp>
+
+#include <algorithm>
+
+namespace nv {
+
+namespace {
+
+// Regions start on this boundary, so any of them can be bound as a uniform buffer range
+constexpr GLsizeiptr region_alignment = 256;
+
+constexpr GLbitfield map_flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+// The longest Next() waits for the GPU to finish with a region, in ns
+constexpr GLuint64 wait_timeout = 5000000000;
+
+}  // namespace
+
+ConstructorReference StreamingBuffer::constructor;
+
+StreamingBuffer::StreamingBuffer(Napi::CallbackInfo const& info)
+  : Napi::ObjectWrap<StreamingBuffer>(info) {
+  CallbackArgs args = info;
+  GLsizeiptr size   = args[1];
+  uint32_t regions  = info[2].IsNumber() ? args[2].operator uint32_t() : 3;
+  if (!info[0].IsObject()) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  // Throws unless it's a context. Free() tells its state cache the buffer is gone.
+  auto context = WebGL2RenderingContext::Unwrap(info[0].As<Napi::Object>());
+  gl_context_  = context->gl_context();
+  state_       = context->shared_state();
+  context_     = Napi::Persistent(info[0].As<Napi::Object>());
+  if (size <= 0 || regions == 0) { GLEW_THROW(info.Env(), GL_INVALID_VALUE); }
+
+  region_size_ = (size + region_alignment - 1) / region_alignment * region_alignment;
+  fences_.resize(regions, nullptr);
+  region_ = regions - 1;
+
+  auto total = region_size_ * regions;
+  GL_EXPORT::glCreateBuffers(1, &buffer_);
+  GL_EXPORT::glNamedBufferStorage(buffer_, total, nullptr, map_flags);
+  auto data = GL_EXPORT::glMapNamedBufferRange(buffer_, 0, total, map_flags);
+  if (data == nullptr) {
+    auto code = GL_EXPORT::glGetError();
+    GL_EXPORT::glDeleteBuffers(1, &buffer_);
+    buffer_ = 0;
+    GLEW_THROW(info.Env(), code);
+  }
+
+  // GL owns the memory. Destroy() detaches the ArrayBuffer before unmapping it, and otherwise it's
+  // unmapped once the ArrayBuffer and every view of it are collected.
+  mapping_ = new Mapping{gl_context_, state_, buffer_};
+  memory_  = Napi::Persistent(Napi::ArrayBuffer::New(
+    info.Env(),
+    data,
+    total,
+    [](Napi::Env, void*, Mapping* mapping) {
+      Unmap(*mapping);
+      delete mapping;
+    },
+    mapping_));
+  webgl_buffer_ = Napi::Persistent(WebGLBuffer::New(buffer_));
+};
+
+// Runs from the GC, so it only deletes the fences. The ArrayBuffer may still be reachable from
+// views next() returned, so the buffer stays mapped until it's collected too.
+StreamingBuffer::~StreamingBuffer() {
+  if (buffer_ == 0) { return; }
+  FreeFences();
+  buffer_ = 0;
+}
+
+Napi::Object StreamingBuffer::Init(Napi::Env env, Napi::Object exports) {
+  Napi::Function ctor = DefineClass(
+    env,
+    "StreamingBuffer",
+    {
+      InstanceAccessor("buffer", &StreamingBuffer::GetBuffer, nullptr, napi_enumerable),
+      InstanceAccessor("offset", &StreamingBuffer::GetOffset, nullptr, napi_enumerable),
+      InstanceAccessor("byteLength", &StreamingBuffer::GetByteLength, nullptr, napi_enumerable),
+      InstanceAccessor("regions", &StreamingBuffer::GetRegions, nullptr, napi_enumerable),
+      trace::InstanceMethod(env, "StreamingBuffer", "next", &StreamingBuffer::Next),
+      trace::InstanceMethod(env, "StreamingBuffer", "fence", &StreamingBuffer::Fence),
+      trace::InstanceMethod(env, "StreamingBuffer", "destroy", &StreamingBuffer::Destroy),
+    });
+  StreamingBuffer::constructor = Napi::Persistent(ctor);
+  exports.Set("StreamingBuffer", ctor);
+  return exports;
+};
+
+// Move to the next region, waiting for the GPU to finish the draws fenced on it if it hasn't yet.
+// Returns a Uint8Array over the region's mapped memory. Throws, and stays on the current region,
+// if the wait fails or the GPU isn't done within `wait_timeout`.
+Napi::Value StreamingBuffer::Next(Napi::CallbackInfo const& info) {
+  if (buffer_ == 0) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  auto next   = (region_ + 1) % fences_.size();
+  auto& fence = fences_[next];
+  if (fence != nullptr) {
+    auto status = GL_EXPORT::glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, wait_timeout);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      NAPI_THROW(Napi::Error::New(info.Env(), "Timed out waiting for the GPU to finish a region"));
+    }
+    GL_EXPORT::glDeleteSync(fence);
+    fence = nullptr;
+    if (status == GL_WAIT_FAILED) { GLEW_THROW(info.Env(), GL_EXPORT::glGetError()); }
+  }
+  region_ = next;
+  return Napi::Uint8Array::New(info.Env(), region_size_, memory_.Value(), region_ * region_size_);
+}
+
+// Fence the current region. Call after the last GL call that reads it.
+Napi::Value StreamingBuffer::Fence(Napi::CallbackInfo const& info) {
+  if (buffer_ == 0) { GLEW_THROW(info.Env(), GL_INVALID_OPERATION); }
+  auto& fence = fences_[region_];
+  if (fence != nullptr) { GL_EXPORT::glDeleteSync(fence); }
+  fence = GL_EXPORT::glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  return info.Env().Undefined();
+}
+
+// Unmap and delete the buffer. Views returned by next() are detached.
+Napi::Value StreamingBuffer::Destroy(Napi::CallbackInfo const& info) {
+  if (buffer_ == 0) { return info.Env().Undefined(); }
+  NAPI_THROW_IF_FAILED(info.Env(), napi_detach_arraybuffer(info.Env(), memory_.Value()));
+  memory_.Reset();
+  Free();
+  return info.Env().Undefined();
+}
+
+// Delete the fences, and unmap and delete the buffer
+void StreamingBuffer::Free() {
+  FreeFences();
+  Unmap(*mapping_);
+  buffer_ = 0;
+}
+
+// Delete the fences against the context they were created in. If that context is gone, so are
+// they.
+void StreamingBuffer::FreeFences() {
+  ScopedCurrent current(gl_context_);
+  if (current) {
+    for (auto fence : fences_) {
+      if (fence != nullptr) { GL_EXPORT::glDeleteSync(fence); }
+    }
+  }
+  std::fill(fences_.begin(), fences_.end(), nullptr);
+}
+
+// Unmap and delete the buffer against the context it was created in, unless it already has been.
+// If that context is gone, so is the buffer.
+void StreamingBuffer::Unmap(Mapping& mapping) {
+  if (mapping.buffer == 0) { return; }
+  ScopedCurrent current(mapping.gl_context);
+  if (current) {
+    GL_EXPORT::glUnmapNamedBuffer(mapping.buffer);
+    GL_EXPORT::glDeleteBuffers(1, &mapping.buffer);
+    mapping.state->DeletedBuffer(mapping.buffer);
+  }
+  mapping.buffer = 0;
+}
+
+Napi::Value StreamingBuffer::GetBuffer(Napi::CallbackInfo const& info) {
+  return webgl_buffer_.Value();
+}
+
+// The byte offset of the current region in `buffer`, for vertexAttribPointer(), texSubImage2D(),
+// bindBufferRange(), etc.
+Napi::Value StreamingBuffer::GetOffset(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(static_cast<double>(region_ * region_size_));
+}
+
+Napi::Value StreamingBuffer::GetByteLength(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(static_cast<double>(region_size_));
+}
+
+Napi::Value StreamingBuffer::GetRegions(Napi::CallbackInfo const& info) {
+  return CPPToNapi(info)(static_cast<uint32_t>(fences_.size()));
+}
+
+}  // namespace nv
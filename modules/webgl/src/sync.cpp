@@ -35,9 +35,25 @@ Napi::Value WebGL2RenderingContext::DeleteSync(Napi::CallbackInfo const& info) {
 }
 
 // GL_EXPORT GLsync glFenceSync (GLenum condition, GLbitfield flags);
+// Reuses the wrappers of recycled syncs
 Napi::Value WebGL2RenderingContext::FenceSync(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
-  return WebGLSync::New(GL_EXPORT::glFenceSync(args[0], args[1]));
+  return sync_wrappers_.Wrap(GL_EXPORT::glFenceSync(args[0], args[1]));
+}
+
+// GL_EXPORT void glDeleteSync (GLsync GLsync);
+// Deletes the sync, and keeps its WebGLSync for fenceSync() to hand out again
+Napi::Value WebGL2RenderingContext::RecycleSync(Napi::CallbackInfo const& info) {
+  if (!WebGLSync::IsInstance(info[0])) {
+    NAPI_THROW(Napi::TypeError::New(info.Env(), "Expected a WebGLSync"));
+  }
+  auto wrapper = info[0].As<Napi::Object>();
+  GLsync sync  = *WebGLSync::Unwrap(wrapper);
+  // Already deleted or recycled
+  if (sync == nullptr) { return info.Env().Undefined(); }
+  GL_EXPORT::glDeleteSync(sync);
+  sync_wrappers_.Recycle(wrapper);
+  return info.Env().Undefined();
 }
 
 // GL_EXPORT void glGetSynciv (GLsync GLsync, GLenum pname, GLsizei bufSize, GLsizei* length, GLint
@@ -0,0 +1,182 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {StreamingBuffer} from './webgl';
+
+/** Memory a texture can be filled from on the GPU, like a `DeviceBuffer` from @nvidia/rmm */
+export interface DeviceSource {
+  readonly ptr: number;
+  readonly byteLength: number;
+}
+
+/** A column from @nvidia/cudf. Its `data` is copied, so it can't be a slice of another column. */
+export interface ColumnSource {
+  readonly data: DeviceSource;
+  readonly offset: number;
+}
+
+export type TextureSource = ArrayBufferView|DeviceSource|ColumnSource;
+
+/**
+ * The CUDA-OpenGL interop calls `TextureUploader` copies device memory with. `CUDA.gl` from
+ * @nvidia/cuda implements them.
+ */
+export interface TextureInterop {
+  registerImage(texture: number, target: number, flags: number): unknown;
+  unregisterResource(resource: unknown): void;
+  copyToImage(resource: unknown,
+              source: DeviceSource,
+              width: number,
+              height: number,
+              x?: number,
+              y?: number,
+              mipLevel?: number,
+              pitch?: number): void;
+}
+
+export interface TextureUploaderOptions {
+  /** Copies device memory into textures. Without it, only host memory can be uploaded. */
+  interop?: TextureInterop;
+  /**
+   * The size of the staging regions host memory is uploaded through. Bigger uploads are made
+   * straight from host memory. Defaults to 4 MiB.
+   */
+  stagingByteLength?: number;
+}
+
+export interface TextureUploadOptions {
+  /** The size of the region to fill, in texels */
+  width: number;
+  height: number;
+  /** The region's bottom-left corner. Defaults to 0, 0. */
+  x?: number;
+  y?: number;
+  /** The mipmap level to fill. Defaults to 0. */
+  level?: number;
+  /** The format and type of host memory. Defaults to RGBA and UNSIGNED_BYTE. */
+  format?: number;
+  type?: number;
+  /**
+   * The bytes between rows of device memory, if they aren't packed. Device memory is copied as is,
+   * so it has to be in the texture's own format.
+   */
+  pitch?: number;
+}
+
+/**
+ * Fills 2D textures from host or device memory. Device memory (a `DeviceBuffer`, or a `Column`'s
+ * data) is copied into the texture by CUDA, so a heatmap computed on the GPU never goes through
+ * host memory. Each texture is registered with CUDA the first time it's filled, and stays
+ * registered until `release()`.
+ *
+ * Host memory is written to a persistently mapped pixel unpack buffer, and uploaded from there
+ * without waiting on the GPU. This is also the path without CUDA, e.g. on Mesa.
+ *
+ * ```
+ * const uploader = new TextureUploader(gl, {interop: CUDA.gl});
+ * // each frame:
+ * uploader.upload(texture, counts, {width: 512, height: 512});
+ * ```
+ */
+export class TextureUploader {
+  constructor(context: WebGL2RenderingContext, options: TextureUploaderOptions = {}) {
+    this._gl                = context;
+    this._interop           = options.interop;
+    this._stagingByteLength = options.stagingByteLength ?? 4 * 1024 * 1024;
+  }
+
+  private _gl: WebGL2RenderingContext;
+  private _interop?: TextureInterop;
+  private _stagingByteLength: number;
+  private _staging: StreamingBuffer|null = null;
+  private _resources                     = new Map<WebGLTexture, unknown>();
+
+  /** The number of textures registered with CUDA */
+  public get registered() { return this._resources.size; }
+
+  /** Fill a region of level `level` of `texture`, a TEXTURE_2D, from `source`. */
+  public upload(texture: WebGLTexture, source: TextureSource, options: TextureUploadOptions) {
+    if (ArrayBuffer.isView(source)) {
+      this._uploadHost(texture, source, options);
+    } else {
+      this._uploadDevice(texture, 'ptr' in source ? source : columnData(source), options);
+    }
+  }
+
+  /** Unregister `texture` from CUDA. Call before deleting it or redefining its storage. */
+  public release(texture: WebGLTexture) {
+    const resource = this._resources.get(texture);
+    if (resource !== undefined) {
+      this._resources.delete(texture);
+      this._interop!.unregisterResource(resource);
+    }
+  }
+
+  /** Release every texture, and delete the staging buffer. */
+  public destroy() {
+    [...this._resources.keys()].forEach((texture) => this.release(texture));
+    this._staging?.destroy();
+    this._staging = null;
+  }
+
+  private _uploadDevice(texture: WebGLTexture,
+                        source: DeviceSource,
+                        options: TextureUploadOptions) {
+    if (!this._interop) {
+      throw new TypeError('TextureUploader needs an interop to upload device memory');
+    }
+    const {width, height, x = 0, y = 0, level = 0, pitch = 0} = options;
+    let resource = this._resources.get(texture);
+    if (resource === undefined) {
+      resource = this._interop.registerImage((texture as any).ptr, this._gl.TEXTURE_2D, 0);
+      this._resources.set(texture, resource);
+    }
+    this._interop.copyToImage(resource, source, width, height, x, y, level, pitch);
+  }
+
+  private _uploadHost(texture: WebGLTexture, data: ArrayBufferView, options: TextureUploadOptions) {
+    const gl                                          = this._gl;
+    const {width, height, x = 0, y = 0, level = 0}    = options;
+    const {format = gl.RGBA, type = gl.UNSIGNED_BYTE} = options;
+
+    // Leave the bindings and unpack alignment as we found them
+    const previous  = gl.getParameter(gl.TEXTURE_BINDING_2D);
+    const unpack    = gl.getParameter(gl.PIXEL_UNPACK_BUFFER_BINDING);
+    const alignment = gl.getParameter(gl.UNPACK_ALIGNMENT);
+    gl.bindTexture(gl.TEXTURE_2D, texture);
+    gl.pixelStorei(gl.UNPACK_ALIGNMENT, 1);
+    try {
+      if (data.byteLength > this._stagingByteLength) {
+        gl.bindBuffer(gl.PIXEL_UNPACK_BUFFER, null);
+        gl.texSubImage2D(gl.TEXTURE_2D, level, x, y, width, height, format, type, data);
+      } else {
+        const staging = this._staging ??
+                        (this._staging = new StreamingBuffer(gl, this._stagingByteLength));
+        staging.next().set(new Uint8Array(data.buffer, data.byteOffset, data.byteLength));
+        gl.bindBuffer(gl.PIXEL_UNPACK_BUFFER, staging.buffer);
+        gl.texSubImage2D(gl.TEXTURE_2D, level, x, y, width, height, format, type, staging.offset);
+        staging.fence();
+      }
+    } finally {
+      gl.pixelStorei(gl.UNPACK_ALIGNMENT, alignment);
+      gl.bindBuffer(gl.PIXEL_UNPACK_BUFFER, unpack);
+      gl.bindTexture(gl.TEXTURE_2D, previous);
+    }
+  }
+}
+
+function columnData({data, offset}: ColumnSource) {
+  if (offset !== 0) { throw new RangeError('TextureUploader can\'t upload a sliced column'); }
+  return data;
+}
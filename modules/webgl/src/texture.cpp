@@ -92,7 +92,7 @@ Napi::Value WebGL2RenderingContext::GenTextures(Napi::CallbackInfo const& info)
   CallbackArgs args = info;
   std::vector<GLuint> textures(static_cast<size_t>(args[0]));
   GL_EXPORT::glGenTextures(textures.size(), textures.data());
-  return CPPToNapi(info)(textures);
+  return CPPToNapi(info)(ExternalArray<GLuint>(std::move(textures)));
 }
 
 // GL_EXPORT void glDeleteTextures (GLsizei n, const GLuint *textures);
@@ -47,7 +47,7 @@ Napi::Value WebGL2RenderingContext::CreateTransformFeedbacks(Napi::CallbackInfo
   CallbackArgs args = info;
   std::vector<GLuint> transform_feedbacks(static_cast<size_t>(args[0]));
   GL_EXPORT::glCreateTransformFeedbacks(transform_feedbacks.size(), transform_feedbacks.data());
-  return CPPToNapi(info)(transform_feedbacks);
+  return CPPToNapi(info)(ExternalArray<GLuint>(std::move(transform_feedbacks)));
 }
 
 // GL_EXPORT void glDeleteTransformFeedbacks (GLsizei n, const GLuint* ids);
@@ -123,7 +123,15 @@ Napi::Value WebGL2RenderingContext::TransformFeedbackVaryings(Napi::CallbackInfo
     varyings.begin(), varyings.end(), varying_ptrs.begin(), [&](const std::string& str) {
       return str.data();
     });
-  GL_EXPORT::glTransformFeedbackVaryings(args[0], varyings.size(), varying_ptrs.data(), args[2]);
+  GLuint program     = args[0];
+  GLenum buffer_mode = args[2];
+  GL_EXPORT::glTransformFeedbackVaryings(
+    program, varyings.size(), varying_ptrs.data(), buffer_mode);
+  if (program_cache_) {
+    auto& key = link_inputs_[program].varyings;
+    key       = std::to_string(buffer_mode);
+    for (auto const& varying : varyings) { key += "," + varying; }
+  }
   return info.Env().Undefined();
 }
 
@@ -0,0 +1,362 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "macros.hpp"
+#include "webgl.hpp"
+
+#include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/cpp_to_napi.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace nv {
+
+namespace {
+
+enum class Scalar { Float, Int, Uint, Bool };
+
+// The scalar type, columns and rows of a uniform type. Vectors are one column.
+struct UniformShape {
+  Scalar scalar;
+  GLint columns;
+  GLint rows;
+};
+
+inline bool uniform_shape(GLenum type, UniformShape& shape) {
+  switch (type) {
+    case GL_FLOAT: shape = {Scalar::Float, 1, 1}; return true;
+    case GL_FLOAT_VEC2: shape = {Scalar::Float, 1, 2}; return true;
+    case GL_FLOAT_VEC3: shape = {Scalar::Float, 1, 3}; return true;
+    case GL_FLOAT_VEC4: shape = {Scalar::Float, 1, 4}; return true;
+    case GL_FLOAT_MAT2: shape = {Scalar::Float, 2, 2}; return true;
+    case GL_FLOAT_MAT3: shape = {Scalar::Float, 3, 3}; return true;
+    case GL_FLOAT_MAT4: shape = {Scalar::Float, 4, 4}; return true;
+    case GL_FLOAT_MAT2x3: shape = {Scalar::Float, 2, 3}; return true;
+    case GL_FLOAT_MAT2x4: shape = {Scalar::Float, 2, 4}; return true;
+    case GL_FLOAT_MAT3x2: shape = {Scalar::Float, 3, 2}; return true;
+    case GL_FLOAT_MAT3x4: shape = {Scalar::Float, 3, 4}; return true;
+    case GL_FLOAT_MAT4x2: shape = {Scalar::Float, 4, 2}; return true;
+    case GL_FLOAT_MAT4x3: shape = {Scalar::Float, 4, 3}; return true;
+    case GL_INT: shape = {Scalar::Int, 1, 1}; return true;
+    case GL_INT_VEC2: shape = {Scalar::Int, 1, 2}; return true;
+    case GL_INT_VEC3: shape = {Scalar::Int, 1, 3}; return true;
+    case GL_INT_VEC4: shape = {Scalar::Int, 1, 4}; return true;
+    case GL_UNSIGNED_INT: shape = {Scalar::Uint, 1, 1}; return true;
+    case GL_UNSIGNED_INT_VEC2: shape = {Scalar::Uint, 1, 2}; return true;
+    case GL_UNSIGNED_INT_VEC3: shape = {Scalar::Uint, 1, 3}; return true;
+    case GL_UNSIGNED_INT_VEC4: shape = {Scalar::Uint, 1, 4}; return true;
+    case GL_BOOL: shape = {Scalar::Bool, 1, 1}; return true;
+    case GL_BOOL_VEC2: shape = {Scalar::Bool, 1, 2}; return true;
+    case GL_BOOL_VEC3: shape = {Scalar::Bool, 1, 3}; return true;
+    case GL_BOOL_VEC4: shape = {Scalar::Bool, 1, 4}; return true;
+    case GL_SAMPLER_2D:
+    case GL_SAMPLER_3D:
+    case GL_SAMPLER_CUBE:
+    case GL_SAMPLER_2D_SHADOW:
+    case GL_SAMPLER_2D_ARRAY:
+    case GL_SAMPLER_2D_ARRAY_SHADOW:
+    case GL_SAMPLER_CUBE_SHADOW:
+    case GL_INT_SAMPLER_2D:
+    case GL_INT_SAMPLER_3D:
+    case GL_INT_SAMPLER_CUBE:
+    case GL_INT_SAMPLER_2D_ARRAY:
+    case GL_UNSIGNED_INT_SAMPLER_2D:
+    case GL_UNSIGNED_INT_SAMPLER_3D:
+    case GL_UNSIGNED_INT_SAMPLER_CUBE:
+    case GL_UNSIGNED_INT_SAMPLER_2D_ARRAY: shape = {Scalar::Int, 1, 1}; return true;
+    default: return false;
+  }
+}
+
+// Upload `count` elements of a default block uniform. Floats go straight from `values`, and the
+// rest are converted through `ints`.
+void upload(GLuint program,
+            GLint location,
+            GLenum type,
+            GLsizei count,
+            GLfloat const* values,
+            std::vector<GLint>& ints) {
+  switch (type) {
+    case GL_FLOAT: return GL_EXPORT::glProgramUniform1fv(program, location, count, values);
+    case GL_FLOAT_VEC2: return GL_EXPORT::glProgramUniform2fv(program, location, count, values);
+    case GL_FLOAT_VEC3: return GL_EXPORT::glProgramUniform3fv(program, location, count, values);
+    case GL_FLOAT_VEC4: return GL_EXPORT::glProgramUniform4fv(program, location, count, values);
+    case GL_FLOAT_MAT2:
+      return GL_EXPORT::glProgramUniformMatrix2fv(program, location, count, GL_FALSE, values);
+    case GL_FLOAT_MAT3:
+      return GL_EXPORT::glProgramUniformMatrix3fv(program, location, count, GL_FALSE, values);
+    case GL_FLOAT_MAT4:
+      return GL_EXPORT::glProgramUniformMatrix4fv(program, location, count, GL_FALSE, values);
+    case GL_FLOAT_MAT2x3:
+      return GL_EXPORT::glProgramUniformMatrix2x3fv(program, location, count, GL_FALSE, values);
+    case GL_FLOAT_MAT2x4:
+      return GL_EXPORT::glProgramUniformMatrix2x4fv(program, location, count, GL_FALSE, values);
+    case GL_FLOAT_MAT3x2:
+      return GL_EXPORT::glProgramUniformMatrix3x2fv(program, location, count, GL_FALSE, values);
+    case GL_FLOAT_MAT3x4:
+      return GL_EXPORT::glProgramUniformMatrix3x4fv(program, location, count, GL_FALSE, values);
+    case GL_FLOAT_MAT4x2:
+      return GL_EXPORT::glProgramUniformMatrix4x2fv(program, location, count, GL_FALSE, values);
+    case GL_FLOAT_MAT4x3:
+      return GL_EXPORT::glProgramUniformMatrix4x3fv(program, location, count, GL_FALSE, values);
+    default: break;
+  }
+
+  UniformShape shape{};
+  uniform_shape(type, shape);
+  auto size = count * shape.rows;
+  ints.resize(std::max(ints.size(), static_cast<size_t>(size)));
+  if (shape.scalar == Scalar::Uint) {
+    for (GLint i = 0; i < size; ++i) { ints[i] = static_cast<GLuint>(values[i]); }
+    auto uints = reinterpret_cast<GLuint const*>(ints.data());
+    switch (shape.rows) {
+      case 1: return GL_EXPORT::glProgramUniform1uiv(program, location, count, uints);
+      case 2: return GL_EXPORT::glProgramUniform2uiv(program, location, count, uints);
+      case 3: return GL_EXPORT::glProgramUniform3uiv(program, location, count, uints);
+      default: return GL_EXPORT::glProgramUniform4uiv(program, location, count, uints);
+    }
+  }
+  for (GLint i = 0; i < size; ++i) { ints[i] = static_cast<GLint>(values[i]); }
+  switch (shape.rows) {
+    case 1: return GL_EXPORT::glProgramUniform1iv(program, location, count, ints.data());
+    case 2: return GL_EXPORT::glProgramUniform2iv(program, location, count, ints.data());
+    case 3: return GL_EXPORT::glProgramUniform3iv(program, location, count, ints.data());
+    default: return GL_EXPORT::glProgramUniform4iv(program, location, count, ints.data());
+  }
+}
+
+// Write a uniform block member into the block's std140 (or shared/packed) data, at the offset and
+// strides the program reports
+template <typename Uniform>
+void pack(Uniform const& u, GLfloat const* values, uint8_t* data) {
+  UniformShape shape{};
+  uniform_shape(u.type, shape);
+  for (GLint e = 0; e < u.size; ++e) {
+    for (GLint c = 0; c < shape.columns; ++c) {
+      for (GLint r = 0; r < shape.rows; ++r) {
+        auto value = *values++;
+        auto dst   = data + u.block_offset + e * u.array_stride +
+                   (u.row_major ? r * u.matrix_stride + c * 4 : c * u.matrix_stride + r * 4);
+        switch (shape.scalar) {
+          case Scalar::Float: std::memcpy(dst, &value, 4); break;
+          case Scalar::Int: {
+            auto i = static_cast<GLint>(value);
+            std::memcpy(dst, &i, 4);
+            break;
+          }
+          case Scalar::Uint:
+          case Scalar::Bool: {
+            auto i = shape.scalar == Scalar::Bool ? GLuint{value != 0} : static_cast<GLuint>(value);
+            std::memcpy(dst, &i, 4);
+            break;
+          }
+        }
+      }
+    }
+  }
+}
+
+// One past the last byte of a uniform block member pack() writes
+template <typename Uniform>
+GLintptr member_end(Uniform const& u) {
+  UniformShape shape{};
+  uniform_shape(u.type, shape);
+  auto element = u.row_major ? (shape.rows - 1) * u.matrix_stride + shape.columns * 4
+                             : (shape.columns - 1) * u.matrix_stride + shape.rows * 4;
+  return u.block_offset + (u.size - 1) * u.array_stride + element;
+}
+
+// Fill `data` from the buffer range bound at uniform buffer `binding`, if one is big enough. A
+// layout that names only some of a block's members leaves the rest as they were there.
+void read_bound_block(GLuint binding, std::vector<uint8_t>& data) {
+  GLint buffer{};
+  GLint64 start{}, size{};
+  GL_EXPORT::glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, binding, &buffer);
+  if (buffer == 0) { return; }
+  GL_EXPORT::glGetInteger64i_v(GL_UNIFORM_BUFFER_START, binding, &start);
+  GL_EXPORT::glGetNamedBufferParameteri64v(buffer, GL_BUFFER_SIZE, &size);
+  if (start + static_cast<GLint64>(data.size()) <= size) {
+    GL_EXPORT::glGetNamedBufferSubData(buffer, start, data.size(), data.data());
+  }
+}
+
+// A layout's handle, or the layout createUniformLayout() returned
+inline uint32_t layout_handle(Napi::Value const& value) {
+  return NapiToCPP(value.IsObject() ? value.As<Napi::Object>().Get("handle") : value);
+}
+
+}  // namespace
+
+void WebGL2RenderingContext::ReleaseUniformLayout(UniformLayout const& layout) {
+  for (auto const& block : layout.blocks) {
+    GL_EXPORT::glDeleteBuffers(1, &block.buffer);
+    state_->DeletedBuffer(block.buffer);
+  }
+}
+
+// Resolve the active uniforms named in `names` (or all of them) once, and pack them one after
+// another in a Float32Array layout: `{handle, length, uniforms: [{name, type, size, offset}]}`.
+// Names that aren't active uniforms are left out. Members of uniform blocks are uploaded through a
+// uniform buffer the layout owns, bound with bindBufferRange() at the block's binding. That buffer
+// starts out as a copy of the block's data in the buffer bound there when the layout is created.
+Napi::Value WebGL2RenderingContext::CreateUniformLayout(Napi::CallbackInfo const& info) {
+  auto env          = info.Env();
+  CallbackArgs args = info;
+  GLuint program    = args[0];
+
+  std::vector<GLuint> indices;
+  if (info[1].IsArray()) {
+    std::vector<std::string> names = args[1];
+    std::vector<const GLchar*> name_ptrs(names.size());
+    std::transform(names.begin(), names.end(), name_ptrs.begin(), [&](std::string const& name) {
+      return name.c_str();
+    });
+    indices.resize(names.size());
+    GL_EXPORT::glGetUniformIndices(program, names.size(), name_ptrs.data(), indices.data());
+    indices.erase(std::remove(indices.begin(), indices.end(), GL_INVALID_INDEX), indices.end());
+  } else {
+    GLint count{};
+    GL_EXPORT::glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    for (GLint i = 0; i < count; ++i) { indices.push_back(i); }
+  }
+
+  auto query = [&](GLenum pname) {
+    std::vector<GLint> params(indices.size());
+    if (!indices.empty()) {
+      GL_EXPORT::glGetActiveUniformsiv(
+        program, indices.size(), indices.data(), pname, params.data());
+    }
+    return params;
+  };
+  auto types          = query(GL_UNIFORM_TYPE);
+  auto sizes          = query(GL_UNIFORM_SIZE);
+  auto block_indices  = query(GL_UNIFORM_BLOCK_INDEX);
+  auto block_offsets  = query(GL_UNIFORM_OFFSET);
+  auto array_strides  = query(GL_UNIFORM_ARRAY_STRIDE);
+  auto matrix_strides = query(GL_UNIFORM_MATRIX_STRIDE);
+  auto row_majors     = query(GL_UNIFORM_IS_ROW_MAJOR);
+
+  GLint max_length{};
+  GL_EXPORT::glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &max_length);
+  std::string name(std::max(max_length, 1), '\0');
+
+  UniformLayout layout{};
+  layout.program = program;
+  auto uniforms  = Napi::Array::New(env);
+  for (size_t i = 0; i < indices.size(); ++i) {
+    GLsizei length{};
+    GL_EXPORT::glGetActiveUniformName(program, indices[i], name.size(), &length, &name[0]);
+    UniformShape shape{};
+    if (name.compare(0, 3, "gl_") == 0 || !uniform_shape(types[i], shape)) { continue; }
+
+    UniformLayout::Uniform u{};
+    u.type          = types[i];
+    u.size          = sizes[i];
+    u.offset        = layout.length;
+    u.block_offset  = block_offsets[i];
+    u.array_stride  = array_strides[i];
+    u.matrix_stride = matrix_strides[i];
+    u.row_major     = row_majors[i] != 0;
+    if (block_indices[i] < 0) {
+      u.location = GL_EXPORT::glGetUniformLocation(program, name.c_str());
+    } else {
+      auto block = std::find_if(layout.blocks.begin(), layout.blocks.end(), [&](auto const& b) {
+        return b.index == static_cast<GLuint>(block_indices[i]);
+      });
+      if (block == layout.blocks.end()) {
+        UniformLayout::Block b{};
+        GLint size{}, binding{};
+        b.index = block_indices[i];
+        GL_EXPORT::glGetActiveUniformBlockiv(program, b.index, GL_UNIFORM_BLOCK_DATA_SIZE, &size);
+        GL_EXPORT::glGetActiveUniformBlockiv(program, b.index, GL_UNIFORM_BLOCK_BINDING, &binding);
+        b.binding = binding;
+        b.data.resize(size);
+        b.first = size;
+        read_bound_block(b.binding, b.data);
+        GL_EXPORT::glCreateBuffers(1, &b.buffer);
+        GL_EXPORT::glNamedBufferData(b.buffer, size, b.data.data(), GL_DYNAMIC_DRAW);
+        block = layout.blocks.insert(layout.blocks.end(), std::move(b));
+      }
+      u.block      = block - layout.blocks.begin();
+      block->first = std::min<GLintptr>(block->first, u.block_offset);
+      block->last  = std::max(block->last, member_end(u));
+    }
+    layout.uniforms.push_back(u);
+    layout.length += u.size * shape.columns * shape.rows;
+
+    auto desc = Napi::Object::New(env);
+    desc.Set("name", CPPToNapi(env)(std::string{name.c_str(), static_cast<size_t>(length)}));
+    desc.Set("type", CPPToNapi(env)(u.type));
+    desc.Set("size", CPPToNapi(env)(u.size));
+    desc.Set("offset", CPPToNapi(env)(u.offset));
+    uniforms.Set(uniforms.Length(), desc);
+  }
+
+  auto handle = ++last_uniform_layout_;
+  uniform_layouts_.emplace(handle, std::move(layout));
+
+  auto result = Napi::Object::New(env);
+  result.Set("handle", CPPToNapi(env)(handle));
+  result.Set("length", CPPToNapi(env)(uniform_layouts_[handle].length));
+  result.Set("uniforms", uniforms);
+  return result;
+}
+
+// Upload every uniform in `layout` from the packed `values` in one call
+Napi::Value WebGL2RenderingContext::SetUniforms(Napi::CallbackInfo const& info) {
+  CallbackArgs args    = info;
+  GLuint program       = args[0];
+  uint32_t handle      = layout_handle(info[1]);
+  Span<GLfloat> values = args[2];
+
+  auto it = uniform_layouts_.find(handle);
+  if (it == uniform_layouts_.end() || it->second.program != program) {
+    GLEW_THROW(info.Env(), GL_INVALID_OPERATION);
+  }
+  auto& layout = it->second;
+  if (values.size() < static_cast<size_t>(layout.length)) {
+    GLEW_THROW(info.Env(), GL_INVALID_VALUE);
+  }
+
+  for (auto const& u : layout.uniforms) {
+    auto data = values.data() + u.offset;
+    if (u.block < 0) {
+      if (u.location >= 0) { upload(program, u.location, u.type, u.size, data, layout.ints); }
+    } else {
+      pack(u, data, layout.blocks[u.block].data.data());
+    }
+  }
+  // Only the bytes the layout's members span, so the members it leaves out keep their data
+  for (auto const& block : layout.blocks) {
+    auto size = static_cast<GLsizeiptr>(block.data.size());
+    GL_EXPORT::glNamedBufferSubData(
+      block.buffer, block.first, block.last - block.first, block.data.data() + block.first);
+    GL_EXPORT::glBindBufferRange(GL_UNIFORM_BUFFER, block.binding, block.buffer, 0, size);
+  }
+  if (!layout.blocks.empty()) { state_->ForgetBuffer(GL_UNIFORM_BUFFER); }
+  return info.Env().Undefined();
+}
+
+// Delete a layout and its uniform buffers. Deleting its program deletes it too.
+Napi::Value WebGL2RenderingContext::DeleteUniformLayout(Napi::CallbackInfo const& info) {
+  auto it = uniform_layouts_.find(layout_handle(info[0]));
+  if (it != uniform_layouts_.end()) {
+    ReleaseUniformLayout(it->second);
+    uniform_layouts_.erase(it);
+  }
+  return info.Env().Undefined();
+}
+
+}  // namespace nv
@@ -20,6 +20,34 @@
 
 namespace nv {
 
+namespace {
+
+// The values each attribute takes in createVertexArrayFromLayout()'s layout:
+// buffer, location, size, type, flags, stride, offset, divisor
+constexpr size_t layout_fields = 8;
+
+// Layout flags
+constexpr GLuint layout_normalized = 1;
+constexpr GLuint layout_integer    = 2;
+
+// The size of a vertex of `size` components of `type`, for attributes that are tightly packed
+inline GLsizei packed_stride(GLint size, GLenum type) {
+  switch (type) {
+    case GL_BYTE:
+    case GL_UNSIGNED_BYTE: return size;
+    case GL_SHORT:
+    case GL_UNSIGNED_SHORT:
+    case GL_HALF_FLOAT: return size * 2;
+    case GL_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_2_10_10_10_REV:
+    case GL_UNSIGNED_INT_10F_11F_11F_REV: return 4;
+    case GL_DOUBLE: return size * 8;
+    default: return size * 4;
+  }
+}
+
+}  // namespace
+
 // GL_EXPORT void glCreateVertexArrays (GLsizei n, GLuint* arrays);
 Napi::Value WebGL2RenderingContext::CreateVertexArray(Napi::CallbackInfo const& info) {
   CallbackArgs args = info;
@@ -33,13 +61,50 @@ Napi::Value WebGL2RenderingContext::CreateVertexArrays(Napi::CallbackInfo const&
   CallbackArgs args = info;
   std::vector<GLuint> vertex_arrays(static_cast<size_t>(args[0]));
   GL_EXPORT::glCreateVertexArrays(vertex_arrays.size(), vertex_arrays.data());
-  return CPPToNapi(info.Env())(vertex_arrays);
+  return CPPToNapi(info.Env())(ExternalArray<GLuint>(std::move(vertex_arrays)));
+}
+
+// createVertexArrayFromLayout(layout: Uint32Array, elements?: WebGLBuffer): Create a vertex array
+// with every attribute in `layout` set up, without binding it. Each attribute reads from its own
+// binding point, so each can have its own buffer, stride and divisor.
+Napi::Value WebGL2RenderingContext::CreateVertexArrayFromLayout(Napi::CallbackInfo const& info) {
+  CallbackArgs args   = info;
+  Span<GLuint> layout = args[0];
+  GLuint elements     = info[1].IsUndefined() || info[1].IsNull() ? 0 : args[1].operator GLuint();
+  if (layout.size() % layout_fields != 0) { GLEW_THROW(info.Env(), GL_INVALID_VALUE); }
+
+  GLuint vertex_array{};
+  GL_EXPORT::glCreateVertexArrays(1, &vertex_array);
+  for (size_t i = 0; i < layout.size(); i += layout_fields) {
+    auto attrib     = layout.data() + i;
+    GLuint buffer   = attrib[0];
+    GLuint location = attrib[1];
+    GLint size      = attrib[2];
+    GLenum type     = attrib[3];
+    GLuint flags    = attrib[4];
+    GLsizei stride  = attrib[5] != 0 ? attrib[5] : packed_stride(size, type);
+    GLintptr offset = attrib[6];
+    GLuint divisor  = attrib[7];
+    if (flags & layout_integer) {
+      GL_EXPORT::glVertexArrayAttribIFormat(vertex_array, location, size, type, 0);
+    } else {
+      auto normalized = (flags & layout_normalized) ? GL_TRUE : GL_FALSE;
+      GL_EXPORT::glVertexArrayAttribFormat(vertex_array, location, size, type, normalized, 0);
+    }
+    GL_EXPORT::glVertexArrayVertexBuffer(vertex_array, location, buffer, offset, stride);
+    GL_EXPORT::glVertexArrayAttribBinding(vertex_array, location, location);
+    GL_EXPORT::glVertexArrayBindingDivisor(vertex_array, location, divisor);
+    GL_EXPORT::glEnableVertexArrayAttrib(vertex_array, location);
+  }
+  if (elements != 0) { GL_EXPORT::glVertexArrayElementBuffer(vertex_array, elements); }
+  return WebGLVertexArrayObject::New(vertex_array);
 }
 
 // GL_EXPORT void glBindVertexArray (GLuint array);
 Napi::Value WebGL2RenderingContext::BindVertexArray(Napi::CallbackInfo const& info) {
-  CallbackArgs args = info;
-  GL_EXPORT::glBindVertexArray(args[0]);
+  CallbackArgs args   = info;
+  GLuint vertex_array = args[0];
+  state_->SetVertexArray(vertex_array, [&] { GL_EXPORT::glBindVertexArray(vertex_array); });
   return info.Env().Undefined();
 }
 
@@ -48,6 +113,7 @@ Napi::Value WebGL2RenderingContext::DeleteVertexArray(Napi::CallbackInfo const&
   CallbackArgs args   = info;
   GLuint vertex_array = args[0];
   GL_EXPORT::glDeleteVertexArrays(1, &vertex_array);
+  state_->DeletedVertexArray(vertex_array);
   return info.Env().Undefined();
 }
 
@@ -56,6 +122,7 @@ Napi::Value WebGL2RenderingContext::DeleteVertexArrays(Napi::CallbackInfo const&
   CallbackArgs args                 = info;
   std::vector<GLuint> vertex_arrays = args[0];
   GL_EXPORT::glDeleteVertexArrays(vertex_arrays.size(), vertex_arrays.data());
+  for (auto vertex_array : vertex_arrays) { state_->DeletedVertexArray(vertex_array); }
   return info.Env().Undefined();
 }
 
@@ -14,9 +14,11 @@
 
 #include "webgl.hpp"
 
+#include <nv_node/utilities/trace.hpp>
+
 namespace nv {
 
-Napi::FunctionReference WebGLActiveInfo::constructor;
+ConstructorReference WebGLActiveInfo::constructor;
 
 WebGLActiveInfo::WebGLActiveInfo(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGLActiveInfo>(info){};
@@ -29,10 +31,10 @@ Napi::Object WebGLActiveInfo::Init(Napi::Env env, Napi::Object exports) {
                   InstanceAccessor("size", &WebGLActiveInfo::GetSize, nullptr, napi_enumerable),
                   InstanceAccessor("type", &WebGLActiveInfo::GetType, nullptr, napi_enumerable),
                   InstanceAccessor("name", &WebGLActiveInfo::GetName, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLActiveInfo::ToString),
+                  trace::InstanceMethod(
+                    env, "WebGLActiveInfo", "toString", &WebGLActiveInfo::ToString),
                 });
   WebGLActiveInfo::constructor = Napi::Persistent(ctor);
-  WebGLActiveInfo::constructor.SuppressDestruct();
   exports.Set("WebGLActiveInfo", ctor);
   return exports;
 };
@@ -63,7 +65,7 @@ Napi::Value WebGLActiveInfo::ToString(Napi::CallbackInfo const& info) {
                              " type=" + std::to_string(type_) + " name='" + name_ + "' ]");
 }
 
-Napi::FunctionReference WebGLShaderPrecisionFormat::constructor;
+ConstructorReference WebGLShaderPrecisionFormat::constructor;
 
 WebGLShaderPrecisionFormat::WebGLShaderPrecisionFormat(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGLShaderPrecisionFormat>(info){};
@@ -79,10 +81,10 @@ Napi::Object WebGLShaderPrecisionFormat::Init(Napi::Env env, Napi::Object export
         "rangeMax", &WebGLShaderPrecisionFormat::GetRangeMin, nullptr, napi_enumerable),
       InstanceAccessor(
         "precision", &WebGLShaderPrecisionFormat::GetPrecision, nullptr, napi_enumerable),
-      InstanceMethod("toString", &WebGLShaderPrecisionFormat::ToString),
+      trace::InstanceMethod(
+        env, "WebGLShaderPrecisionFormat", "toString", &WebGLShaderPrecisionFormat::ToString),
     });
   WebGLShaderPrecisionFormat::constructor = Napi::Persistent(ctor);
-  WebGLShaderPrecisionFormat::constructor.SuppressDestruct();
   exports.Set("WebGLShaderPrecisionFormat", ctor);
   return exports;
 };
@@ -114,7 +116,7 @@ Napi::Value WebGLShaderPrecisionFormat::ToString(Napi::CallbackInfo const& info)
       " rangeMin=" + std::to_string(rangeMin_) + " precision=" + std::to_string(precision_) + " ]");
 }
 
-Napi::FunctionReference WebGLBuffer::constructor;
+ConstructorReference WebGLBuffer::constructor;
 
 WebGLBuffer::WebGLBuffer(Napi::CallbackInfo const& info) : Napi::ObjectWrap<WebGLBuffer>(info){};
 
@@ -124,16 +126,19 @@ Napi::Object WebGLBuffer::New(GLuint value) {
   return obj;
 };
 
+bool WebGLBuffer::IsInstance(Napi::Value const& value) {
+  return value.IsObject() && value.As<Napi::Object>().InstanceOf(WebGLBuffer::constructor.Value());
+}
+
 Napi::Object WebGLBuffer::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
     DefineClass(env,
                 "WebGLBuffer",
                 {
                   InstanceAccessor("ptr", &WebGLBuffer::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLBuffer::ToString),
+                  trace::InstanceMethod(env, "WebGLBuffer", "toString", &WebGLBuffer::ToString),
                 });
   WebGLBuffer::constructor = Napi::Persistent(ctor);
-  WebGLBuffer::constructor.SuppressDestruct();
   exports.Set("WebGLBuffer", ctor);
   return exports;
 };
@@ -146,7 +151,7 @@ Napi::Value WebGLBuffer::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLContextEvent::constructor;
+ConstructorReference WebGLContextEvent::constructor;
 
 WebGLContextEvent::WebGLContextEvent(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGLContextEvent>(info){};
@@ -163,10 +168,10 @@ Napi::Object WebGLContextEvent::Init(Napi::Env env, Napi::Object exports) {
                 "WebGLContextEvent",
                 {
                   InstanceAccessor("ptr", &WebGLContextEvent::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLContextEvent::ToString),
+                  trace::InstanceMethod(
+                    env, "WebGLContextEvent", "toString", &WebGLContextEvent::ToString),
                 });
   WebGLContextEvent::constructor = Napi::Persistent(ctor);
-  WebGLContextEvent::constructor.SuppressDestruct();
   exports.Set("WebGLContextEvent", ctor);
   return exports;
 };
@@ -180,7 +185,7 @@ Napi::Value WebGLContextEvent::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLFramebuffer::constructor;
+ConstructorReference WebGLFramebuffer::constructor;
 
 WebGLFramebuffer::WebGLFramebuffer(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGLFramebuffer>(info){};
@@ -197,10 +202,10 @@ Napi::Object WebGLFramebuffer::Init(Napi::Env env, Napi::Object exports) {
                 "WebGLFramebuffer",
                 {
                   InstanceAccessor("ptr", &WebGLFramebuffer::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLFramebuffer::ToString),
+                  trace::InstanceMethod(
+                    env, "WebGLFramebuffer", "toString", &WebGLFramebuffer::ToString),
                 });
   WebGLFramebuffer::constructor = Napi::Persistent(ctor);
-  WebGLFramebuffer::constructor.SuppressDestruct();
   exports.Set("WebGLFramebuffer", ctor);
   return exports;
 };
@@ -214,7 +219,7 @@ Napi::Value WebGLFramebuffer::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLProgram::constructor;
+ConstructorReference WebGLProgram::constructor;
 
 WebGLProgram::WebGLProgram(Napi::CallbackInfo const& info) : Napi::ObjectWrap<WebGLProgram>(info){};
 
@@ -230,10 +235,9 @@ Napi::Object WebGLProgram::Init(Napi::Env env, Napi::Object exports) {
                 "WebGLProgram",
                 {
                   InstanceAccessor("ptr", &WebGLProgram::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLProgram::ToString),
+                  trace::InstanceMethod(env, "WebGLProgram", "toString", &WebGLProgram::ToString),
                 });
   WebGLProgram::constructor = Napi::Persistent(ctor);
-  WebGLProgram::constructor.SuppressDestruct();
   exports.Set("WebGLProgram", ctor);
   return exports;
 };
@@ -246,7 +250,7 @@ Napi::Value WebGLProgram::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLQuery::constructor;
+ConstructorReference WebGLQuery::constructor;
 
 WebGLQuery::WebGLQuery(Napi::CallbackInfo const& info) : Napi::ObjectWrap<WebGLQuery>(info){};
 
@@ -256,16 +260,19 @@ Napi::Object WebGLQuery::New(GLuint value) {
   return obj;
 };
 
+bool WebGLQuery::IsInstance(Napi::Value const& value) {
+  return value.IsObject() && value.As<Napi::Object>().InstanceOf(WebGLQuery::constructor.Value());
+}
+
 Napi::Object WebGLQuery::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
     DefineClass(env,
                 "WebGLQuery",
                 {
                   InstanceAccessor("ptr", &WebGLQuery::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLQuery::ToString),
+                  trace::InstanceMethod(env, "WebGLQuery", "toString", &WebGLQuery::ToString),
                 });
   WebGLQuery::constructor = Napi::Persistent(ctor);
-  WebGLQuery::constructor.SuppressDestruct();
   exports.Set("WebGLQuery", ctor);
   return exports;
 };
@@ -278,7 +285,7 @@ Napi::Value WebGLQuery::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLRenderbuffer::constructor;
+ConstructorReference WebGLRenderbuffer::constructor;
 
 WebGLRenderbuffer::WebGLRenderbuffer(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGLRenderbuffer>(info){};
@@ -295,10 +302,10 @@ Napi::Object WebGLRenderbuffer::Init(Napi::Env env, Napi::Object exports) {
                 "WebGLRenderbuffer",
                 {
                   InstanceAccessor("ptr", &WebGLRenderbuffer::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLRenderbuffer::ToString),
+                  trace::InstanceMethod(
+                    env, "WebGLRenderbuffer", "toString", &WebGLRenderbuffer::ToString),
                 });
   WebGLRenderbuffer::constructor = Napi::Persistent(ctor);
-  WebGLRenderbuffer::constructor.SuppressDestruct();
   exports.Set("WebGLRenderbuffer", ctor);
   return exports;
 };
@@ -312,7 +319,7 @@ Napi::Value WebGLRenderbuffer::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLSampler::constructor;
+ConstructorReference WebGLSampler::constructor;
 
 WebGLSampler::WebGLSampler(Napi::CallbackInfo const& info) : Napi::ObjectWrap<WebGLSampler>(info){};
 
@@ -328,10 +335,9 @@ Napi::Object WebGLSampler::Init(Napi::Env env, Napi::Object exports) {
                 "WebGLSampler",
                 {
                   InstanceAccessor("ptr", &WebGLSampler::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLSampler::ToString),
+                  trace::InstanceMethod(env, "WebGLSampler", "toString", &WebGLSampler::ToString),
                 });
   WebGLSampler::constructor = Napi::Persistent(ctor);
-  WebGLSampler::constructor.SuppressDestruct();
   exports.Set("WebGLSampler", ctor);
   return exports;
 };
@@ -344,7 +350,7 @@ Napi::Value WebGLSampler::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLShader::constructor;
+ConstructorReference WebGLShader::constructor;
 
 WebGLShader::WebGLShader(Napi::CallbackInfo const& info) : Napi::ObjectWrap<WebGLShader>(info){};
 
@@ -360,10 +366,9 @@ Napi::Object WebGLShader::Init(Napi::Env env, Napi::Object exports) {
                 "WebGLShader",
                 {
                   InstanceAccessor("ptr", &WebGLShader::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLShader::ToString),
+                  trace::InstanceMethod(env, "WebGLShader", "toString", &WebGLShader::ToString),
                 });
   WebGLShader::constructor = Napi::Persistent(ctor);
-  WebGLShader::constructor.SuppressDestruct();
   exports.Set("WebGLShader", ctor);
   return exports;
 };
@@ -376,7 +381,7 @@ Napi::Value WebGLShader::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLSync::constructor;
+ConstructorReference WebGLSync::constructor;
 
 WebGLSync::WebGLSync(Napi::CallbackInfo const& info) : Napi::ObjectWrap<WebGLSync>(info){};
 
@@ -386,16 +391,19 @@ Napi::Object WebGLSync::New(GLsync value) {
   return obj;
 };
 
+bool WebGLSync::IsInstance(Napi::Value const& value) {
+  return value.IsObject() && value.As<Napi::Object>().InstanceOf(WebGLSync::constructor.Value());
+}
+
 Napi::Object WebGLSync::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function ctor =
     DefineClass(env,
                 "WebGLSync",
                 {
                   InstanceAccessor("ptr", &WebGLSync::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLSync::ToString),
+                  trace::InstanceMethod(env, "WebGLSync", "toString", &WebGLSync::ToString),
                 });
   WebGLSync::constructor = Napi::Persistent(ctor);
-  WebGLSync::constructor.SuppressDestruct();
   exports.Set("WebGLSync", ctor);
   return exports;
 };
@@ -409,7 +417,7 @@ Napi::Value WebGLSync::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), reinterpret_cast<uintptr_t>(this->value_));
 }
 
-Napi::FunctionReference WebGLTexture::constructor;
+ConstructorReference WebGLTexture::constructor;
 
 WebGLTexture::WebGLTexture(Napi::CallbackInfo const& info) : Napi::ObjectWrap<WebGLTexture>(info){};
 
@@ -425,10 +433,9 @@ Napi::Object WebGLTexture::Init(Napi::Env env, Napi::Object exports) {
                 "WebGLTexture",
                 {
                   InstanceAccessor("ptr", &WebGLTexture::GetValue, nullptr, napi_enumerable),
-                  InstanceMethod("toString", &WebGLTexture::ToString),
+                  trace::InstanceMethod(env, "WebGLTexture", "toString", &WebGLTexture::ToString),
                 });
   WebGLTexture::constructor = Napi::Persistent(ctor);
-  WebGLTexture::constructor.SuppressDestruct();
   exports.Set("WebGLTexture", ctor);
   return exports;
 };
@@ -441,7 +448,7 @@ Napi::Value WebGLTexture::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLTransformFeedback::constructor;
+ConstructorReference WebGLTransformFeedback::constructor;
 
 WebGLTransformFeedback::WebGLTransformFeedback(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGLTransformFeedback>(info){};
@@ -458,10 +465,10 @@ Napi::Object WebGLTransformFeedback::Init(Napi::Env env, Napi::Object exports) {
     "WebGLTransformFeedback",
     {
       InstanceAccessor("ptr", &WebGLTransformFeedback::GetValue, nullptr, napi_enumerable),
-      InstanceMethod("toString", &WebGLTransformFeedback::ToString),
+      trace::InstanceMethod(
+        env, "WebGLTransformFeedback", "toString", &WebGLTransformFeedback::ToString),
     });
   WebGLTransformFeedback::constructor = Napi::Persistent(ctor);
-  WebGLTransformFeedback::constructor.SuppressDestruct();
   exports.Set("WebGLTransformFeedback", ctor);
   return exports;
 };
@@ -475,7 +482,7 @@ Napi::Value WebGLTransformFeedback::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLUniformLocation::constructor;
+ConstructorReference WebGLUniformLocation::constructor;
 
 WebGLUniformLocation::WebGLUniformLocation(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGLUniformLocation>(info){};
@@ -492,10 +499,10 @@ Napi::Object WebGLUniformLocation::Init(Napi::Env env, Napi::Object exports) {
     "WebGLUniformLocation",
     {
       InstanceAccessor("ptr", &WebGLUniformLocation::GetValue, nullptr, napi_enumerable),
-      InstanceMethod("toString", &WebGLUniformLocation::ToString),
+      trace::InstanceMethod(
+        env, "WebGLUniformLocation", "toString", &WebGLUniformLocation::ToString),
     });
   WebGLUniformLocation::constructor = Napi::Persistent(ctor);
-  WebGLUniformLocation::constructor.SuppressDestruct();
   exports.Set("WebGLUniformLocation", ctor);
   return exports;
 };
@@ -509,7 +516,7 @@ Napi::Value WebGLUniformLocation::GetValue(Napi::CallbackInfo const& info) {
   return Napi::Number::New(this->Env(), this->value_);
 }
 
-Napi::FunctionReference WebGLVertexArrayObject::constructor;
+ConstructorReference WebGLVertexArrayObject::constructor;
 
 WebGLVertexArrayObject::WebGLVertexArrayObject(Napi::CallbackInfo const& info)
   : Napi::ObjectWrap<WebGLVertexArrayObject>(info){};
@@ -526,10 +533,10 @@ Napi::Object WebGLVertexArrayObject::Init(Napi::Env env, Napi::Object exports) {
     "WebGLVertexArrayObject",
     {
       InstanceAccessor("ptr", &WebGLVertexArrayObject::GetValue, nullptr, napi_enumerable),
-      InstanceMethod("toString", &WebGLVertexArrayObject::ToString),
+      trace::InstanceMethod(
+        env, "WebGLVertexArrayObject", "toString", &WebGLVertexArrayObject::ToString),
     });
   WebGLVertexArrayObject::constructor = Napi::Persistent(ctor);
-  WebGLVertexArrayObject::constructor.SuppressDestruct();
   exports.Set("WebGLVertexArrayObject", ctor);
   return exports;
 };
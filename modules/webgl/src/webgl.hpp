@@ -15,9 +15,25 @@
 #pragma once
 
 #include "gl.hpp"
+#include "gl_context.hpp"
+#include "handle_pool.hpp"
+#include "program_cache.hpp"
+#include "state_cache.hpp"
+
+#include <nv_node/utilities/args.hpp>
+#include <nv_node/utilities/command_buffer.hpp>
 
 #include <napi.h>
 
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #ifndef GL_GPU_DISJOINT
 #define GL_GPU_DISJOINT 0x8FBB
 #endif
@@ -64,7 +80,9 @@ class WebGLActiveInfo : public Napi::ObjectWrap<WebGLActiveInfo> {
   WebGLActiveInfo(Napi::CallbackInfo const& info);
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetSize(Napi::CallbackInfo const& info);
   Napi::Value GetType(Napi::CallbackInfo const& info);
@@ -83,7 +101,9 @@ class WebGLShaderPrecisionFormat : public Napi::ObjectWrap<WebGLShaderPrecisionF
   WebGLShaderPrecisionFormat(Napi::CallbackInfo const& info);
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetRangeMax(Napi::CallbackInfo const& info);
   Napi::Value GetRangeMin(Napi::CallbackInfo const& info);
@@ -98,12 +118,17 @@ class WebGLBuffer : public Napi::ObjectWrap<WebGLBuffer> {
  public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
   static Napi::Object New(GLuint value);
+  static bool IsInstance(Napi::Value const& value);
 
   WebGLBuffer(Napi::CallbackInfo const& info);
   operator GLuint() { return this->value_; }
+  // Point a recycled wrapper at another object. See handle_pool.hpp.
+  void Reset(GLuint value) { this->value_ = value; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -118,7 +143,9 @@ class WebGLContextEvent : public Napi::ObjectWrap<WebGLContextEvent> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -133,7 +160,9 @@ class WebGLFramebuffer : public Napi::ObjectWrap<WebGLFramebuffer> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -148,7 +177,9 @@ class WebGLProgram : public Napi::ObjectWrap<WebGLProgram> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -158,12 +189,17 @@ class WebGLQuery : public Napi::ObjectWrap<WebGLQuery> {
  public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
   static Napi::Object New(GLuint value);
+  static bool IsInstance(Napi::Value const& value);
 
   WebGLQuery(Napi::CallbackInfo const& info);
   operator GLuint() { return this->value_; }
+  // Point a recycled wrapper at another object. See handle_pool.hpp.
+  void Reset(GLuint value) { this->value_ = value; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -178,7 +214,9 @@ class WebGLRenderbuffer : public Napi::ObjectWrap<WebGLRenderbuffer> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -193,7 +231,9 @@ class WebGLSampler : public Napi::ObjectWrap<WebGLSampler> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -208,7 +248,9 @@ class WebGLShader : public Napi::ObjectWrap<WebGLShader> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -218,12 +260,17 @@ class WebGLSync : public Napi::ObjectWrap<WebGLSync> {
  public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
   static Napi::Object New(GLsync value);
+  static bool IsInstance(Napi::Value const& value);
 
   WebGLSync(Napi::CallbackInfo const& info);
   operator GLsync() { return this->value_; }
+  // Point a recycled wrapper at another object. See handle_pool.hpp.
+  void Reset(GLsync value) { this->value_ = value; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLsync value_{0};
@@ -238,7 +285,9 @@ class WebGLTexture : public Napi::ObjectWrap<WebGLTexture> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -253,7 +302,9 @@ class WebGLTransformFeedback : public Napi::ObjectWrap<WebGLTransformFeedback> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
@@ -268,7 +319,9 @@ class WebGLUniformLocation : public Napi::ObjectWrap<WebGLUniformLocation> {
   operator GLint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLint value_{0};
@@ -283,20 +336,182 @@ class WebGLVertexArrayObject : public Napi::ObjectWrap<WebGLVertexArrayObject> {
   operator GLuint() { return this->value_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
   Napi::Value ToString(Napi::CallbackInfo const& info);
   Napi::Value GetValue(Napi::CallbackInfo const& info);
   GLuint value_{0};
 };
 
+// A GL buffer that stays mapped, split into regions that are written and drawn from in turn. Each
+// region's writes go straight to the mapped memory, and a fence keeps a region from being written
+// again until the GPU is done with it. See streaming.cpp.
+class StreamingBuffer : public Napi::ObjectWrap<StreamingBuffer> {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  // new StreamingBuffer(context, byteLength, regions = 3)
+  StreamingBuffer(Napi::CallbackInfo const& info);
+  ~StreamingBuffer();
+
+ private:
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
+
+  Napi::Value Next(Napi::CallbackInfo const& info);
+  Napi::Value Fence(Napi::CallbackInfo const& info);
+  Napi::Value Destroy(Napi::CallbackInfo const& info);
+  Napi::Value GetBuffer(Napi::CallbackInfo const& info);
+  Napi::Value GetOffset(Napi::CallbackInfo const& info);
+  Napi::Value GetByteLength(Napi::CallbackInfo const& info);
+  Napi::Value GetRegions(Napi::CallbackInfo const& info);
+  void Free();
+  void FreeFences();
+
+  // The mapped buffer. The ArrayBuffer over its memory unmaps and deletes it when that's collected,
+  // unless destroy() did first, so the arrays next() returned never outlive the mapping.
+  struct Mapping {
+    GLContext gl_context;
+    std::shared_ptr<GLStateCache> state;
+    GLuint buffer{};
+  };
+  static void Unmap(Mapping& mapping);
+
+  GLuint buffer_{};
+  Mapping* mapping_{};
+  GLsizeiptr region_size_{};
+  uint32_t region_{};
+  std::vector<GLsync> fences_;
+  Napi::Reference<Napi::ArrayBuffer> memory_;
+  Napi::ObjectReference webgl_buffer_;
+  Napi::ObjectReference context_;
+  // The context's GL context and state cache, which the destructor can't reach through `context_`
+  // if it's collected at the same time
+  GLContext gl_context_;
+  std::shared_ptr<GLStateCache> state_;
+};
+
+// Times named sections of each frame on the GPU with timestamp queries. Results are read a few
+// frames later, once the GPU has written them, so timing never stalls the pipeline, and their
+// queries go back to a pool for later frames. See profiler.cpp.
+class FrameProfiler : public Napi::ObjectWrap<FrameProfiler> {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  // new FrameProfiler(context, window = 120)
+  FrameProfiler(Napi::CallbackInfo const& info);
+  ~FrameProfiler();
+
+ private:
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
+
+  Napi::Value BeginFrame(Napi::CallbackInfo const& info);
+  Napi::Value EndFrame(Napi::CallbackInfo const& info);
+  Napi::Value Begin(Napi::CallbackInfo const& info);
+  Napi::Value End(Napi::CallbackInfo const& info);
+  Napi::Value Collect(Napi::CallbackInfo const& info);
+  Napi::Value Stats(Napi::CallbackInfo const& info);
+  Napi::Value Reset(Napi::CallbackInfo const& info);
+  Napi::Value Destroy(Napi::CallbackInfo const& info);
+  Napi::Value GetWindow(Napi::CallbackInfo const& info);
+  Napi::Value GetPending(Napi::CallbackInfo const& info);
+
+  struct Section {
+    std::string name;
+    GLuint begin;
+    GLuint end;
+  };
+  // The last `window` frames' times of a section, in ms
+  struct Samples {
+    std::vector<double> times;
+    size_t next{};
+  };
+
+  GLuint query();
+  size_t collect(bool wait);
+  void Free();
+
+  GLContext gl_context_;
+  uint32_t window_{};
+  bool in_frame_{};
+  bool destroyed_{};
+  // The sections of the frame being recorded. The first is the whole frame.
+  std::vector<Section> frame_;
+  // The indices in `frame_` of the sections begun and not yet ended
+  std::vector<size_t> open_;
+  // Frames whose queries the GPU may not have written yet, oldest first
+  std::deque<std::vector<Section>> pending_;
+  std::vector<GLuint> pool_;
+  std::map<std::string, Samples> samples_;
+};
+
+// Reads frames of a framebuffer into a ring of persistently mapped pixel pack buffers, and converts
+// them to I420 on the CPU thread pool once the GPU has written them. A slot isn't read into again
+// until its conversion is done. See capture.cpp.
+class FrameCapture : public Napi::ObjectWrap<FrameCapture> {
+ public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+
+  // new FrameCapture(context, width, height, slots = 3)
+  FrameCapture(Napi::CallbackInfo const& info);
+  ~FrameCapture();
+
+ private:
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
+
+  static Napi::Value RGBAToI420(Napi::CallbackInfo const& info);
+
+  Napi::Value Capture(Napi::CallbackInfo const& info);
+  Napi::Value Poll(Napi::CallbackInfo const& info);
+  Napi::Value Convert(Napi::CallbackInfo const& info);
+  Napi::Value Destroy(Napi::CallbackInfo const& info);
+  Napi::Value GetWidth(Napi::CallbackInfo const& info);
+  Napi::Value GetHeight(Napi::CallbackInfo const& info);
+  Napi::Value GetSlots(Napi::CallbackInfo const& info);
+
+  void release();
+
+  struct Slot {
+    enum class State { free, reading, converting };
+    GLuint buffer{};
+    void* pixels{};
+    GLsync fence{};
+    State state{State::free};
+  };
+  GLContext gl_context_;
+  int32_t width_{};
+  int32_t height_{};
+  bool destroyed_{};
+  std::vector<Slot> slots_;
+};
+
 class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
  public:
   static Napi::Object Init(Napi::Env env, Napi::Object exports);
 
   WebGL2RenderingContext(Napi::CallbackInfo const& info);
+  ~WebGL2RenderingContext();
+
+  // The calls a recording context can batch into one `commands.execute()`. See commands.cpp.
+  static CommandTable commands;
+
+  // The shadow copy of the GL state that redundant state calls are checked against
+  inline GLStateCache& state() { return *state_; }
+  inline std::shared_ptr<GLStateCache> const& shared_state() const { return state_; }
+
+  // The GL context that was current when this was created
+  inline GLContext const& gl_context() const { return gl_context_; }
 
  private:
-  static Napi::FunctionReference constructor;
+  template <typename>
+  friend struct LazyClass;
+  static ConstructorReference constructor;
 
   ///
   // misc
@@ -335,6 +550,8 @@ class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
   Napi::Value GetError(Napi::CallbackInfo const& info);
   // GL_EXPORT void glGetParameter (GLint pname);
   Napi::Value GetParameter(Napi::CallbackInfo const& info);
+  // GetParameter() without the caches
+  Napi::Value ReadParameter(Napi::Env env, GLint pname);
   // GL_EXPORT const GLubyte * glGetString (GL_EXTENSIONS);
   Napi::Value GetSupportedExtensions(Napi::CallbackInfo const& info);
   // GL_EXPORT void glHint (GLenum target, GLenum mode);
@@ -350,6 +567,13 @@ class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
   // GL_EXPORT void glReadPixels (GLint x, GLint y, GLsizei width, GLsizei height, GLenum format,
   // GLenum type, void *pixels);
   Napi::Value ReadPixels(Napi::CallbackInfo const& info);
+  // readPixelsAsync(), see readpixels.cpp
+  Napi::Value ReadPixelsToBuffer_(Napi::CallbackInfo const& info);
+  Napi::Value PollPixels_(Napi::CallbackInfo const& info);
+  Napi::Value TakePixels_(Napi::CallbackInfo const& info);
+  Napi::Value ReleasePixels_(Napi::CallbackInfo const& info);
+  // Delete the pixel pack buffers and fences
+  void FreePixelPackRing();
   // GL_EXPORT void glScissor (GLint x, GLint y, GLsizei width, GLsizei height);
   Napi::Value Scissor(Napi::CallbackInfo const& info);
   // GL_EXPORT void glViewport (GLint x, GLint y, GLsizei width, GLsizei height);
@@ -447,6 +671,8 @@ class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
   Napi::Value DeleteBuffer(Napi::CallbackInfo const& info);
   // GL_EXPORT void glDeleteBuffers (GLsizei n, const GLuint* buffers);
   Napi::Value DeleteBuffers(Napi::CallbackInfo const& info);
+  // GL_EXPORT void glDeleteBuffers (GLsizei n, const GLuint* buffers);
+  Napi::Value RecycleBuffer(Napi::CallbackInfo const& info);
   // GL_EXPORT void glGetBufferParameter (GLenum target, GLenum pname, GLint* params);
   Napi::Value GetBufferParameter(Napi::CallbackInfo const& info);
   // GL_EXPORT GLboolean glIsBuffer (GLuint buffer);
@@ -526,6 +752,30 @@ class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
   // GL_EXPORT void glVertexAttribDivisor (GLuint index, GLuint divisor);
   Napi::Value VertexAttribDivisor(Napi::CallbackInfo const& info);
 
+  ///
+  // multi-draw and indirect
+  ///
+  // GL_EXPORT void glMultiDrawArrays (GLenum mode, const GLint* first, const GLsizei *count,
+  // GLsizei drawcount);
+  Napi::Value MultiDrawArrays(Napi::CallbackInfo const& info);
+  // GL_EXPORT void glMultiDrawElements (GLenum mode, const GLsizei* count, GLenum type, const void
+  // *const* indices, GLsizei drawcount);
+  Napi::Value MultiDrawElements(Napi::CallbackInfo const& info);
+  // glDrawArraysInstanced() for each of the lists' draws
+  Napi::Value MultiDrawArraysInstanced(Napi::CallbackInfo const& info);
+  // glDrawElementsInstanced() for each of the lists' draws
+  Napi::Value MultiDrawElementsInstanced(Napi::CallbackInfo const& info);
+  // GL_EXPORT void glDrawArraysIndirect (GLenum mode, const void *indirect);
+  Napi::Value DrawArraysIndirect(Napi::CallbackInfo const& info);
+  // GL_EXPORT void glDrawElementsIndirect (GLenum mode, GLenum type, const void *indirect);
+  Napi::Value DrawElementsIndirect(Napi::CallbackInfo const& info);
+  // GL_EXPORT void glMultiDrawArraysIndirect (GLenum mode, const void *indirect, GLsizei
+  // primcount, GLsizei stride);
+  Napi::Value MultiDrawArraysIndirect(Napi::CallbackInfo const& info);
+  // GL_EXPORT void glMultiDrawElementsIndirect (GLenum mode, GLenum type, const void *indirect,
+  // GLsizei primcount, GLsizei stride);
+  Napi::Value MultiDrawElementsIndirect(Napi::CallbackInfo const& info);
+
   ///
   // program
   ///
@@ -560,6 +810,7 @@ class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
   Napi::Value DeleteQuery(Napi::CallbackInfo const& info);
   // GL_EXPORT void glDeleteQueries (GLsizei n, const GLuint* ids);
   Napi::Value DeleteQueries(Napi::CallbackInfo const& info);
+  Napi::Value RecycleQuery(Napi::CallbackInfo const& info);
   // GL_EXPORT void glEndQuery (GLenum target);
   Napi::Value EndQuery(Napi::CallbackInfo const& info);
   // GL_EXPORT void glGetQueryiv (GLenum target, GLenum pname, GLint* params);
@@ -682,6 +933,8 @@ class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
   Napi::Value DeleteSync(Napi::CallbackInfo const& info);
   // GL_EXPORT GLsync glFenceSync (GLenum condition, GLbitfield flags);
   Napi::Value FenceSync(Napi::CallbackInfo const& info);
+  // GL_EXPORT void glDeleteSync (GLsync GLsync);
+  Napi::Value RecycleSync(Napi::CallbackInfo const& info);
   // GL_EXPORT void glGetSynciv (GLsync GLsync,GLenum pname,GLsizei bufSize,GLsizei* length, GLint
   // *values);
   Napi::Value GetSyncParameter(Napi::CallbackInfo const& info);
@@ -904,6 +1157,8 @@ class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
   Napi::Value CreateVertexArray(Napi::CallbackInfo const& info);
   // GL_EXPORT void glCreateVertexArrays (GLsizei n, GLuint* arrays);
   Napi::Value CreateVertexArrays(Napi::CallbackInfo const& info);
+  // Create a vertex array with every attribute of a packed layout set up, through DSA
+  Napi::Value CreateVertexArrayFromLayout(Napi::CallbackInfo const& info);
   // GL_EXPORT void glBindVertexArray (GLuint array);
   Napi::Value BindVertexArray(Napi::CallbackInfo const& info);
   // GL_EXPORT void glDeleteVertexArrays (GLsizei n, const GLuint* arrays);
@@ -915,11 +1170,136 @@ class WebGL2RenderingContext : public Napi::ObjectWrap<WebGL2RenderingContext> {
 
   Napi::Value GetContextAttributes(Napi::CallbackInfo const& info);
 
+  ///
+  // state cache
+  ///
+  // { issued, elided } counts of the calls routed through the state cache
+  Napi::Value GetStateCacheStats(Napi::CallbackInfo const& info);
+  // Forget the cached state, after changing it outside this context
+  Napi::Value InvalidateStateCache(Napi::CallbackInfo const& info);
+
+  ///
+  // program cache
+  ///
+  // { hits, misses, directory } of the program binary cache, or null if it's off
+  Napi::Value GetProgramCacheStats(Napi::CallbackInfo const& info);
+  // The cache key of `shader`'s type and source
+  uint64_t ShaderKey(GLuint shader);
+  // Compile `shader` if its compile was deferred
+  void CompileDeferred(GLuint shader);
+
+  ///
+  // error checks
+  ///
+  // `method`, then a glGetError() check that throws in `strict` mode
+  template <Napi::Value (WebGL2RenderingContext::*method)(Napi::CallbackInfo const&)>
+  Napi::Value Checked(Napi::CallbackInfo const& info);
+  // { messages, dropped } of the KHR_debug messages logged since the last call
+  Napi::Value GetDebugMessages(Napi::CallbackInfo const& info);
+  // Log the driver's KHR_debug messages to `debug_log_`
+  void InstallDebugLog();
+
+  ///
+  // uniform layouts
+  ///
+  // Resolve a program's uniforms into a packed Float32Array layout
+  Napi::Value CreateUniformLayout(Napi::CallbackInfo const& info);
+  // Upload every uniform in a layout from one packed Float32Array
+  Napi::Value SetUniforms(Napi::CallbackInfo const& info);
+  Napi::Value DeleteUniformLayout(Napi::CallbackInfo const& info);
+
   Napi::Value GetClearMask_(Napi::CallbackInfo const& info);
   void SetClearMask_(Napi::CallbackInfo const& info, Napi::Value const& value);
 
+  // The GL context that was current when this was created
+  GLContext gl_context_{GLContext::Current()};
   GLbitfield clear_mask_{};
   Napi::ObjectReference context_attributes_;
+  // getParameter() values that can't change, by pname
+  Napi::ObjectReference parameters_;
+  // getSupportedExtensions(), once it's been called
+  Napi::ObjectReference supported_extensions_;
+  std::shared_ptr<GLStateCache> state_;
+  // Buffer and query names generated in batches for the create*() calls, and deleted with the
+  // context, and the wrappers passed to recycle*() for those calls to reuse. See handle_pool.hpp.
+  NamePool buffer_names_{[](GLsizei n, GLuint* names) { GL_EXPORT::glCreateBuffers(n, names); }};
+  NamePool query_names_{[](GLsizei n, GLuint* names) { GL_EXPORT::glGenQueries(n, names); }};
+  WrapperPool<WebGLBuffer> buffer_wrappers_;
+  WrapperPool<WebGLQuery> query_wrappers_;
+  WrapperPool<WebGLSync> sync_wrappers_;
+  // How calls are checked for GL errors, from the `errorChecks` attribute. `none` never checks,
+  // `debug` logs the driver's KHR_debug messages, and `strict` checks glGetError() after each call.
+  enum class ErrorChecks { none, debug, strict };
+  ErrorChecks error_checks_{ErrorChecks::none};
+  // The messages the debug callback logged, until getDebugMessages() takes them. The driver may
+  // call back from its own threads. See debug.cpp.
+  struct DebugMessage {
+    GLenum source;
+    GLenum type;
+    GLuint id;
+    GLenum severity;
+    std::string message;
+  };
+  struct DebugLog {
+    std::mutex mutex;
+    std::deque<DebugMessage> messages;
+    uint32_t dropped{};
+  };
+  std::unique_ptr<DebugLog> debug_log_;
+  // The pixel pack buffers readPixelsAsync() reads into. A slot is reused once its pixels are
+  // taken, and the ring grows when every slot has a read in flight, up to 16 slots.
+  struct PixelPackSlot {
+    GLuint buffer{};
+    GLsizeiptr capacity{};
+    GLsizeiptr size{};
+    GLsync fence{};
+    bool busy{};
+  };
+  std::vector<PixelPackSlot> pixel_pack_ring_;
+  // Linked program binaries on disk, if the `programCache` attribute or
+  // NVIDIA_NODE_WEBGL_PROGRAM_CACHE names a directory
+  std::unique_ptr<ProgramCache> program_cache_;
+  // With `deferCompile`, shaders whose source has compiled cleanly before. Compiled only if a link
+  // misses the cache.
+  std::unordered_set<GLuint> deferred_shaders_;
+  // What goes into each program's link besides its shaders, for the program cache's key
+  struct LinkInputs {
+    std::map<std::string, GLuint> attribs;
+    std::string varyings;
+  };
+  std::unordered_map<GLuint, LinkInputs> link_inputs_;
+  // The layouts createUniformLayout() resolved, by handle. See uniform_layout.cpp.
+  struct UniformLayout {
+    struct Uniform {
+      GLenum type{};
+      GLint size{};
+      GLint location{-1};
+      GLsizei offset{};  // in the packed values, in floats
+      GLint block{-1};   // in `blocks`, or -1 for the default block
+      GLint block_offset{};
+      GLint array_stride{};
+      GLint matrix_stride{};
+      bool row_major{};
+    };
+    struct Block {
+      GLuint index{};
+      GLuint binding{};
+      GLuint buffer{};
+      std::vector<uint8_t> data;
+      // The bytes the layout's members span, which are all setUniforms() uploads
+      GLintptr first{};
+      GLintptr last{};
+    };
+    GLuint program{};
+    GLsizei length{};
+    std::vector<Uniform> uniforms;
+    std::vector<Block> blocks;
+    std::vector<GLint> ints;  // int uniforms, converted from the packed floats
+  };
+  // Delete a layout's uniform buffers
+  void ReleaseUniformLayout(UniformLayout const& layout);
+  std::unordered_map<uint32_t, UniformLayout> uniform_layouts_;
+  uint32_t last_uniform_layout_{};
   // Pixel storage flags
   bool unpack_flip_y_{};
   bool unpack_premultiply_alpha_{};
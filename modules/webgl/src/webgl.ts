@@ -27,14 +27,177 @@ import gl from './addon';
 //     stencil: false,
 //     desynchronized: false
 
+export interface OpenGLESContextAttributes extends WebGLContextAttributes {
+  /**
+   * Skip state calls (`useProgram`, `bindBuffer`, `enable`, `viewport`, ...) that wouldn't change
+   * the current GL state, and answer `getParameter` for that state without asking the driver.
+   * Contexts created on the same GL context share the cache, and `false` turns it off for all of
+   * them. Defaults to `true`.
+   *
+   * Unless `errorChecks` is `debug` or `strict`, state calls aren't checked for errors before
+   * they're cached, so a failed call is cached as if it succeeded until `getError()` reports an
+   * error, which clears the cache.
+   */
+  stateCache?: boolean;
+  /**
+   * Cache linked program binaries in `directory`, and load them instead of compiling and linking
+   * the same shaders again. `directory` defaults to `NVIDIA_NODE_WEBGL_PROGRAM_CACHE`, and the
+   * cache is off if neither is set. Least recently used binaries are evicted past `maxBytes`
+   * (64MiB by default).
+   *
+   * `deferCompile` also skips compiling shaders whose source has compiled cleanly before, unless a
+   * link misses the cache. Until then they report COMPILE_STATUS true and a null info log.
+   * Defaults to `false`.
+   */
+  programCache?: false|{directory?: string, maxBytes?: number, deferCompile?: boolean};
+  /**
+   * How calls are checked for GL errors. `none` (the default) never checks. `debug` logs the
+   * driver's KHR_debug errors and warnings without synchronizing, for `getDebugMessages()`, and
+   * leaves out its notifications. `strict` calls `glGetError()` after every call, and throws if it
+   * failed. A recording context's calls are checked once per `submit()`.
+   */
+  errorChecks?: 'none'|'debug'|'strict';
+}
+
+export interface OpenGLESDebugMessage {
+  source: GLenum;
+  type: GLenum;
+  id: GLuint;
+  severity: GLenum;
+  message: string;
+}
+
+export interface WebGLUniformLayout {
+  readonly handle: number;
+  /** The number of floats `setUniforms()` reads */
+  readonly length: number;
+  readonly uniforms: ReadonlyArray<{name: string, type: GLenum, size: number, offset: number}>;
+}
+
 interface OpenGLESRenderingContext extends WebGL2RenderingContext {
   // eslint-disable-next-line @typescript-eslint/no-misused-new
-  new(attrs?: WebGLContextAttributes): OpenGLESRenderingContext;
+  new(attrs?: OpenGLESContextAttributes): OpenGLESRenderingContext;
   webgl1: boolean;
   webgl2: boolean;
   opengl: boolean;
   _version: number;
   _clearMask: number;
+  /** The number of state calls that went to the driver, and that the state cache skipped */
+  getStateCacheStats(): {issued: number, elided: number};
+  /** Forget the cached GL state. Call after changing GL state outside this context. */
+  invalidateStateCache(): void;
+  /**
+   * Create `count` buffers in one call, and return their names. Every call that takes a
+   * WebGLBuffer takes its name too, so this allocates no wrappers. `createBuffer()` also takes
+   * names from a pool generated in batches.
+   */
+  createBuffers(count: GLsizei): Uint32Array;
+  /** Delete buffers by name or WebGLBuffer. */
+  deleteBuffers(buffers: ArrayLike<GLuint|WebGLBuffer>): void;
+  /** Create `count` queries in one call, and return their names. See `createBuffers()`. */
+  createQueries(count: GLsizei): Uint32Array;
+  /** Delete queries by name or WebGLQuery. */
+  deleteQueries(queries: ArrayLike<GLuint|WebGLQuery>): void;
+  /**
+   * Delete `buffer`, and keep its WebGLBuffer for a later `createBuffer()` to return, pointed at
+   * the new buffer, instead of allocating a new one. Unlike `deleteBuffer()`, the object doesn't
+   * keep its identity: only recycle a buffer once nothing else holds it, including a
+   * CommandEncoder handle, a TextureUploader or a cache keyed on it.
+   */
+  recycleBuffer(buffer: WebGLBuffer): void;
+  /**
+   * Keep `query` for a later `createQuery()` to return, with its GL name. See `recycleBuffer()`.
+   * It mustn't be active.
+   */
+  recycleQuery(query: WebGLQuery): void;
+  /** Delete `sync`, and keep its WebGLSync for a later `fenceSync()`. See `recycleBuffer()`. */
+  recycleSync(sync: WebGLSync): void;
+  /** Links loaded from and stored to the program cache, or null if it's off */
+  getProgramCacheStats(): {hits: number, misses: number, directory: string}|null;
+  /**
+   * The driver messages logged since the last call when `errorChecks` is `debug`, oldest first.
+   * `dropped` counts the older messages that didn't fit in the log.
+   */
+  getDebugMessages(): {messages: OpenGLESDebugMessage[], dropped: number};
+  /**
+   * Resolve `program`'s active uniforms named in `names` (or all of them) into a packed layout.
+   * Each uniform's values start at its `offset` in the Float32Array passed to `setUniforms()`,
+   * column-major for matrices. Names that aren't active uniforms are left out.
+   */
+  createUniformLayout(program: WebGLProgram, names?: string[]): WebGLUniformLayout;
+  /**
+   * Upload every uniform in `layout` from `values` in one call. Members of uniform blocks are
+   * written to a uniform buffer owned by the layout, and bound with `bindBufferRange()` at the
+   * block's binding. Block members the layout doesn't name keep the values they had in the buffer
+   * bound there when the layout was created.
+   */
+  setUniforms(program: WebGLProgram, layout: WebGLUniformLayout|number, values: Float32Array): void;
+  /** Delete `layout` and its uniform buffers. Deleting its program deletes it too. */
+  deleteUniformLayout(layout: WebGLUniformLayout|number): void;
+  /**
+   * Create a vertex array with every attribute in `layout` set up, in one call. `layout` holds 8
+   * values per attribute:
+   *
+   * `buffer.ptr, location, size, type, flags, stride, offset, divisor`
+   *
+   * where `flags` is 1 for normalized attributes, and 2 for integer attributes (like
+   * `vertexAttribIPointer()`). A `stride` of 0 means tightly packed. The vertex array isn't bound.
+   */
+  createVertexArrayFromLayout(layout: Uint32Array, elements?: WebGLBuffer|null):
+    WebGLVertexArrayObject;
+  /**
+   * Draw `drawcount` ranges of vertices in one call. `drawcount` defaults to the length of the
+   * shorter list.
+   */
+  multiDrawArrays(mode: GLenum, firsts: Int32Array, counts: Int32Array, drawcount?: GLsizei): void;
+  /** Draw `drawcount` ranges of elements in one call. `offsets` are byte offsets. */
+  multiDrawElements(
+    mode: GLenum, counts: Int32Array, type: GLenum, offsets: Int32Array, drawcount?: GLsizei): void;
+  multiDrawArraysInstanced(mode: GLenum,
+                           firsts: Int32Array,
+                           counts: Int32Array,
+                           instanceCounts: Int32Array,
+                           drawcount?: GLsizei): void;
+  multiDrawElementsInstanced(mode: GLenum,
+                             counts: Int32Array,
+                             type: GLenum,
+                             offsets: Int32Array,
+                             instanceCounts: Int32Array,
+                             drawcount?: GLsizei): void;
+  /**
+   * Draw with the parameters at byte `offset` in the bound DRAW_INDIRECT_BUFFER, laid out as
+   * `{count, instanceCount, first, baseInstance}` uint32s.
+   */
+  drawArraysIndirect(mode: GLenum, offset: GLintptr): void;
+  /**
+   * Draw with the parameters at byte `offset` in the bound DRAW_INDIRECT_BUFFER, laid out as
+   * `{count, instanceCount, firstIndex, baseVertex, baseInstance}` uint32s.
+   */
+  drawElementsIndirect(mode: GLenum, type: GLenum, offset: GLintptr): void;
+  /** `drawcount` draws from the bound DRAW_INDIRECT_BUFFER, `stride` bytes apart (0 if packed) */
+  multiDrawArraysIndirect(mode: GLenum, offset: GLintptr, drawcount: GLsizei, stride?: GLsizei):
+    void;
+  multiDrawElementsIndirect(
+    mode: GLenum, type: GLenum, offset: GLintptr, drawcount: GLsizei, stride?: GLsizei): void;
+  /**
+   * Like `readPixels()`, but without waiting for the GPU. Reads into a pixel pack buffer, and
+   * resolves with the pixels once the read is done. The pixels are laid out as readPixels() would
+   * write them, so the PACK_ALIGNMENT, PACK_ROW_LENGTH, PACK_SKIP_PIXELS, and PACK_SKIP_ROWS all
+   * apply. The read is finished against this context even if another one is current by then.
+   * Rejects with INVALID_VALUE for a negative `width` or `height`, and with an Error when 16 reads
+   * are already in flight.
+   */
+  readPixelsAsync(x: GLint,
+                  y: GLint,
+                  width: GLsizei,
+                  height: GLsizei,
+                  format: GLenum,
+                  type: GLenum): Promise<ArrayBufferView>;
+  _readPixelsToBuffer(
+    x: GLint, y: GLint, width: GLsizei, height: GLsizei, format: GLenum, type: GLenum): number;
+  _pollPixels(slot: number): boolean;
+  _takePixels(slot: number): ArrayBuffer;
+  _releasePixels(slot: number): void;
 }
 
 // eslint-disable-next-line @typescript-eslint/no-redeclare
@@ -64,6 +227,148 @@ export const WebGLVertexArrayObject     = gl.WebGLVertexArrayObject;
 export {OpenGLESRenderingContext as WebGLRenderingContext};
 export {OpenGLESRenderingContext as WebGL2RenderingContext};
 
+/**
+ * A GL buffer that stays mapped, for data that changes every frame. It's split into `regions`
+ * regions of `byteLength` bytes that are used in turn: `next()` returns the next region's mapped
+ * memory to write into, and `fence()` marks the end of the GL calls that read it. The region isn't
+ * handed out again until the GPU has finished those calls, so writes never stall the pipeline or
+ * go through a driver-side copy.
+ *
+ * ```
+ * const stream = new StreamingBuffer(gl, 4 * 1024 * 1024);
+ * // each frame:
+ * const region = stream.next();
+ * new Float32Array(region.buffer, region.byteOffset, positions.length).set(positions);
+ * gl.bindBuffer(gl.ARRAY_BUFFER, stream.buffer);
+ * gl.vertexAttribPointer(0, 2, gl.FLOAT, false, 0, stream.offset);
+ * gl.drawArrays(gl.POINTS, 0, count);
+ * stream.fence();
+ * ```
+ */
+export interface StreamingBuffer {
+  /** The GL buffer, to bind as an ARRAY_BUFFER, PIXEL_UNPACK_BUFFER, UNIFORM_BUFFER, etc. */
+  readonly buffer: WebGLBuffer;
+  /** The current region's offset in `buffer`, in bytes */
+  readonly offset: number;
+  /** The size of each region, rounded up to a multiple of 256 bytes */
+  readonly byteLength: number;
+  readonly regions: number;
+  /**
+   * Move to the next region, and return its mapped memory. Waits if the GPU is still using it,
+   * and throws if it still is after 5 seconds.
+   */
+  next(): Uint8Array;
+  /** Mark the end of the GL calls that read the current region. */
+  fence(): void;
+  /**
+   * Unmap and delete the buffer. Detaches the arrays next() returned. Otherwise it's done once
+   * the StreamingBuffer and every array next() returned are garbage collected. Call before
+   * destroying the GL context.
+   */
+  destroy(): void;
+}
+
+// eslint-disable-next-line @typescript-eslint/no-redeclare
+export const StreamingBuffer: {
+  new(context: WebGL2RenderingContext, byteLength: number, regions?: number): StreamingBuffer;
+} = gl.StreamingBuffer;
+
+/**
+ * Times named sections of each frame on the GPU. Sections are bracketed with timestamp queries,
+ * and their results are read once the GPU has written them, a few frames later, so profiling
+ * doesn't stall rendering. `stats()` reports each section over the last `window` frames read.
+ *
+ * ```
+ * const profiler = new FrameProfiler(gl);
+ * // each frame:
+ * profiler.beginFrame();
+ * for (const layer of layers) {
+ *   profiler.begin(layer.id);
+ *   layer.draw();
+ *   profiler.end();
+ * }
+ * profiler.endFrame();
+ * // later:
+ * console.log(profiler.stats());
+ * ```
+ */
+export interface FrameProfiler {
+  /** The number of frames each section's stats cover */
+  readonly window: number;
+  /** The number of frames ended whose times haven't been read yet */
+  readonly pending: number;
+  /** Start a frame. Its time is reported as the "frame" section. */
+  beginFrame(): void;
+  /** End the frame, and read the times of the frames the GPU has finished. */
+  endFrame(): void;
+  /** Start timing `name`. Sections can nest, and times of a name begun twice a frame add up. */
+  begin(name: string): void;
+  /** Stop timing the section begun last. */
+  end(): void;
+  /** Read the frames the GPU has finished, or wait for every pending frame if `wait`. */
+  collect(wait?: boolean): number;
+  /** Each section's GPU time, in milliseconds */
+  stats(): Record<string, FrameProfilerStats>;
+  /** Forget the times read so far. */
+  reset(): void;
+  /** Delete the queries. Also done when the FrameProfiler is garbage collected. */
+  destroy(): void;
+}
+
+export interface FrameProfilerStats {
+  count: number;
+  mean: number;
+  min: number;
+  max: number;
+  p50: number;
+  p90: number;
+  p99: number;
+}
+
+// eslint-disable-next-line @typescript-eslint/no-redeclare
+export const FrameProfiler: {
+  new(context: WebGL2RenderingContext, window?: number): FrameProfiler;
+} = gl.FrameProfiler;
+
+/**
+ * An OpenGL context created through EGL without a window system, for rendering on servers and in
+ * CI. It draws to an offscreen `width` x `height` framebuffer, and is current once constructed.
+ * Create a `WebGL2RenderingContext` while it's current, and call `makeCurrent()` before drawing
+ * with it if the process has other contexts.
+ *
+ * ```
+ * const context = new HeadlessContext({width: 800, height: 600});
+ * const gl      = new WebGL2RenderingContext();
+ * ```
+ */
+export interface HeadlessContext {
+  readonly width: number;
+  readonly height: number;
+  /** The EGL device's index, or -1 if the context is on Mesa's surfaceless platform */
+  readonly device: number;
+  /** Whether the device is a software renderer, like Mesa's llvmpipe */
+  readonly software: boolean;
+  makeCurrent(): void;
+  isCurrent(): boolean;
+  /** Destroy the context and its framebuffer. */
+  destroy(): void;
+}
+
+export interface HeadlessContextOptions {
+  /** The size of the default framebuffer. Defaults to 1 x 1. */
+  width?: number;
+  height?: number;
+  /** The index of the EGL device to create the context on. Defaults to 0. */
+  device?: number;
+  /** Create the context on the first software device instead of on `device`. */
+  software?: boolean;
+}
+
+// eslint-disable-next-line @typescript-eslint/no-redeclare
+export const HeadlessContext: {
+  new(options?: HeadlessContextOptions): HeadlessContext;
+} = gl.HeadlessContext;
+
 const gl_bufferData                           = OpenGLESRenderingContext.prototype.bufferData;
 OpenGLESRenderingContext.prototype.bufferData = bufferData;
 function bufferData(
@@ -391,6 +696,57 @@ function readPixels(this: WebGL2RenderingContext, ...args: [GLint, GLint, GLsize
   return gl_readPixels.call(this, x, y, width, height, format, type, dst);
 }
 
+OpenGLESRenderingContext.prototype.readPixelsAsync = readPixelsAsync;
+function readPixelsAsync(this: OpenGLESRenderingContext,
+                         x: GLint,
+                         y: GLint,
+                         width: GLsizei,
+                         height: GLsizei,
+                         format: GLenum,
+                         type: GLenum) {
+  // Reads into a pixel pack buffer and fences the read, so this returns before the GPU is done
+  let slot: number;
+  try {
+    slot = this._readPixelsToBuffer(x, y, width, height, format, type);
+  } catch (e) { return Promise.reject(e); }
+  return new Promise<ArrayBufferView>((resolve, reject) => {
+    const poll = () => {
+      try {
+        if (!this._pollPixels(slot)) {
+          setTimeout(poll, 1);
+        } else {
+          resolve(pixelArray(this, type, this._takePixels(slot)));
+        }
+      } catch (e) {
+        this._releasePixels(slot);
+        reject(e);
+      }
+    };
+    setImmediate(poll);
+  });
+}
+
+// The array type readPixels() takes for `type`, over `buffer`
+function pixelArray(context: WebGL2RenderingContext, type: GLenum, buffer: ArrayBuffer) {
+  switch (type) {
+    case context.FLOAT: return new Float32Array(buffer, 0, buffer.byteLength >> 2);
+    case context.INT: return new Int32Array(buffer, 0, buffer.byteLength >> 2);
+    case context.SHORT: return new Int16Array(buffer, 0, buffer.byteLength >> 1);
+    case context.BYTE: return new Int8Array(buffer);
+    case context.HALF_FLOAT:
+    case context.UNSIGNED_SHORT:
+    case context.UNSIGNED_SHORT_5_6_5:
+    case context.UNSIGNED_SHORT_4_4_4_4:
+    case context.UNSIGNED_SHORT_5_5_5_1: return new Uint16Array(buffer, 0, buffer.byteLength >> 1);
+    case context.UNSIGNED_INT:
+    case context.UNSIGNED_INT_2_10_10_10_REV:
+    case context.UNSIGNED_INT_10F_11F_11F_REV:
+    case context.UNSIGNED_INT_5_9_9_9_REV:
+    case context.UNSIGNED_INT_24_8: return new Uint32Array(buffer, 0, buffer.byteLength >> 2);
+    default: return new Uint8Array(buffer);
+  }
+}
+
 const gl_uniform1fv                           = OpenGLESRenderingContext.prototype.uniform1fv;
 OpenGLESRenderingContext.prototype.uniform1fv = uniform1fv;
 function uniform1fv(
@@ -666,6 +1022,14 @@ function pixelsFromImage(source: TexImageSource, width: number, height: number)
 
 const nodeCustomInspectSym = Symbol.for('nodejs.util.inspect.custom');
 
+type MultiDrawList = Int32Array|Uint32Array|number[];
+
+// WEBGL_multi_draw passes each list with the offset of its first element
+function multiDrawList(list: MultiDrawList, offset: number, drawcount: number) {
+  if (Array.isArray(list)) { return new Int32Array(list.slice(offset, offset + drawcount)); }
+  return new Int32Array(list.buffer, list.byteOffset + offset * 4, list.length - offset);
+}
+
 const extensionsMap: any = {
   ANGLE_instanced_arrays: {
     VERTEX_ATTRIB_ARRAY_DIVISOR_ANGLE:
@@ -900,4 +1264,66 @@ const extensionsMap: any = {
     restoreContext() {},
   },
   EXT_float_blend: {},
+  WEBGL_multi_draw: {
+    MAX_DRAW_COUNT_WEBGL: 2147483647,
+    multiDrawArraysWEBGL(this: OpenGLESRenderingContext,
+                         mode: GLenum,
+                         firsts: MultiDrawList,
+                         firstsOffset: number,
+                         counts: MultiDrawList,
+                         countsOffset: number,
+                         drawcount: GLsizei) {
+      this.multiDrawArrays(mode,
+                           multiDrawList(firsts, firstsOffset, drawcount),
+                           multiDrawList(counts, countsOffset, drawcount),
+                           drawcount);
+    },
+    multiDrawElementsWEBGL(this: OpenGLESRenderingContext,
+                           mode: GLenum,
+                           counts: MultiDrawList,
+                           countsOffset: number,
+                           type: GLenum,
+                           offsets: MultiDrawList,
+                           offsetsOffset: number,
+                           drawcount: GLsizei) {
+      this.multiDrawElements(mode,
+                             multiDrawList(counts, countsOffset, drawcount),
+                             type,
+                             multiDrawList(offsets, offsetsOffset, drawcount),
+                             drawcount);
+    },
+    multiDrawArraysInstancedWEBGL(this: OpenGLESRenderingContext,
+                                  mode: GLenum,
+                                  firsts: MultiDrawList,
+                                  firstsOffset: number,
+                                  counts: MultiDrawList,
+                                  countsOffset: number,
+                                  instanceCounts: MultiDrawList,
+                                  instanceCountsOffset: number,
+                                  drawcount: GLsizei) {
+      this.multiDrawArraysInstanced(mode,
+                                    multiDrawList(firsts, firstsOffset, drawcount),
+                                    multiDrawList(counts, countsOffset, drawcount),
+                                    multiDrawList(instanceCounts, instanceCountsOffset, drawcount),
+                                    drawcount);
+    },
+    multiDrawElementsInstancedWEBGL(this: OpenGLESRenderingContext,
+                                    mode: GLenum,
+                                    counts: MultiDrawList,
+                                    countsOffset: number,
+                                    type: GLenum,
+                                    offsets: MultiDrawList,
+                                    offsetsOffset: number,
+                                    instanceCounts: MultiDrawList,
+                                    instanceCountsOffset: number,
+                                    drawcount: GLsizei) {
+      this.multiDrawElementsInstanced(
+        mode,
+        multiDrawList(counts, countsOffset, drawcount),
+        type,
+        multiDrawList(offsets, offsetsOffset, drawcount),
+        multiDrawList(instanceCounts, instanceCountsOffset, drawcount),
+        drawcount);
+    },
+  },
 };
@@ -0,0 +1,87 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {FrameCaptureStream, I420Frame, rgbaToI420} from '@nvidia/webgl';
+
+import {createTestContext, describeWithGL, TestContext} from './context';
+
+// `height` rows of `width` pixels each, the bottom half red and the top half white, bottom row
+// first like readPixels()
+function halves(width: number, height: number) {
+  const rgba = new Uint8Array(width * height * 4);
+  for (let i = 0; i < width * height; ++i) {
+    const red = i < width * height / 2;
+    rgba.set(red ? [255, 0, 0, 255] : [255, 255, 255, 255], i * 4);
+  }
+  return rgba;
+}
+
+describe('rgbaToI420', () => {
+  test('converts with BT.601 limited-range coefficients', () => {
+    const i420 = rgbaToI420(halves(2, 4), 2, 4);
+    // Y rows, then one U and one V value per 2x2 block
+    expect(Array.from(i420)).toEqual([82, 82, 82, 82, 235, 235, 235, 235, 90, 128, 240, 128]);
+  });
+
+  test('flips rows read bottom-up', () => {
+    const i420 = rgbaToI420(halves(2, 4), 2, 4, true);
+    expect(Array.from(i420)).toEqual([235, 235, 235, 235, 82, 82, 82, 82, 128, 90, 128, 240]);
+  });
+
+  test('rejects odd sizes and short inputs', () => {
+    expect(() => rgbaToI420(new Uint8Array(12), 3, 1)).toThrow(/1281/);
+    expect(() => rgbaToI420(new Uint8Array(12), 2, 2)).toThrow(/1281/);
+  });
+});
+
+describeWithGL('FrameCaptureStream', () => {
+  let context: TestContext;
+  let gl: WebGL2RenderingContext;
+
+  beforeAll(() => {
+    context = createTestContext(4, 4);
+    gl      = context.gl;
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  test('streams captured frames in order', async () => {
+    const stream = new FrameCaptureStream(gl, {width: 4, height: 4, highWaterMark: 4});
+    const frames: I420Frame[] = [];
+    stream.on('data', (frame: I420Frame) => frames.push(frame));
+    const ended = new Promise((resolve) => stream.on('end', resolve));
+
+    gl.clearColor(1, 0, 0, 1);
+    gl.clear(gl.COLOR_BUFFER_BIT);
+    expect(stream.capture(1)).toBe(true);
+    gl.clearColor(1, 1, 1, 1);
+    gl.clear(gl.COLOR_BUFFER_BIT);
+    expect(stream.capture(2)).toBe(true);
+    stream.finish();
+    await ended;
+
+    expect(frames.map(({timestamp}) => timestamp)).toEqual([1, 2]);
+    expect(frames[0].data.length).toBe(4 * 4 * 3 / 2);
+    expect(frames[0].data[0]).toBe(82);
+    expect(frames[1].data[0]).toBe(235);
+  });
+
+  test('drops frames instead of waiting when every slot is busy', () => {
+    const stream = new FrameCaptureStream(gl, {width: 4, height: 4, slots: 1, highWaterMark: 4});
+    expect(stream.capture()).toBe(true);
+    expect(stream.capture()).toBe(false);
+    expect(stream.dropped).toBe(1);
+    stream.destroy();
+  });
+});
@@ -0,0 +1,68 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as Fs from 'fs';
+import * as Path from 'path';
+
+// A GL context for the tests that render: a headless EGL context's, so they need neither a display
+// nor GLFW. Only available when the webgl addon is built. Runs on Mesa's llvmpipe without a GPU.
+
+const find = (module: string, name: string) =>
+  ['Release', 'Debug']
+    .map((type) => Path.join(__dirname, '..', '..', module, 'build', type, name))
+    .find((path) => Fs.existsSync(path));
+
+const webglPath = find('webgl', 'node_webgl.node');
+
+export const hasGLContext = Boolean(webglPath);
+
+export const describeWithGL = hasGLContext ? describe : describe.skip;
+
+export interface TestContext {
+  gl: WebGL2RenderingContext;
+  makeCurrent(): void;
+  destroy(): void;
+}
+
+export function createTestContext(width = 64, height = 64, attrs: any = {}): TestContext {
+  const {HeadlessContext, WebGL2RenderingContext} = require('@nvidia/webgl');
+  const context                                   = new HeadlessContext({width, height});
+  const gl                                        = new WebGL2RenderingContext(attrs);
+  return {gl, makeCurrent: () => context.makeCurrent(), destroy: () => context.destroy()};
+}
+
+// Compile and link a program, throwing with the info log if either fails
+export function createProgram(gl: WebGL2RenderingContext, vs: string, fs: string) {
+  const program = gl.createProgram()!;
+  for (const [type, source] of [[gl.VERTEX_SHADER, vs], [gl.FRAGMENT_SHADER, fs]] as const) {
+    const shader = gl.createShader(type)!;
+    gl.shaderSource(shader, source);
+    gl.compileShader(shader);
+    if (!gl.getShaderParameter(shader, gl.COMPILE_STATUS)) {
+      throw new Error(gl.getShaderInfoLog(shader) || 'shader compilation failed');
+    }
+    gl.attachShader(program, shader);
+  }
+  gl.linkProgram(program);
+  if (!gl.getProgramParameter(program, gl.LINK_STATUS)) {
+    throw new Error(gl.getProgramInfoLog(program) || 'program link failed');
+  }
+  return program;
+}
+
+export function readPixels(gl: WebGL2RenderingContext, width = 64, height = 64) {
+  const pixels = new Uint8Array(width * height * 4);
+  gl.readPixels(0, 0, width, height, gl.RGBA, gl.UNSIGNED_BYTE, pixels);
+  return pixels;
+}
@@ -0,0 +1,72 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createTestContext, describeWithGL} from './context';
+
+// An enum glEnable() doesn't take
+const BAD_CAPABILITY = 0xFFFF;
+
+describeWithGL('errorChecks', () => {
+  test('none leaves errors for getError()', () => {
+    const context = createTestContext(1, 1);
+    const {gl}    = context;
+    expect(() => gl.enable(BAD_CAPABILITY)).not.toThrow();
+    expect(gl.getError()).toBe(gl.INVALID_ENUM);
+    expect(gl.getDebugMessages()).toEqual({messages: [], dropped: 0});
+    context.destroy();
+  });
+
+  test('strict throws from the call that failed', () => {
+    const context = createTestContext(1, 1, {errorChecks: 'strict'});
+    const {gl}    = context;
+    expect(() => gl.enable(BAD_CAPABILITY)).toThrow(/1280/);
+    expect(() => gl.enable(gl.BLEND)).not.toThrow();
+    context.destroy();
+  });
+
+  test('debug logs driver messages until they are taken', () => {
+    const context = createTestContext(1, 1, {errorChecks: 'debug'});
+    const {gl}    = context;
+    gl.enable(BAD_CAPABILITY);
+    gl.finish();
+    const {messages, dropped} = gl.getDebugMessages();
+    expect(dropped).toBe(0);
+    expect(messages.length).toBeGreaterThan(0);
+    expect(messages[0].type).toBe(0x824C);  // DEBUG_TYPE_ERROR
+    expect(typeof messages[0].message).toBe('string');
+    expect(gl.getDebugMessages().messages).toEqual([]);
+    context.destroy();
+  });
+
+  test('debug leaves out the driver\'s notifications', () => {
+    const context = createTestContext(1, 1, {errorChecks: 'debug'});
+    const {gl}    = context;
+    const buffer  = gl.createBuffer();
+    gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+    gl.bufferData(gl.ARRAY_BUFFER, 1 << 20, gl.STATIC_DRAW);
+    gl.drawArrays(gl.POINTS, 0, 1);
+    gl.finish();
+    const {messages} = gl.getDebugMessages();
+    expect(messages.filter((m: any) => m.severity === 0x826B)).toEqual([]);  // NOTIFICATION
+    gl.deleteBuffer(buffer);
+    context.destroy();
+  });
+
+  test('rejects unknown modes', () => {
+    const context = createTestContext(1, 1);
+    const Context = context.gl.constructor as any;
+    expect(() => new Context({errorChecks: 'loud'})).toThrow(/1280/);
+    context.destroy();
+  });
+});
@@ -0,0 +1,119 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createTestContext, describeWithGL, TestContext} from './context';
+
+describeWithGL('handle pools', () => {
+  let context: TestContext;
+  let gl: any;
+
+  beforeAll(() => {
+    context = createTestContext(4, 4);
+    gl      = context.gl;
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  test('createBuffer() returns a new wrapper after a buffer is deleted', () => {
+    const buffer = gl.createBuffer();
+    const name   = buffer.ptr;
+    gl.deleteBuffer(buffer);
+
+    const next = gl.createBuffer();
+    expect(next).not.toBe(buffer);
+    expect(buffer.ptr).toBe(name);
+    expect(gl.isBuffer(buffer)).toBe(false);
+    expect(gl.isBuffer(next)).toBe(true);
+    gl.deleteBuffer(next);
+  });
+
+  test('fenceSync() returns a new wrapper after a sync is deleted', () => {
+    const sync = gl.fenceSync(gl.SYNC_GPU_COMMANDS_COMPLETE, 0);
+    gl.deleteSync(sync);
+    const next = gl.fenceSync(gl.SYNC_GPU_COMMANDS_COMPLETE, 0);
+    expect(next).not.toBe(sync);
+    gl.deleteSync(next);
+  });
+
+  test('createBuffer() reuses the wrappers of recycled buffers', () => {
+    const buffer = gl.createBuffer();
+    const name   = buffer.ptr;
+    gl.recycleBuffer(buffer);
+    expect(buffer.ptr).toBe(0);
+    expect(gl.isBuffer(name)).toBe(false);
+
+    const next = gl.createBuffer();
+    expect(next).toBe(buffer);
+    expect(next.ptr).not.toBe(0);
+    expect(gl.isBuffer(next)).toBe(true);
+    gl.deleteBuffer(next);
+  });
+
+  test('churning recycled buffers allocates no new wrappers', () => {
+    const wrappers = new Set();
+    for (let i = 0; i < 1000; ++i) {
+      const buffer = gl.createBuffer();
+      wrappers.add(buffer);
+      gl.recycleBuffer(buffer);
+    }
+    expect(wrappers.size).toBe(1);
+  });
+
+  test('createQuery() reuses recycled queries and their names', () => {
+    const query = gl.createQuery();
+    const name  = query.ptr;
+    gl.recycleQuery(query);
+    gl.recycleQuery(query);
+    const [a, b] = [gl.createQuery(), gl.createQuery()];
+    expect(a).toBe(query);
+    expect(a.ptr).toBe(name);
+    expect(b).not.toBe(query);
+    gl.deleteQueries([a, b]);
+  });
+
+  test('fenceSync() reuses the wrappers of recycled syncs', () => {
+    const sync = gl.fenceSync(gl.SYNC_GPU_COMMANDS_COMPLETE, 0);
+    gl.recycleSync(sync);
+    const next = gl.fenceSync(gl.SYNC_GPU_COMMANDS_COMPLETE, 0);
+    expect(next).toBe(sync);
+    expect(gl.clientWaitSync(next, gl.SYNC_FLUSH_COMMANDS_BIT, 1e9)).not.toBe(gl.WAIT_FAILED);
+    gl.deleteSync(next);
+  });
+
+  test('recycle*() only take their own wrappers', () => {
+    expect(() => gl.recycleBuffer(gl.createQuery())).toThrow(TypeError);
+    expect(() => gl.recycleQuery(1)).toThrow(TypeError);
+  });
+
+  test('createBuffers() and deleteBuffers() work by name', () => {
+    const names: Uint32Array = gl.createBuffers(3);
+    expect(names).toBeInstanceOf(Uint32Array);
+    expect(new Set(names).size).toBe(3);
+    names.forEach((name) => expect(gl.isBuffer(name)).toBe(true));
+
+    gl.bindBuffer(gl.ARRAY_BUFFER, names[0]);
+    gl.bufferData(gl.ARRAY_BUFFER, 16, gl.STATIC_DRAW);
+    expect(gl.getBufferParameter(gl.ARRAY_BUFFER, gl.BUFFER_SIZE)).toBe(16);
+    gl.bindBuffer(gl.ARRAY_BUFFER, null);
+
+    gl.deleteBuffers(names);
+    names.forEach((name) => expect(gl.isBuffer(name)).toBe(false));
+  });
+
+  test('createQueries() returns distinct names', () => {
+    const names: Uint32Array = gl.createQueries(100);
+    expect(new Set(names).size).toBe(100);
+    gl.deleteQueries(names);
+  });
+});
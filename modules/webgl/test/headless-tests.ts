@@ -0,0 +1,75 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {HeadlessContext, WebGL2RenderingContext} from '@nvidia/webgl';
+
+import {describeWithGL, readPixels} from './context';
+
+describeWithGL('HeadlessContext', () => {
+  test('is current once constructed, with a framebuffer of the size asked for', () => {
+    const context = new HeadlessContext({width: 32, height: 16});
+    try {
+      expect(context.isCurrent()).toBe(true);
+      expect([context.width, context.height]).toEqual([32, 16]);
+      const gl = new WebGL2RenderingContext();
+      expect(Array.from(gl.getParameter(gl.VIEWPORT))).toEqual([0, 0, 32, 16]);
+      gl.clearColor(0, 1, 0, 1);
+      gl.clear(gl.COLOR_BUFFER_BIT);
+      expect(Array.from(readPixels(gl, 1, 1))).toEqual([0, 255, 0, 255]);
+    } finally { context.destroy(); }
+  });
+
+  test('keeps contexts separate', () => {
+    const a = new HeadlessContext({width: 4, height: 4});
+    const b = new HeadlessContext({width: 4, height: 4});
+    try {
+      expect(a.isCurrent()).toBe(false);
+      const glB = new WebGL2RenderingContext();
+      glB.clearColor(0, 0, 1, 1);
+      glB.clear(glB.COLOR_BUFFER_BIT);
+
+      a.makeCurrent();
+      const glA = new WebGL2RenderingContext();
+      glA.clearColor(1, 0, 0, 1);
+      glA.clear(glA.COLOR_BUFFER_BIT);
+      expect(Array.from(readPixels(glA, 1, 1))).toEqual([255, 0, 0, 255]);
+
+      b.makeCurrent();
+      expect(Array.from(readPixels(glB, 1, 1))).toEqual([0, 0, 255, 255]);
+    } finally {
+      a.destroy();
+      b.destroy();
+    }
+  });
+
+  test('can be created on a software device', () => {
+    const context = new HeadlessContext({software: true});
+    try {
+      expect(context.software || context.device === -1).toBe(true);
+      const gl = new WebGL2RenderingContext();
+      expect(gl.getParameter(gl.RENDERER)).toMatch(/llvmpipe|softpipe|swrast/i);
+    } finally { context.destroy(); }
+  });
+
+  test('throws for devices that don\'t exist', () => {
+    expect(() => new HeadlessContext({device: 1000})).toThrow(/EGL error/);
+  });
+
+  test('can\'t be made current once destroyed', () => {
+    const context = new HeadlessContext();
+    context.destroy();
+    expect(context.isCurrent()).toBe(false);
+    expect(() => context.makeCurrent()).toThrow(/EGL error/);
+  });
+});
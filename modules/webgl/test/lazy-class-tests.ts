@@ -0,0 +1,41 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as Fs from 'fs';
+import * as Path from 'path';
+
+// The addon's classes are defined on first access. Only exercises construction, so needs no GPU.
+
+const addonPath = ['Release', 'Debug']
+                    .map((type) => Path.join(__dirname, '..', 'build', type, 'node_webgl.node'))
+                    .find((path) => Fs.existsSync(path));
+
+const testIfBuilt = addonPath ? test : test.skip;
+
+testIfBuilt('defines classes on first access', () => {
+  const gl = require(addonPath!);
+  expect(Object.keys(gl)).toContain('WebGLQuery');
+
+  const before = Object.getOwnPropertyDescriptor(gl, 'WebGLQuery')!;
+  const ctor   = gl.WebGLQuery;
+  const after  = Object.getOwnPropertyDescriptor(gl, 'WebGLQuery')!;
+
+  expect(typeof before.get).toBe('function');
+  expect(typeof ctor).toBe('function');
+  expect(gl.WebGLQuery).toBe(ctor);
+  expect(new gl.WebGLQuery()).toBeInstanceOf(ctor);
+  // Once defined, the getter is replaced with a plain data property
+  expect(after.value).toBe(ctor);
+  expect(after.get).toBeUndefined();
+});
@@ -0,0 +1,107 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createProgram, createTestContext, describeWithGL, readPixels, TestContext} from './context';
+
+const vs = `#version 330 core
+in vec2 position;
+void main() { gl_Position = vec4(position, 0.0, 1.0); }`;
+
+const fs = `#version 330 core
+out vec4 fragColor;
+void main() { fragColor = vec4(1.0); }`;
+
+// Two quads as triangle strips, over the left and right halves of the canvas
+const quads = [
+  [-1, -1, 0, -1, -1, 1, 0, 1],
+  [0, -1, 1, -1, 0, 1, 1, 1],
+];
+
+describeWithGL('multi-draw', () => {
+  let context: TestContext;
+  let gl: any;
+
+  beforeAll(() => {
+    context       = createTestContext(4, 4);
+    gl            = context.gl;
+    const program = createProgram(gl, vs, fs);
+    gl.useProgram(program);
+    gl.bindVertexArray(gl.createVertexArray());
+    gl.bindBuffer(gl.ARRAY_BUFFER, gl.createBuffer());
+    gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([...quads[0], ...quads[1]]), gl.STATIC_DRAW);
+    gl.enableVertexAttribArray(gl.getAttribLocation(program, 'position'));
+    gl.vertexAttribPointer(gl.getAttribLocation(program, 'position'), 2, gl.FLOAT, false, 0, 0);
+    gl.bindBuffer(gl.ELEMENT_ARRAY_BUFFER, gl.createBuffer());
+    const elements = new Uint16Array([0, 1, 2, 3, 4, 5, 6, 7]);
+    gl.bufferData(gl.ELEMENT_ARRAY_BUFFER, elements, gl.STATIC_DRAW);
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  beforeEach(() => {
+    gl.clearColor(0, 0, 0, 1);
+    gl.clear(gl.COLOR_BUFFER_BIT);
+  });
+
+  // Whether the bottom-left and bottom-right pixels were drawn
+  const drawn = () => {
+    const pixels = readPixels(gl, 4, 1);
+    return [pixels[0] === 255, pixels[12] === 255];
+  };
+
+  test('multiDrawArrays draws each range', () => {
+    gl.multiDrawArrays(gl.TRIANGLE_STRIP, new Int32Array([0, 4]), new Int32Array([4, 4]));
+    expect(drawn()).toEqual([true, true]);
+  });
+
+  test('multiDrawElements draws drawcount ranges', () => {
+    gl.multiDrawElements(
+      gl.TRIANGLE_STRIP, new Int32Array([4, 4]), gl.UNSIGNED_SHORT, new Int32Array([8, 0]), 1);
+    expect(drawn()).toEqual([false, true]);
+  });
+
+  test('WEBGL_multi_draw takes lists with offsets', () => {
+    const ext = gl.getExtension('WEBGL_multi_draw');
+    ext.multiDrawArraysInstancedWEBGL(gl.TRIANGLE_STRIP, [9, 0], 1, [9, 4], 1, [1], 0, 1);
+    expect(drawn()).toEqual([true, false]);
+  });
+
+  test('draws from the bound DRAW_INDIRECT_BUFFER', () => {
+    // {count, instanceCount, first, baseInstance}, and {count, instanceCount, firstIndex,
+    // baseVertex, baseInstance}
+    const indirect = gl.createBuffer();
+    gl.bindBuffer(gl.DRAW_INDIRECT_BUFFER, indirect);
+    gl.bufferData(
+      gl.DRAW_INDIRECT_BUFFER, new Uint32Array([4, 1, 4, 0, 4, 1, 0, 0, 0]), gl.STATIC_DRAW);
+    gl.drawArraysIndirect(gl.TRIANGLE_STRIP, 0);
+    expect(drawn()).toEqual([false, true]);
+
+    gl.clear(gl.COLOR_BUFFER_BIT);
+    gl.drawElementsIndirect(gl.TRIANGLE_STRIP, gl.UNSIGNED_SHORT, 16);
+    expect(drawn()).toEqual([true, false]);
+
+    gl.clear(gl.COLOR_BUFFER_BIT);
+    gl.bufferData(
+      gl.DRAW_INDIRECT_BUFFER, new Uint32Array([4, 1, 0, 0, 4, 1, 4, 0]), gl.STATIC_DRAW);
+    gl.multiDrawArraysIndirect(gl.TRIANGLE_STRIP, 0, 2, 0);
+    expect(drawn()).toEqual([true, true]);
+    gl.bindBuffer(gl.DRAW_INDIRECT_BUFFER, null);
+    gl.deleteBuffer(indirect);
+  });
+
+  test('rejects a drawcount past the end of the lists', () => {
+    expect(() => gl.multiDrawArrays(gl.TRIANGLE_STRIP, new Int32Array([0]), new Int32Array([4]), 2))
+      .toThrow(/1281/);
+  });
+});
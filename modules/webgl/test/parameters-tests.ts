@@ -0,0 +1,68 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createTestContext, describeWithGL, TestContext} from './context';
+
+describeWithGL('immutable parameters', () => {
+  let context: TestContext;
+  let gl: WebGL2RenderingContext;
+
+  beforeAll(() => {
+    context = createTestContext(64, 64, {antialias: false});
+    gl      = context.gl;
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  test('limits and strings are read once', () => {
+    for (const pname of [gl.MAX_TEXTURE_SIZE, gl.MAX_VERTEX_ATTRIBS, gl.VENDOR, gl.RENDERER]) {
+      const first = gl.getParameter(pname);
+      expect(first).not.toBeNull();
+      expect(gl.getParameter(pname)).toBe(first);
+    }
+    expect(gl.getParameter(gl.MAX_TEXTURE_SIZE)).toBeGreaterThanOrEqual(2048);
+  });
+
+  test('cached typed arrays are copies', () => {
+    const dims = gl.getParameter(gl.MAX_VIEWPORT_DIMS);
+    expect(dims).toBeInstanceOf(Int32Array);
+    const [width] = dims;
+    dims[0]       = -1;
+    expect(gl.getParameter(gl.MAX_VIEWPORT_DIMS)[0]).toBe(width);
+    expect(gl.getParameter(gl.ALIASED_LINE_WIDTH_RANGE)).toBeInstanceOf(Float32Array);
+  });
+
+  test('getSupportedExtensions builds its array once', () => {
+    const extensions = gl.getSupportedExtensions()!;
+    expect(extensions.length).toBeGreaterThan(0);
+    expect(extensions.every((name) => typeof name === 'string')).toBe(true);
+    expect(gl.getSupportedExtensions()).toBe(extensions);
+    expect(Object.isFrozen(extensions)).toBe(true);
+  });
+
+  test('getContextAttributes fills in the defaults', () => {
+    const attrs = gl.getContextAttributes()!;
+    expect(attrs.antialias).toBe(false);
+    expect(attrs.alpha).toBe(true);
+    expect(attrs.preserveDrawingBuffer).toBe(false);
+    expect(gl.getContextAttributes()).toEqual(attrs);
+  });
+
+  test('getContextAttributes returns a copy callers can change', () => {
+    const attrs     = gl.getContextAttributes()!;
+    attrs.antialias = true;
+    expect(gl.getContextAttributes()!.antialias).toBe(false);
+    expect(gl.getContextAttributes()).not.toBe(gl.getContextAttributes());
+  });
+});
@@ -0,0 +1,76 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {FrameProfiler} from '@nvidia/webgl';
+
+import {createTestContext, describeWithGL, TestContext} from './context';
+
+describeWithGL('FrameProfiler', () => {
+  let context: TestContext;
+  let gl: WebGL2RenderingContext;
+
+  beforeAll(() => {
+    context = createTestContext();
+    gl      = context.gl;
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  const frame = (profiler: FrameProfiler) => {
+    profiler.beginFrame();
+    profiler.begin('clear');
+    gl.clear(gl.COLOR_BUFFER_BIT);
+    profiler.begin('nested');
+    gl.clear(gl.COLOR_BUFFER_BIT);
+    profiler.end();
+    profiler.end();
+    profiler.begin('clear');
+    gl.clear(gl.COLOR_BUFFER_BIT);
+    profiler.end();
+    profiler.endFrame();
+  };
+
+  test('reports each section over the window', () => {
+    const profiler = new FrameProfiler(gl, 4);
+    for (let i = 0; i < 6; ++i) { frame(profiler); }
+    profiler.collect(true);
+    expect(profiler.pending).toBe(0);
+
+    const stats = profiler.stats();
+    expect(Object.keys(stats).sort()).toEqual(['clear', 'frame', 'nested']);
+    for (const section of Object.values(stats)) {
+      expect(section.count).toBe(4);
+      expect(section.min).toBeGreaterThanOrEqual(0);
+      expect(section.min).toBeLessThanOrEqual(section.p50);
+      expect(section.p50).toBeLessThanOrEqual(section.p99);
+      expect(section.p99).toBeLessThanOrEqual(section.max);
+    }
+    expect(stats.frame.max).toBeGreaterThanOrEqual(stats.clear.min);
+    profiler.reset();
+    expect(profiler.stats()).toEqual({});
+    profiler.destroy();
+  });
+
+  test('rejects sections outside a frame, and frames with sections open', () => {
+    const profiler = new FrameProfiler(gl);
+    expect(() => profiler.begin('layer')).toThrow(/1282/);
+    expect(() => profiler.end()).toThrow(/1282/);
+    profiler.beginFrame();
+    profiler.begin('layer');
+    expect(() => profiler.endFrame()).toThrow(/1282/);
+    profiler.end();
+    profiler.endFrame();
+    profiler.destroy();
+  });
+});
@@ -0,0 +1,123 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as Fs from 'fs';
+import * as Os from 'os';
+import * as Path from 'path';
+
+import {createProgram, createTestContext, describeWithGL, readPixels} from './context';
+
+const vs = `#version 330 core
+in vec2 position;
+void main() { gl_Position = vec4(position, 0.0, 1.0); }`;
+
+const fs = (color: string) => `#version 330 core
+out vec4 fragColor;
+void main() { fragColor = vec4(${color}); }`;
+
+describeWithGL('program cache', () => {
+  let directory: string;
+
+  beforeEach(() => { directory = Fs.mkdtempSync(Path.join(Os.tmpdir(), 'program-cache-')); });
+  afterEach(() => { Fs.rmSync(directory, {recursive: true, force: true}); });
+
+  const binaries = () => Fs.readdirSync(directory).filter((name) => name.endsWith('.bin'));
+
+  // Link a program in a new context, and draw a quad with it
+  function link(color: string, attrs: any = {programCache: {directory}}) {
+    const context = createTestContext(8, 8, attrs);
+    const {gl}    = context;
+    try {
+      const program = createProgram(gl, vs, fs(color));
+      const buffer  = gl.createBuffer();
+      gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+      gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 3, -1, -1, 3]), gl.STATIC_DRAW);
+      const vao = gl.createVertexArray();
+      gl.bindVertexArray(vao);
+      gl.enableVertexAttribArray(gl.getAttribLocation(program, 'position'));
+      gl.vertexAttribPointer(gl.getAttribLocation(program, 'position'), 2, gl.FLOAT, false, 0, 0);
+      gl.useProgram(program);
+      gl.drawArrays(gl.TRIANGLES, 0, 3);
+      return {stats: (gl as any).getProgramCacheStats(), pixel: Array.from(readPixels(gl, 1, 1))};
+    } finally { context.destroy(); }
+  }
+
+  test('is off without a directory', () => {
+    const {stats} = link('1.0', {});
+    expect(stats).toBeNull();
+  });
+
+  test('links from the cached binary the second time', () => {
+    expect(link('1.0, 0.0, 0.0, 1.0')).toEqual({
+      stats: {hits: 0, misses: 1, directory},
+      pixel: [255, 0, 0, 255],
+    });
+    expect(binaries()).toHaveLength(1);
+    expect(link('1.0, 0.0, 0.0, 1.0')).toEqual({
+      stats: {hits: 1, misses: 0, directory},
+      pixel: [255, 0, 0, 255],
+    });
+  });
+
+  test('misses when a shader changes', () => {
+    link('1.0, 0.0, 0.0, 1.0');
+    expect(link('0.0, 1.0, 0.0, 1.0')).toEqual({
+      stats: {hits: 0, misses: 1, directory},
+      pixel: [0, 255, 0, 255],
+    });
+    expect(binaries()).toHaveLength(2);
+  });
+
+  test('compiles and links instead of loading a damaged binary', () => {
+    link('0.0, 0.0, 1.0, 1.0');
+    const [name] = binaries();
+    Fs.writeFileSync(Path.join(directory, name), 'NVPB garbage');
+    expect(link('0.0, 0.0, 1.0, 1.0')).toEqual({
+      stats: {hits: 0, misses: 1, directory},
+      pixel: [0, 0, 255, 255],
+    });
+  });
+
+  test('evicts the least recently used binaries past maxBytes', () => {
+    link('1.0, 0.0, 0.0, 1.0');
+    const [first] = binaries();
+    const size    = Fs.statSync(Path.join(directory, first)).size;
+    // Room for one binary (give or take), so storing another evicts the first
+    link('0.0, 1.0, 0.0, 1.0', {programCache: {directory, maxBytes: size + size / 2}});
+    expect(binaries()).toHaveLength(1);
+    expect(binaries()).not.toContain(first);
+  });
+
+  test('only remembers compiled shaders with deferCompile', () => {
+    const markers = () => Fs.readdirSync(directory).filter((name) => name.endsWith('.shader'));
+    link('1.0, 0.0, 0.0, 1.0');
+    expect(markers()).toHaveLength(0);
+    link('0.0, 1.0, 0.0, 1.0', {programCache: {directory, deferCompile: true}});
+    expect(markers()).toHaveLength(2);
+  });
+
+  test('evicts compiled-shader markers with the binaries', () => {
+    link('1.0, 0.0, 0.0, 1.0', {programCache: {directory, deferCompile: true}});
+    expect(Fs.readdirSync(directory)).toHaveLength(3);
+    link('0.0, 1.0, 0.0, 1.0', {programCache: {directory, deferCompile: true, maxBytes: 1}});
+    expect(Fs.readdirSync(directory)).toHaveLength(0);
+  });
+
+  test('reports compile errors of shaders it has never seen', () => {
+    const context = createTestContext(8, 8, {programCache: {directory}});
+    try {
+      expect(() => createProgram(context.gl, vs, fs('nope'))).toThrow();
+    } finally { context.destroy(); }
+  });
+});
@@ -0,0 +1,131 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createTestContext, describeWithGL, readPixels, TestContext} from './context';
+
+describeWithGL('readPixelsAsync', () => {
+  let context: TestContext;
+  let gl: any;
+
+  beforeAll(() => {
+    context = createTestContext();
+    gl      = context.gl;
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  const clear = (r: number, g: number, b: number, a: number) => {
+    gl.clearColor(r, g, b, a);
+    gl.clear(gl.COLOR_BUFFER_BIT);
+  };
+
+  test('resolves with the same pixels as readPixels', async () => {
+    clear(1, 0.5, 0, 1);
+    const pixels = await gl.readPixelsAsync(0, 0, 64, 64, gl.RGBA, gl.UNSIGNED_BYTE);
+    expect(pixels).toBeInstanceOf(Uint8Array);
+    expect(pixels).toEqual(readPixels(gl));
+    expect(Array.from(pixels.subarray(0, 4))).toEqual([255, 128, 0, 255]);
+  });
+
+  test('reads in flight see the framebuffer as it was when they started', async () => {
+    clear(1, 0, 0, 1);
+    const red = gl.readPixelsAsync(0, 0, 8, 8, gl.RGBA, gl.UNSIGNED_BYTE);
+    clear(0, 0, 1, 1);
+    const blue = gl.readPixelsAsync(0, 0, 8, 8, gl.RGBA, gl.UNSIGNED_BYTE);
+    const [r, b] = await Promise.all([red, blue]);
+    expect(Array.from(r.subarray(0, 4))).toEqual([255, 0, 0, 255]);
+    expect(Array.from(b.subarray(0, 4))).toEqual([0, 0, 255, 255]);
+  });
+
+  test('returns arrays of the pixel type, with rows padded to the pack alignment', async () => {
+    clear(0.25, 0.5, 0.75, 1);
+    const floats = await gl.readPixelsAsync(0, 0, 2, 2, gl.RGBA, gl.FLOAT);
+    expect(floats).toBeInstanceOf(Float32Array);
+    expect(floats.length).toBe(16);
+    expect(floats[2]).toBeCloseTo(0.75);
+    const rgb = await gl.readPixelsAsync(0, 0, 3, 2, gl.RGB, gl.UNSIGNED_BYTE);
+    expect(rgb.length).toBe(12 + 9);
+  });
+
+  test('sizes the read for the pack row length and skips', async () => {
+    gl.pixelStorei(gl.PACK_ROW_LENGTH, 8);
+    gl.pixelStorei(gl.PACK_SKIP_PIXELS, 1);
+    gl.pixelStorei(gl.PACK_SKIP_ROWS, 2);
+    try {
+      const pixels = await gl.readPixelsAsync(0, 0, 4, 3, gl.RGBA, gl.UNSIGNED_BYTE);
+      expect(pixels.length).toBe(32 * (2 + 3 - 1) + (1 + 4) * 4);
+    } finally {
+      gl.pixelStorei(gl.PACK_ROW_LENGTH, 0);
+      gl.pixelStorei(gl.PACK_SKIP_PIXELS, 0);
+      gl.pixelStorei(gl.PACK_SKIP_ROWS, 0);
+    }
+  });
+
+  test('rejects a negative width or height with INVALID_VALUE', async () => {
+    await expect(gl.readPixelsAsync(0, 0, -1, 4, gl.RGBA, gl.UNSIGNED_BYTE))
+      .rejects.toThrow(/1281/);
+    await expect(gl.readPixelsAsync(0, 0, 4, -1, gl.RGBA, gl.UNSIGNED_BYTE))
+      .rejects.toThrow(/1281/);
+  });
+
+  test('rejects reads past the 16 it keeps in flight', async () => {
+    const slots = Array.from({length: 16},
+                             () => gl._readPixelsToBuffer(0, 0, 1, 1, gl.RGBA, gl.UNSIGNED_BYTE));
+    try {
+      await expect(gl.readPixelsAsync(0, 0, 1, 1, gl.RGBA, gl.UNSIGNED_BYTE))
+        .rejects.toThrow('in flight');
+    } finally { slots.forEach((slot) => gl._releasePixels(slot)); }
+    await expect(gl.readPixelsAsync(0, 0, 1, 1, gl.RGBA, gl.UNSIGNED_BYTE)).resolves.toBeDefined();
+  });
+
+  test('leaves the pixel pack buffer binding alone', async () => {
+    const buffer = gl.createBuffer();
+    gl.bindBuffer(gl.PIXEL_PACK_BUFFER, buffer);
+    const pixels = gl.readPixelsAsync(0, 0, 4, 4, gl.RGBA, gl.UNSIGNED_BYTE);
+    gl.invalidateStateCache();
+    expect(gl.getParameter(gl.PIXEL_PACK_BUFFER_BINDING)).toBe(buffer.ptr);
+    await pixels;
+    gl.bindBuffer(gl.PIXEL_PACK_BUFFER, null);
+    gl.deleteBuffer(buffer);
+  });
+
+  test('returns the slot to the ring when polling fails', async () => {
+    const poll = gl._pollPixels;
+    gl._pollPixels = () => { throw new Error('poll failed'); };
+    try {
+      await expect(gl.readPixelsAsync(0, 0, 4, 4, gl.RGBA, gl.UNSIGNED_BYTE))
+        .rejects.toThrow('poll failed');
+    } finally { delete gl._pollPixels; }
+    expect(gl._pollPixels).toBe(poll);
+    const slot = gl._readPixelsToBuffer(0, 0, 4, 4, gl.RGBA, gl.UNSIGNED_BYTE);
+    expect(slot).toBe(0);
+    gl._releasePixels(slot);
+  });
+
+  test('finishes reads against its own context while another one is current', async () => {
+    clear(0, 1, 0, 1);
+    const pixels = gl.readPixelsAsync(0, 0, 4, 4, gl.RGBA, gl.UNSIGNED_BYTE);
+    const other  = createTestContext(4, 4);
+    try {
+      expect(Array.from((await pixels).subarray(0, 4))).toEqual([0, 255, 0, 255]);
+      // and leaves the other context current
+      other.gl.clearColor(1, 0, 0, 1);
+      other.gl.clear(other.gl.COLOR_BUFFER_BIT);
+      expect(Array.from(readPixels(other.gl, 1, 1))).toEqual([255, 0, 0, 255]);
+    } finally {
+      other.destroy();
+      context.makeCurrent();
+    }
+  });
+});
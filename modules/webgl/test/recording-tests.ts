@@ -0,0 +1,143 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createProgram, createTestContext, describeWithGL, readPixels, TestContext} from './context';
+
+const vs = `#version 330 core
+in vec2 position;
+uniform mat4 transform;
+void main() { gl_Position = transform * vec4(position, 0.0, 1.0); }`;
+
+const fs = `#version 330 core
+uniform vec4 color;
+uniform float scale[2];
+out vec4 fragColor;
+void main() { fragColor = vec4(color.rgb * scale[0] * scale[1], color.a); }`;
+
+// Draws two overlapping, blended triangles, going through recorded and immediate calls alike
+function draw(gl: WebGL2RenderingContext, program: WebGLProgram, buffer: WebGLBuffer) {
+  const vao = gl.createVertexArray();
+  gl.bindVertexArray(vao);
+  gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+  const position = gl.getAttribLocation(program, 'position');
+  gl.enableVertexAttribArray(position);
+  gl.vertexAttribPointer(position, 2, gl.FLOAT, false, 0, 0);
+
+  gl.viewport(0, 0, 64, 64);
+  gl.clearColor(0.1, 0.2, 0.3, 1);
+  gl.clear(gl.COLOR_BUFFER_BIT);
+  gl.enable(gl.BLEND);
+  gl.blendFunc(gl.SRC_ALPHA, gl.ONE_MINUS_SRC_ALPHA);
+  gl.useProgram(program);
+  gl.uniform1fv(gl.getUniformLocation(program, 'scale'), [0.5, 2]);
+
+  const transform = gl.getUniformLocation(program, 'transform');
+  const color     = gl.getUniformLocation(program, 'color');
+  gl.uniformMatrix4fv(transform, false, [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1]);
+  gl.uniform4f(color, 1, 0, 0, 0.75);
+  gl.drawArrays(gl.TRIANGLES, 0, 3);
+  gl.uniformMatrix4fv(transform, false, [-1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1]);
+  gl.uniform4f(color, 0, 1, 0, 0.5);
+  gl.drawArrays(gl.TRIANGLES, 0, 3);
+
+  gl.disable(gl.BLEND);
+  gl.bindVertexArray(null);
+  gl.deleteVertexArray(vao);
+}
+
+describeWithGL('createRecordingContext', () => {
+  let context: TestContext;
+  let program: WebGLProgram;
+  let buffer: WebGLBuffer;
+
+  beforeAll(() => {
+    context    = createTestContext();
+    const {gl} = context;
+    program    = createProgram(gl, vs, fs);
+    buffer     = gl.createBuffer()!;
+    gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+    gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 0.5, -1, -1, 0.5]), gl.STATIC_DRAW);
+  });
+
+  afterAll(() => context && context.destroy());
+
+  test('renders the same pixels as the immediate-mode context', () => {
+    const {createRecordingContext} = require('@nvidia/webgl');
+    const {gl}                     = context;
+
+    draw(gl, program, buffer);
+    const expected = readPixels(gl);
+
+    gl.clearColor(0, 0, 0, 0);
+    gl.clear(gl.COLOR_BUFFER_BIT);
+
+    const recorder = createRecordingContext(gl);
+    draw(recorder, program, buffer);
+    recorder.submit();
+    const actual = readPixels(gl);
+
+    expect(actual).toEqual(expected);
+    // Make sure the scene isn't trivially empty
+    expect(new Set(expected).size).toBeGreaterThan(2);
+  });
+
+  test('submits recorded calls before calls that aren\'t recorded', () => {
+    const {createRecordingContext} = require('@nvidia/webgl');
+    const recorder                 = createRecordingContext(context.gl);
+    recorder.enable(recorder.SCISSOR_TEST);
+    recorder.scissor(1, 2, 3, 4);
+    expect(recorder.isEnabled(recorder.SCISSOR_TEST)).toBe(true);
+    expect([...recorder.getParameter(recorder.SCISSOR_BOX)]).toEqual([1, 2, 3, 4]);
+    recorder.disable(recorder.SCISSOR_TEST);
+    recorder.submit();
+    expect(context.gl.isEnabled(context.gl.SCISSOR_TEST)).toBe(false);
+  });
+
+  test('reports a bad recorded call when it is submitted', () => {
+    const {createRecordingContext} = require('@nvidia/webgl');
+    const recorder                 = createRecordingContext(context.gl);
+    recorder.viewport(0, 0, 64, 64);
+    recorder.uniform4fv(null, [1, 2, 3]);
+    expect(() => recorder.submit()).toThrow(/1281/);  // GL_INVALID_VALUE
+  });
+
+  test('checks the recorded calls of a strict context when they are submitted', () => {
+    const {createRecordingContext} = require('@nvidia/webgl');
+    const strict                   = createTestContext(1, 1, {errorChecks: 'strict'});
+    try {
+      const recorder = createRecordingContext(strict.gl);
+      recorder.enable(0xFFFF);
+      expect(() => recorder.submit()).toThrow(/1280/);  // GL_INVALID_ENUM
+      recorder.enable(recorder.BLEND);
+      expect(() => recorder.submit()).not.toThrow();
+    } finally {
+      strict.destroy();
+      context.makeCurrent();
+    }
+  });
+
+  test('binds the new buffer of a recycled wrapper', () => {
+    const {createRecordingContext} = require('@nvidia/webgl');
+    const recorder                 = createRecordingContext(context.gl);
+    const recycled                 = recorder.createBuffer();
+    recorder.bindBuffer(recorder.ARRAY_BUFFER, recycled);
+    recorder.recycleBuffer(recycled);
+    const reused = recorder.createBuffer();
+    expect(reused).toBe(recycled);
+    recorder.bindBuffer(recorder.ARRAY_BUFFER, reused);
+    recorder.submit();
+    expect(context.gl.getParameter(context.gl.ARRAY_BUFFER_BINDING)).toBe(reused.ptr);
+    recorder.deleteBuffer(reused);
+  });
+});
@@ -0,0 +1,168 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createRecordingContext} from '@nvidia/webgl';
+
+import {createProgram, createTestContext, describeWithGL, TestContext} from './context';
+
+const vs = `#version 330 core
+void main() { gl_Position = vec4(0.0); }`;
+
+const fs = `#version 330 core
+out vec4 fragColor;
+void main() { fragColor = vec4(1.0); }`;
+
+// The state the cache answers for, as getParameter() reports it
+function snapshot(gl: WebGL2RenderingContext) {
+  return {
+    program: gl.getParameter(gl.CURRENT_PROGRAM),
+    arrayBuffer: gl.getParameter(gl.ARRAY_BUFFER_BINDING),
+    elementArrayBuffer: gl.getParameter(gl.ELEMENT_ARRAY_BUFFER_BINDING),
+    vertexArray: gl.getParameter(gl.VERTEX_ARRAY_BINDING),
+    viewport: Array.from(gl.getParameter(gl.VIEWPORT)),
+    blend: gl.getParameter(gl.BLEND),
+    blendSrcRGB: gl.getParameter(gl.BLEND_SRC_RGB),
+    blendDstAlpha: gl.getParameter(gl.BLEND_DST_ALPHA),
+    depthTest: gl.isEnabled(gl.DEPTH_TEST),
+  };
+}
+
+function setState(gl: WebGL2RenderingContext, program: WebGLProgram, buffer: WebGLBuffer) {
+  gl.useProgram(program);
+  gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+  gl.enable(gl.BLEND);
+  gl.disable(gl.DEPTH_TEST);
+  gl.blendFuncSeparate(gl.SRC_ALPHA, gl.ONE_MINUS_SRC_ALPHA, gl.ONE, gl.ZERO);
+  gl.viewport(1, 2, 30, 40);
+}
+
+describeWithGL('state cache', () => {
+  let context: TestContext;
+  let gl: any;
+  let program: WebGLProgram;
+  let buffer: WebGLBuffer;
+
+  beforeAll(() => {
+    context = createTestContext();
+    gl      = context.gl;
+    program = createProgram(gl, vs, fs);
+    buffer  = gl.createBuffer();
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  beforeEach(() => { gl.invalidateStateCache(); });
+
+  test('skips calls that would not change the state', () => {
+    setState(gl, program, buffer);
+    const before = gl.getStateCacheStats();
+    setState(gl, program, buffer);
+    const after = gl.getStateCacheStats();
+    expect(after.elided - before.elided).toBe(6);
+    expect(after.issued).toBe(before.issued);
+    gl.bindBuffer(gl.ARRAY_BUFFER, null);
+    expect(gl.getStateCacheStats().issued).toBe(after.issued + 1);
+  });
+
+  test('getParameter answers match the driver', () => {
+    setState(gl, program, buffer);
+    const cached = snapshot(gl);
+    gl.invalidateStateCache();
+    expect(snapshot(gl)).toEqual(cached);
+    expect(cached.viewport).toEqual([1, 2, 30, 40]);
+    expect(cached.blend).toBe(true);
+    expect(cached.depthTest).toBe(false);
+  });
+
+  test('binding a vertex array forgets the element array buffer binding', () => {
+    const elements = gl.createBuffer();
+    const vao      = gl.createVertexArray();
+    gl.bindVertexArray(vao);
+    gl.bindBuffer(gl.ELEMENT_ARRAY_BUFFER, elements);
+    gl.bindVertexArray(null);
+    expect(gl.getParameter(gl.ELEMENT_ARRAY_BUFFER_BINDING)).toBe(0);
+    gl.bindVertexArray(vao);
+    expect(gl.getParameter(gl.ELEMENT_ARRAY_BUFFER_BINDING)).toBe(elements.ptr);
+    gl.deleteVertexArray(vao);
+    expect(gl.getParameter(gl.VERTEX_ARRAY_BINDING)).toBe(0);
+    gl.deleteBuffer(elements);
+  });
+
+  test('deleting a bound buffer unbinds it', () => {
+    const scratch = gl.createBuffer();
+    gl.bindBuffer(gl.ARRAY_BUFFER, scratch);
+    gl.deleteBuffer(scratch);
+    expect(gl.getParameter(gl.ARRAY_BUFFER_BINDING)).toBe(0);
+    gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+    expect(gl.getParameter(gl.ARRAY_BUFFER_BINDING)).toBe(buffer.ptr);
+  });
+
+  test('recorded calls go through the cache', () => {
+    setState(gl, program, buffer);
+    const before   = gl.getStateCacheStats();
+    const recorder = createRecordingContext(gl);
+    setState(recorder, program, buffer);
+    recorder.submit();
+    expect(gl.getStateCacheStats().elided - before.elided).toBe(6);
+  });
+
+  test('capabilities read as booleans before and after the cache knows them', () => {
+    for (const cap of [gl.RASTERIZER_DISCARD, gl.SAMPLE_ALPHA_TO_COVERAGE, gl.SAMPLE_COVERAGE]) {
+      gl.invalidateStateCache();
+      expect(gl.getParameter(cap)).toBe(false);
+      gl.disable(cap);
+      expect(gl.getParameter(cap)).toBe(false);
+    }
+  });
+
+  test('failed calls are forgotten once getError() reports them', () => {
+    gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+    gl.useProgram(program);
+    gl.useProgram(0xffff);
+    expect(gl.getError()).toBe(gl.INVALID_VALUE);
+    expect(gl.getParameter(gl.CURRENT_PROGRAM)).toBe(program.ptr);
+    const before = gl.getStateCacheStats();
+    gl.useProgram(program);
+    expect(gl.getStateCacheStats().issued).toBe(before.issued + 1);
+  });
+
+  test('wrappers of the same GL context share a cache', () => {
+    const {WebGL2RenderingContext} = require('@nvidia/webgl');
+    const other                    = new WebGL2RenderingContext();
+    gl.useProgram(program);
+    other.useProgram(null);
+    expect(gl.getParameter(gl.CURRENT_PROGRAM)).toBe(0);
+    expect(other.getStateCacheStats()).toEqual(gl.getStateCacheStats());
+  });
+
+  test('with error checks, failed calls are not recorded, and keep their error', () => {
+    const {WebGL2RenderingContext} = require('@nvidia/webgl');
+    const checked                  = new WebGL2RenderingContext({errorChecks: 'debug'});
+    checked.useProgram(program);
+    checked.useProgram(0xffff);
+    expect(checked.getParameter(checked.CURRENT_PROGRAM)).toBe(program.ptr);
+    expect(checked.getError()).toBe(checked.INVALID_VALUE);
+  });
+
+  // Last, since it makes another GL context current
+  test('can be turned off', () => {
+    const other = createTestContext(64, 64, {stateCache: false});
+    try {
+      const ogl: any = other.gl;
+      ogl.enable(ogl.BLEND);
+      ogl.enable(ogl.BLEND);
+      expect(ogl.getStateCacheStats()).toEqual({issued: 2, elided: 0});
+    } finally { other.destroy(); }
+  });
+});
@@ -0,0 +1,96 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {StreamingBuffer} from '@nvidia/webgl';
+
+import {createTestContext, describeWithGL, TestContext} from './context';
+
+describeWithGL('StreamingBuffer', () => {
+  let context: TestContext;
+  let gl: WebGL2RenderingContext;
+
+  beforeAll(() => {
+    context = createTestContext();
+    gl      = context.gl;
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  test('hands out aligned regions in turn', () => {
+    const stream = new StreamingBuffer(gl, 100, 3);
+    expect(stream.byteLength).toBe(256);
+    const offsets = [];
+    for (let i = 0; i < 4; ++i) {
+      const region = stream.next();
+      expect(region.byteLength).toBe(256);
+      expect(region.byteOffset).toBe(stream.offset);
+      offsets.push(stream.offset);
+      stream.fence();
+    }
+    expect(offsets).toEqual([0, 256, 512, 0]);
+    stream.destroy();
+  });
+
+  test('writes to a region are visible to GL', () => {
+    const stream = new StreamingBuffer(gl, 16);
+    const values = new Float32Array([1, 2, 3, 4]);
+    stream.next();
+    const region = stream.next();
+    new Float32Array(region.buffer, region.byteOffset, 4).set(values);
+
+    const copy = gl.createBuffer();
+    gl.bindBuffer(gl.COPY_READ_BUFFER, stream.buffer);
+    gl.bindBuffer(gl.COPY_WRITE_BUFFER, copy);
+    gl.bufferData(gl.COPY_WRITE_BUFFER, 16, gl.STATIC_READ);
+    gl.copyBufferSubData(gl.COPY_READ_BUFFER, gl.COPY_WRITE_BUFFER, stream.offset, 0, 16);
+    stream.fence();
+
+    const result = new Float32Array(4);
+    gl.getBufferSubData(gl.COPY_WRITE_BUFFER, 0, result);
+    expect(Array.from(result)).toEqual(Array.from(values));
+
+    gl.deleteBuffer(copy);
+    stream.destroy();
+    expect(region.byteLength).toBe(0);
+    expect(gl.getParameter(gl.COPY_READ_BUFFER_BINDING)).toBe(0);
+  });
+
+  test('throws once destroyed', () => {
+    const stream = new StreamingBuffer(gl, 16);
+    stream.destroy();
+    expect(() => stream.next()).toThrow(/1282/);
+  });
+
+  // Needs node --expose-gc
+  const testIfGC =
+    typeof (<any>global).gc === 'function' && (<any>global).FinalizationRegistry ? test : test.skip;
+
+  testIfGC('keeps its regions mapped until they\'re collected too', async () => {
+    let collected  = false;
+    const registry = new (<any>global).FinalizationRegistry(() => { collected = true; });
+    const region   = (() => {
+      const stream = new StreamingBuffer(gl, 16);
+      registry.register(stream, null);
+      return stream.next();
+    })();
+    for (let i = 0; i < 10 && !collected; ++i) {
+      (<any>global).gc();
+      await new Promise((resolve) => setTimeout(resolve, 0));
+    }
+    expect(collected).toBe(true);
+    expect(region.byteLength).toBe(256);
+    region.fill(1);
+    expect(region[255]).toBe(1);
+  });
+});
@@ -0,0 +1,134 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {TextureInterop, TextureUploader} from '@nvidia/webgl';
+
+import {createTestContext, describeWithGL, readPixels, TestContext} from './context';
+
+describeWithGL('TextureUploader', () => {
+  let context: TestContext;
+  let gl: WebGL2RenderingContext;
+
+  beforeAll(() => {
+    context = createTestContext(4, 4);
+    gl      = context.gl;
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  const createTexture = (width = 4, height = 4) => {
+    const texture = gl.createTexture()!;
+    gl.bindTexture(gl.TEXTURE_2D, texture);
+    gl.texStorage2D(gl.TEXTURE_2D, 1, gl.RGBA8, width, height);
+    gl.bindTexture(gl.TEXTURE_2D, null);
+    return texture;
+  };
+
+  const readTexture = (texture: WebGLTexture, width = 4, height = 4) => {
+    const framebuffer = gl.createFramebuffer();
+    gl.bindFramebuffer(gl.FRAMEBUFFER, framebuffer);
+    gl.framebufferTexture2D(gl.FRAMEBUFFER, gl.COLOR_ATTACHMENT0, gl.TEXTURE_2D, texture, 0);
+    const pixels = readPixels(gl, width, height);
+    gl.bindFramebuffer(gl.FRAMEBUFFER, null);
+    gl.deleteFramebuffer(framebuffer);
+    return pixels;
+  };
+
+  // `width` x `height` texels of `rgba`
+  const fill = (width: number, height: number, rgba: number[]) => {
+    const data = new Uint8Array(width * height * 4);
+    for (let i = 0; i < width * height; ++i) { data.set(rgba, i * 4); }
+    return data;
+  };
+
+  test('uploads host memory through the staging buffer', () => {
+    const uploader = new TextureUploader(gl);
+    const texture  = createTexture();
+    uploader.upload(texture, fill(4, 4, [0, 0, 255, 255]), {width: 4, height: 4});
+    uploader.upload(texture, fill(2, 2, [255, 0, 0, 255]), {width: 2, height: 2, x: 2, y: 2});
+
+    const pixels = readTexture(texture);
+    expect(Array.from(pixels.subarray(0, 4))).toEqual([0, 0, 255, 255]);
+    expect(Array.from(pixels.subarray(15 * 4, 16 * 4))).toEqual([255, 0, 0, 255]);
+    expect(uploader.registered).toBe(0);
+    uploader.destroy();
+    gl.deleteTexture(texture);
+  });
+
+  test('uploads straight from host memory when it won\'t fit in a staging region', () => {
+    const uploader = new TextureUploader(gl, {stagingByteLength: 16});
+    const texture  = createTexture();
+    uploader.upload(texture, fill(4, 4, [0, 255, 0, 255]), {width: 4, height: 4});
+    expect(Array.from(readTexture(texture))).toEqual(Array.from(fill(4, 4, [0, 255, 0, 255])));
+    uploader.destroy();
+    gl.deleteTexture(texture);
+  });
+
+  test('leaves the bindings and unpack alignment as it found them', () => {
+    const uploader = new TextureUploader(gl);
+    const texture  = createTexture();
+    const bound    = createTexture();
+    const unpack   = gl.createBuffer()!;
+    gl.bindTexture(gl.TEXTURE_2D, bound);
+    gl.bindBuffer(gl.PIXEL_UNPACK_BUFFER, unpack);
+    gl.pixelStorei(gl.UNPACK_ALIGNMENT, 8);
+
+    uploader.upload(texture, fill(3, 1, [255, 255, 255, 255]), {width: 3, height: 1});
+
+    expect(gl.getParameter(gl.TEXTURE_BINDING_2D)).toBe((bound as any).ptr);
+    expect(gl.getParameter(gl.PIXEL_UNPACK_BUFFER_BINDING)).toBe((unpack as any).ptr);
+    expect(gl.getParameter(gl.UNPACK_ALIGNMENT)).toBe(8);
+    gl.pixelStorei(gl.UNPACK_ALIGNMENT, 4);
+    gl.bindBuffer(gl.PIXEL_UNPACK_BUFFER, null);
+    gl.bindTexture(gl.TEXTURE_2D, null);
+    uploader.destroy();
+    [texture, bound].forEach((t) => gl.deleteTexture(t));
+    gl.deleteBuffer(unpack);
+  });
+
+  test('registers each texture with the interop once, and unregisters it on release', () => {
+    const calls: string[]         = [];
+    const interop: TextureInterop = {
+      registerImage: (texture) => calls.push(`register ${texture}`),
+      unregisterResource: () => calls.push('unregister'),
+      copyToImage: (_resource, source, width, height, x, y) =>
+        calls.push(`copy ${source.ptr} ${width}x${height} at ${x},${y}`),
+    };
+    const uploader = new TextureUploader(gl, {interop});
+    const texture  = createTexture();
+    const device   = {ptr: 1024, byteLength: 64};
+    uploader.upload(texture, device, {width: 4, height: 4});
+    uploader.upload(texture, {data: device, offset: 0}, {width: 2, height: 2, x: 1, y: 1});
+    expect(uploader.registered).toBe(1);
+    uploader.release(texture);
+    expect(uploader.registered).toBe(0);
+
+    const name = (texture as any).ptr;
+    expect(calls).toEqual(
+      [`register ${name}`, 'copy 1024 4x4 at 0,0', 'copy 1024 2x2 at 1,1', 'unregister']);
+    uploader.destroy();
+    gl.deleteTexture(texture);
+  });
+
+  test('rejects device memory without an interop, and sliced columns', () => {
+    const uploader = new TextureUploader(gl);
+    const texture  = createTexture();
+    const device   = {ptr: 1024, byteLength: 64};
+    expect(() => uploader.upload(texture, device, {width: 4, height: 4})).toThrow(TypeError);
+    expect(() => uploader.upload(texture, {data: device, offset: 4}, {width: 4, height: 4}))
+      .toThrow(RangeError);
+    uploader.destroy();
+    gl.deleteTexture(texture);
+  });
+});
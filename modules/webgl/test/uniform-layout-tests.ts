@@ -0,0 +1,117 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createProgram, createTestContext, describeWithGL, readPixels, TestContext} from './context';
+
+const vs = `#version 330 core
+uniform mat4 transform;
+uniform vec2 offsets[2];
+in vec2 position;
+void main() { gl_Position = transform * vec4(position + offsets[0] + offsets[1], 0.0, 1.0); }`;
+
+const fs = `#version 330 core
+layout(std140) uniform Material {
+  vec3 tint;
+  float opacity;
+};
+uniform int channel;
+out vec4 fragColor;
+void main() {
+  vec4 color = vec4(tint, opacity);
+  if (channel == 1) { color.g = 1.0; }
+  fragColor = color;
+}`;
+
+describeWithGL('setUniforms', () => {
+  let context: TestContext;
+  let gl: any;
+  let program: WebGLProgram;
+
+  beforeAll(() => {
+    context = createTestContext(4, 4);
+    gl      = context.gl;
+    program = createProgram(gl, vs, fs);
+    const buffer = gl.createBuffer();
+    gl.bindBuffer(gl.ARRAY_BUFFER, buffer);
+    gl.bufferData(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 3, -1, -1, 3]), gl.STATIC_DRAW);
+    gl.bindVertexArray(gl.createVertexArray());
+    gl.enableVertexAttribArray(gl.getAttribLocation(program, 'position'));
+    gl.vertexAttribPointer(gl.getAttribLocation(program, 'position'), 2, gl.FLOAT, false, 0, 0);
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  const identity = [1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1];
+
+  test('packs the uniforms in the order asked for', () => {
+    const layout = gl.createUniformLayout(program, ['channel', 'transform', 'offsets[0]', 'nope']);
+    expect(layout.uniforms.map(({name, size, offset}: any) => ({name, size, offset}))).toEqual([
+      {name: 'channel', size: 1, offset: 0},
+      {name: 'transform', size: 1, offset: 1},
+      {name: 'offsets[0]', size: 2, offset: 17},
+    ]);
+    expect(layout.length).toBe(21);
+    gl.deleteUniformLayout(layout);
+  });
+
+  test('uploads default block and uniform block members in one call', () => {
+    const layout = gl.createUniformLayout(program);
+    const values = new Float32Array(layout.length);
+    const offset = (name: string) => layout.uniforms.find((u: any) => u.name === name).offset;
+    values.set(identity, offset('transform'));
+    values.set([0.25, 0, -0.25, 0], offset('offsets[0]'));
+    values.set([1, 0, 0.5], offset('tint'));
+    values[offset('opacity')] = 1;
+    values[offset('channel')] = 1;
+
+    gl.useProgram(program);
+    gl.setUniforms(program, layout, values);
+    expect(gl.getUniform(program, gl.getUniformLocation(program, 'channel'))).toBe(1);
+    expect(Array.from(gl.getUniform(program, gl.getUniformLocation(program, 'offsets[1]'))))
+      .toEqual([-0.25, 0]);
+    gl.drawArrays(gl.TRIANGLES, 0, 3);
+    expect(Array.from(readPixels(gl, 1, 1))).toEqual([255, 255, 128, 255]);
+
+    // Later calls only upload
+    values[offset('channel')] = 0;
+    gl.setUniforms(program, layout.handle, values);
+    gl.drawArrays(gl.TRIANGLES, 0, 3);
+    expect(Array.from(readPixels(gl, 1, 1))).toEqual([255, 0, 128, 255]);
+    gl.deleteUniformLayout(layout);
+  });
+
+  test('leaves the block members a layout doesn\'t name as they were', () => {
+    const material = gl.createBuffer();
+    gl.bindBuffer(gl.UNIFORM_BUFFER, material);
+    gl.bufferData(gl.UNIFORM_BUFFER, new Float32Array([0, 1, 0, 0.5]), gl.STATIC_DRAW);
+    gl.bindBufferBase(gl.UNIFORM_BUFFER, 0, material);
+
+    const layout = gl.createUniformLayout(program, ['opacity']);
+    gl.useProgram(program);
+    gl.setUniforms(program, layout, new Float32Array([1]));
+    gl.drawArrays(gl.TRIANGLES, 0, 3);
+    expect(Array.from(readPixels(gl, 1, 1))).toEqual([0, 255, 0, 255]);
+    gl.deleteUniformLayout(layout);
+    gl.deleteBuffer(material);
+  });
+
+  test('rejects values shorter than the layout, and layouts of other programs', () => {
+    const layout = gl.createUniformLayout(program, ['transform']);
+    expect(() => gl.setUniforms(program, layout, new Float32Array(15))).toThrow(/1281/);
+    const other = createProgram(gl, vs, fs);
+    expect(() => gl.setUniforms(other, layout, new Float32Array(16))).toThrow(/1282/);
+    gl.deleteProgram(other);
+    gl.deleteUniformLayout(layout);
+  });
+});
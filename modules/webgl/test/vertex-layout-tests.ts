@@ -0,0 +1,81 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import {createProgram, createTestContext, describeWithGL, readPixels, TestContext} from './context';
+
+const vs = `#version 330 core
+layout(location = 0) in vec2 position;
+layout(location = 1) in vec4 color;
+layout(location = 2) in vec2 offset;
+out vec4 vColor;
+void main() {
+  vColor      = color;
+  gl_Position = vec4(position + offset, 0.0, 1.0);
+}`;
+
+const fs = `#version 330 core
+in vec4 vColor;
+out vec4 fragColor;
+void main() { fragColor = vColor; }`;
+
+describeWithGL('createVertexArrayFromLayout', () => {
+  let context: TestContext;
+  let gl: any;
+
+  beforeAll(() => {
+    context = createTestContext(2, 1);
+    gl      = context.gl;
+    gl.useProgram(createProgram(gl, vs, fs));
+  });
+
+  afterAll(() => { context.destroy(); });
+
+  const buffer = (target: GLenum, data: ArrayBufferView) => {
+    const buffer = gl.createBuffer();
+    gl.bindBuffer(target, buffer);
+    gl.bufferData(target, data, gl.STATIC_DRAW);
+    return buffer;
+  };
+
+  test('sets up interleaved, normalized and instanced attributes in one call', () => {
+    // A triangle over the left half, drawn again over the right half by its second instance
+    const vertices = buffer(gl.ARRAY_BUFFER, new Float32Array([-1, -1, 0, -1, -1, 3]));
+    const colors   = buffer(gl.ARRAY_BUFFER, new Uint8Array([255, 0, 0, 255, 0, 0, 255, 255]));
+    const offsets  = buffer(gl.ARRAY_BUFFER, new Float32Array([0, 0, 1, 0]));
+    const elements = buffer(gl.ELEMENT_ARRAY_BUFFER, new Uint16Array([0, 1, 2]));
+    gl.bindVertexArray(null);
+
+    // clang-format off
+    const vao = gl.createVertexArrayFromLayout(new Uint32Array([
+      vertices.ptr, 0, 2, gl.FLOAT,         0, 0, 0, 0,
+      colors.ptr,   1, 4, gl.UNSIGNED_BYTE, 1, 0, 0, 1,
+      offsets.ptr,  2, 2, gl.FLOAT,         0, 8, 0, 1,
+    ]), elements);
+    // clang-format on
+
+    gl.bindVertexArray(vao);
+    expect(gl.getVertexAttrib(1, gl.VERTEX_ATTRIB_ARRAY_NORMALIZED)).toBe(true);
+    expect(gl.getVertexAttrib(2, gl.VERTEX_ATTRIB_ARRAY_DIVISOR)).toBe(1);
+    gl.clearColor(0, 0, 0, 0);
+    gl.clear(gl.COLOR_BUFFER_BIT);
+    gl.drawElementsInstanced(gl.TRIANGLES, 3, gl.UNSIGNED_SHORT, 0, 2);
+    expect(Array.from(readPixels(gl, 2, 1))).toEqual([255, 0, 0, 255, 0, 0, 255, 255]);
+    gl.bindVertexArray(null);
+    gl.deleteVertexArray(vao);
+  });
+
+  test('rejects layouts that are not whole attributes', () => {
+    expect(() => gl.createVertexArrayFromLayout(new Uint32Array(7))).toThrow(/1281/);
+  });
+});
@@ -0,0 +1,59 @@
+// Copyright (c) 2021, NVIDIA CORPORATION.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+import * as Fs from 'fs';
+import * as Path from 'path';
+import {Worker} from 'worker_threads';
+
+// Smoke test that the addon can be loaded into several worker_threads at once, and that the main
+// thread's copy keeps working after they exit. Only exercises construction, so needs no GPU.
+
+const addonPath = ['Release', 'Debug']
+                    .map((type) => Path.join(__dirname, '..', 'build', type, 'node_webgl.node'))
+                    .find((path) => Fs.existsSync(path));
+
+const workerSource = `
+const {parentPort, workerData} = require('worker_threads');
+const gl = require(workerData.addonPath);
+const names = [];
+for (let i = 0; i < 1000; ++i) {
+  const buffer = new gl.WebGLBuffer();
+  if (!(buffer instanceof gl.WebGLBuffer)) { throw new Error('bad WebGLBuffer'); }
+  names.push(new gl.WebGLTexture().toString());
+}
+parentPort.postMessage(names.length);
+`;
+
+function runWorker() {
+  return new Promise<number>((resolve, reject) => {
+    const worker = new Worker(workerSource, {eval: true, workerData: {addonPath}});
+    worker.once('message', resolve);
+    worker.once('error', reject);
+    worker.once('exit', (code) => code !== 0 && reject(new Error(`worker exited with ${code}`)));
+  });
+}
+
+const testIfBuilt = addonPath ? test : test.skip;
+
+testIfBuilt('loads the addon in multiple worker_threads', async () => {
+  const gl = require(addonPath!);
+  expect(new gl.WebGLBuffer()).toBeInstanceOf(gl.WebGLBuffer);
+
+  const results = await Promise.all([runWorker(), runWorker(), runWorker(), runWorker()]);
+  expect(results).toEqual([1000, 1000, 1000, 1000]);
+
+  // The main thread's constructors must survive the workers' envs being torn down
+  expect(new gl.WebGLSampler()).toBeInstanceOf(gl.WebGLSampler);
+  expect(await runWorker()).toBe(1000);
+});